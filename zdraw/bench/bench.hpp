@@ -0,0 +1,62 @@
+#pragma once
+
+// core
+#include <../zdraw/zdraw.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+	// @note: best recording time in microseconds over a number of frames; each frame is submitted untimed
+	template<typename F>
+	[[nodiscard]] double time_recording( int frames, F&& record )
+	{
+		auto best = 1.0e30;
+
+		for ( int i{ 0 }; i < frames; ++i )
+		{
+			zdraw::begin_frame( );
+
+			const auto start = std::chrono::steady_clock::now( );
+			record( zdraw::get_draw_list( ) );
+			const auto elapsed = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now( ) - start ).count( );
+
+			( void )zdraw::end_frame( );
+			best = std::min( best, elapsed );
+		}
+
+		return best;
+	}
+
+	namespace directx {
+
+		bool initialize( UINT width, UINT height );
+
+		inline ID3D11Device* device{ nullptr };
+		inline ID3D11DeviceContext* device_context{ nullptr };
+		inline ID3D11Texture2D* render_target{ nullptr };
+		inline ID3D11RenderTargetView* render_target_view{ nullptr };
+
+	} // namespace directx
+
+	namespace paths {
+
+		void run( );
+
+	} // namespace paths
+
+	namespace submit {
+
+		void run( );
+
+	} // namespace submit
+
+	namespace text {
+
+		void run( );
+
+	} // namespace text
+
+} // namespace bench
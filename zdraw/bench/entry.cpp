@@ -0,0 +1,77 @@
+#include <bench.hpp>
+
+namespace bench::directx {
+
+	bool initialize( UINT width, UINT height )
+	{
+		constexpr D3D_FEATURE_LEVEL feature_levels[ ]{ D3D_FEATURE_LEVEL_11_1, D3D_FEATURE_LEVEL_11_0 };
+
+		D3D_FEATURE_LEVEL selected{};
+
+		// @note: warp keeps the numbers independent of the gpu and driver; the benchmarks measure cpu-side recording and submission
+		if ( FAILED( D3D11CreateDevice( nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0, feature_levels, _countof( feature_levels ), D3D11_SDK_VERSION, &device, &selected, &device_context ) ) )
+		{
+			return false;
+		}
+
+		const D3D11_TEXTURE2D_DESC desc
+		{
+			.Width = width,
+			.Height = height,
+			.MipLevels = 1,
+			.ArraySize = 1,
+			.Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+			.SampleDesc = { 1, 0 },
+			.Usage = D3D11_USAGE_DEFAULT,
+			.BindFlags = D3D11_BIND_RENDER_TARGET,
+			.CPUAccessFlags = 0,
+			.MiscFlags = 0
+		};
+
+		if ( FAILED( device->CreateTexture2D( &desc, nullptr, &render_target ) ) )
+		{
+			return false;
+		}
+
+		if ( FAILED( device->CreateRenderTargetView( render_target, nullptr, &render_target_view ) ) )
+		{
+			return false;
+		}
+
+		D3D11_VIEWPORT viewport
+		{
+			.TopLeftX = 0.0f,
+			.TopLeftY = 0.0f,
+			.Width = static_cast< float >( width ),
+			.Height = static_cast< float >( height ),
+			.MinDepth = 0.0f,
+			.MaxDepth = 1.0f
+		};
+
+		device_context->OMSetRenderTargets( 1, &render_target_view, nullptr );
+		device_context->RSSetViewports( 1, &viewport );
+
+		return true;
+	}
+
+} // namespace bench::directx
+
+int main( )
+{
+	if ( !bench::directx::initialize( 1920, 1080 ) )
+	{
+		std::printf( "failed to initialize directx\n" );
+		return -1;
+	}
+
+	if ( !zdraw::initialize( bench::directx::device, bench::directx::device_context ) )
+	{
+		std::printf( "failed to initialize zdraw\n" );
+		return -1;
+	}
+
+	bench::paths::run( );
+	bench::text::run( );
+	bench::submit::run( );
+	return 0;
+}
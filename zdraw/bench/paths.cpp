@@ -0,0 +1,77 @@
+#include <bench.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace bench::paths {
+
+	enum class shape { star, random_radius, wave };
+
+	static std::vector<float> make_outline( shape kind, int count, std::mt19937& rng )
+	{
+		std::uniform_real_distribution<float> radius_jitter{ 0.3f, 1.0f };
+
+		std::vector<float> points{};
+		points.reserve( static_cast< std::size_t >( count ) * 2 );
+
+		for ( int i{ 0 }; i < count; ++i )
+		{
+			auto angle = 2.0f * std::numbers::pi_v<float> * static_cast< float >( i ) / static_cast< float >( count );
+			auto radius = 0.0f;
+
+			switch ( kind )
+			{
+			case shape::star: radius = ( i & 1 ) ? 400.0f : 160.0f; break;
+			case shape::random_radius: radius = 400.0f * radius_jitter( rng ); break;
+			case shape::wave: radius = 240.0f + 120.0f * std::sin( angle * 7.0f ); angle = -angle; break;
+			}
+
+			points.push_back( 960.0f + std::cos( angle ) * radius );
+			points.push_back( 540.0f + std::sin( angle ) * radius );
+		}
+
+		return points;
+	}
+
+	void run( )
+	{
+		constexpr const char* shape_names[ ]{ "star", "random radius", "wave (cw)" };
+		constexpr zdraw::rgba color{ 255, 255, 255, 255 };
+
+		std::mt19937 rng{ 7 };
+
+		std::printf( "add_concave_poly_filled, best frame in microseconds per polygon\n" );
+		std::printf( "%-14s %7s %10s %12s %10s\n", "shape", "points", "triangles", "time (us)", "ns/point" );
+
+		for ( const auto count : { 10, 100, 1000, 10000 } )
+		{
+			const auto frames = count >= 10000 ? 20 : count >= 1000 ? 100 : 1000;
+			const auto repeats = count >= 1000 ? 1 : 10000 / count;
+
+			for ( int kind{ 0 }; kind < 3; ++kind )
+			{
+				const auto outline = make_outline( static_cast< shape >( kind ), count, rng );
+				auto indices = std::size_t{ 0 };
+
+				const auto elapsed = time_recording( frames, [ & ]( zdraw::draw_list& dl )
+					{
+						for ( int r{ 0 }; r < repeats; ++r )
+						{
+							dl.add_concave_poly_filled( outline, color );
+						}
+
+						indices = dl.m_indices.size( ) / static_cast< std::size_t >( repeats );
+					} ) / repeats;
+
+				// @note: the fringe adds two triangles per edge on top of the n - 2 fill triangles
+				const auto triangles = ( indices - static_cast< std::size_t >( count ) * 6 ) / 3;
+				std::printf( "%-14s %7d %10zu %12.2f %10.1f\n", shape_names[ kind ], count, triangles, elapsed, elapsed * 1000.0 / count );
+			}
+		}
+
+		std::printf( "\n" );
+	}
+
+} // namespace bench::paths
@@ -0,0 +1,142 @@
+#include <bench.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace bench::submit {
+
+	static void record_layers( int frame )
+	{
+		constexpr zdraw::draw_layer layers[ ]{ zdraw::draw_layer::background, zdraw::draw_layer::window, zdraw::draw_layer::topmost };
+
+		for ( int l{ 0 }; l < 3; ++l )
+		{
+			auto& dl = zdraw::get_draw_list( layers[ l ] );
+
+			for ( int i{ 0 }; i < 1500; ++i )
+			{
+				const auto x = static_cast< float >( ( i * 37 + l * 211 ) % 1880 );
+				const auto y = static_cast< float >( ( i * 53 + l * 97 + frame ) % 1040 );
+				const zdraw::rgba color{ static_cast< std::uint8_t >( i * 7 ), static_cast< std::uint8_t >( l * 80 ), static_cast< std::uint8_t >( 255 - i % 256 ), 200 };
+
+				// @note: a clip rect per item splits the layer into many draw calls, which is the case deferred recording targets
+				dl.push_clip_rect( x - 4.0f, y - 4.0f, x + 36.0f, y + 36.0f );
+
+				switch ( i % 3 )
+				{
+				case 0: dl.add_rect_filled( x, y, 32.0f, 24.0f, color ); break;
+				case 1: dl.add_circle_filled( x + 16.0f, y + 16.0f, 14.0f, color, 24 ); break;
+				case 2: dl.add_line( x, y, x + 32.0f, y + 32.0f, color, 2.0f ); break;
+				}
+
+				dl.pop_clip_rect( );
+			}
+		}
+	}
+
+	// @note: best end_frame time in microseconds; the gpu is never waited on, so this is the cpu cost of encoding and submitting
+	static double time_submission( int frames )
+	{
+		auto best = 1.0e30;
+
+		for ( int i{ 0 }; i < frames; ++i )
+		{
+			zdraw::begin_frame( );
+			record_layers( i );
+
+			const auto start = std::chrono::steady_clock::now( );
+			( void )zdraw::end_frame( );
+			const auto elapsed = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now( ) - start ).count( );
+
+			best = std::min( best, elapsed );
+		}
+
+		return best;
+	}
+
+	static std::vector<std::uint8_t> read_back( )
+	{
+		D3D11_TEXTURE2D_DESC desc{};
+		directx::render_target->GetDesc( &desc );
+		desc.Usage = D3D11_USAGE_STAGING;
+		desc.BindFlags = 0;
+		desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> staging{};
+		if ( FAILED( directx::device->CreateTexture2D( &desc, nullptr, &staging ) ) )
+		{
+			return {};
+		}
+
+		directx::device_context->CopyResource( staging.Get( ), directx::render_target );
+
+		D3D11_MAPPED_SUBRESOURCE mapped{};
+		if ( FAILED( directx::device_context->Map( staging.Get( ), 0, D3D11_MAP_READ, 0, &mapped ) ) )
+		{
+			return {};
+		}
+
+		const auto row_bytes = static_cast< std::size_t >( desc.Width ) * 4;
+		std::vector<std::uint8_t> pixels( row_bytes * desc.Height );
+
+		for ( UINT y{ 0 }; y < desc.Height; ++y )
+		{
+			std::memcpy( pixels.data( ) + y * row_bytes, static_cast< const std::uint8_t* >( mapped.pData ) + y * mapped.RowPitch, row_bytes );
+		}
+
+		directx::device_context->Unmap( staging.Get( ), 0 );
+		return pixels;
+	}
+
+	static std::vector<std::uint8_t> render_reference( bool deferred )
+	{
+		constexpr float clear_color[ 4 ]{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+		zdraw::set_deferred_contexts( deferred );
+		directx::device_context->ClearRenderTargetView( directx::render_target_view, clear_color );
+
+		zdraw::begin_frame( );
+		record_layers( 0 );
+		( void )zdraw::end_frame( );
+
+		return read_back( );
+	}
+
+	void run( )
+	{
+		const auto skip_unchanged = zdraw::get_skip_unchanged_frames( );
+		zdraw::set_skip_unchanged_frames( false );
+
+		std::printf( "end_frame, 3 layers of 1500 clipped draws, best frame in microseconds\n" );
+
+		for ( const auto deferred : { false, true } )
+		{
+			zdraw::set_deferred_contexts( deferred );
+			const auto elapsed = time_submission( 200 );
+
+			// @note: creating the recording contexts can fail, in which case zdraw turns the setting back off and submits immediately
+			std::printf( "%-10s %10.2f%s\n", deferred ? "deferred" : "immediate", elapsed, deferred && !zdraw::get_deferred_contexts( ) ? " (fell back to immediate)" : "" );
+		}
+
+		const auto immediate = render_reference( false );
+		const auto deferred = render_reference( true );
+
+		if ( !zdraw::get_deferred_contexts( ) )
+		{
+			std::printf( "output check: deferred contexts unavailable\n" );
+		}
+		else if ( immediate.empty( ) || deferred.empty( ) )
+		{
+			std::printf( "output check: render target readback failed\n" );
+		}
+		else
+		{
+			std::printf( "output check: %s\n", immediate == deferred ? "deferred matches immediate" : "deferred differs from immediate" );
+		}
+
+		zdraw::set_deferred_contexts( false );
+		zdraw::set_skip_unchanged_frames( skip_unchanged );
+		std::printf( "\n" );
+	}
+
+} // namespace bench::submit
@@ -0,0 +1,77 @@
+#include <bench.hpp>
+
+#include <string_view>
+
+namespace bench::text {
+
+	void run( )
+	{
+		constexpr std::string_view label{ "Player 1 [120m] HP 100/100 - Armor 50" };
+		constexpr zdraw::rgba fill{ 255, 255, 255, 255 };
+		constexpr zdraw::rgba effect{ 0, 0, 0, 255 };
+		constexpr int label_count{ 2000 };
+
+		const auto* font = zdraw::get_default_font( );
+
+		std::printf( "%d labels of %zu characters, default font, best frame in microseconds\n", label_count, label.size( ) );
+		std::printf( "%-26s %12s %10s\n", "case", "time (us)", "vertices" );
+
+		const auto measure = [ & ]( const char* name, auto&& draw_label )
+			{
+				auto vertices = std::size_t{ 0 };
+
+				const auto elapsed = time_recording( 50, [ & ]( zdraw::draw_list& dl )
+					{
+						for ( int i{ 0 }; i < label_count; ++i )
+						{
+							draw_label( dl, static_cast< float >( i % 40 ) * 48.0f, static_cast< float >( i / 40 ) * 20.0f );
+						}
+
+						vertices = dl.m_vertices.size( ) + dl.m_sdf_vertices.size( );
+					} );
+
+				std::printf( "%-26s %12.1f %10zu\n", name, elapsed, vertices );
+			};
+
+		measure( "add_text", [ & ]( zdraw::draw_list& dl, float x, float y )
+			{
+				dl.add_text( x, y, label, fill, font );
+			} );
+
+		// @note: the multi-draw outline this replaces, eight offset copies under the fill
+		measure( "8 offset add_text + fill", [ & ]( zdraw::draw_list& dl, float x, float y )
+			{
+				for ( int dy{ -1 }; dy <= 1; ++dy )
+				{
+					for ( int dx{ -1 }; dx <= 1; ++dx )
+					{
+						if ( dx != 0 || dy != 0 )
+						{
+							dl.add_text( x + static_cast< float >( dx ), y + static_cast< float >( dy ), label, effect, font );
+						}
+					}
+				}
+
+				dl.add_text( x, y, label, fill, font );
+			} );
+
+		measure( "add_text_outlined", [ & ]( zdraw::draw_list& dl, float x, float y )
+			{
+				dl.add_text_outlined( x, y, label, fill, effect, 1.0f, font );
+			} );
+
+		measure( "2 add_text shadow", [ & ]( zdraw::draw_list& dl, float x, float y )
+			{
+				dl.add_text( x + 1.0f, y + 1.0f, label, effect, font );
+				dl.add_text( x, y, label, fill, font );
+			} );
+
+		measure( "add_text_shadowed", [ & ]( zdraw::draw_list& dl, float x, float y )
+			{
+				dl.add_text_shadowed( x, y, label, fill, effect, 1.0f, 1.0f, font );
+			} );
+
+		std::printf( "\n" );
+	}
+
+} // namespace bench::text
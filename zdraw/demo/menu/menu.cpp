@@ -29,8 +29,31 @@ namespace menu {
 	{
 		if ( should_demo_play )
 		{
+			const auto viewport_w = demo_viewport_w.load( ), viewport_h = demo_viewport_h.load( );
+			if ( viewport_w > 0 && viewport_h > 0 )
+			{
+				demo_scene.resize_viewport( viewport_w, viewport_h );
+			}
+
+			if ( demo_playing.load( ) )
+			{
+				demo_scene.play( );
+			}
+			else
+			{
+				demo_scene.pause( );
+			}
+
 			demo_scene.update( zdraw::get_delta_time( ) );
 			demo_scene.render( );
+
+			if ( demo_scene.is_playing( ) )
+			{
+				zdraw::invalidate_texture( demo_scene.get_texture( ) );
+			}
+
+			std::scoped_lock lock{ demo_texture_mutex };
+			demo_texture = demo_scene.get_texture( );
 		}
 	}
 
@@ -39,11 +62,11 @@ namespace menu {
 		zui::begin( );
 
 		{
-			static auto background = zdraw::load_texture_from_memory( { std::span( reinterpret_cast< const std::byte* >( resources::background ), sizeof( resources::background ) ) } );
-			if ( background )
+			static auto background = zdraw::load_texture_from_memory_async( { std::span( reinterpret_cast< const std::byte* >( resources::background ), sizeof( resources::background ) ) } );
+			if ( background->ready( ) )
 			{
 				const auto [w, h] = zdraw::get_display_size( );
-				zdraw::get_draw_list( ).add_rect_textured( 0, 0, w, h, background.Get( ) );
+				zdraw::get_draw_list( ).add_rect_textured( 0, 0, w, h, background->get( ) );
 			}
 		}
 
@@ -65,8 +88,19 @@ namespace menu {
 					auto* win = zui::detail::get_current_window( );
 					auto& bounds = win->bounds;
 
-					zdraw::get_draw_list( ).add_rect_textured( bounds.x, bounds.y, bounds.w, bounds.h, demo_scene.get_texture( ) );
-					demo_scene.resize_viewport( static_cast< int >( bounds.w ), static_cast< int >( bounds.h ) );
+					Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture{};
+					{
+						std::scoped_lock lock{ demo_texture_mutex };
+						texture = demo_texture;
+					}
+
+					if ( texture )
+					{
+						zdraw::get_draw_list( ).add_rect_textured( bounds.x, bounds.y, bounds.w, bounds.h, texture.Get( ) );
+					}
+
+					demo_viewport_w.store( static_cast< int >( bounds.w ) );
+					demo_viewport_h.store( static_cast< int >( bounds.h ) );
 
 					zui::end_nested_window( );
 				}
@@ -75,14 +109,14 @@ namespace menu {
 
 				if ( zui::button( "play", button_w, button_h ) )
 				{
-					demo_scene.play( );
+					demo_playing.store( true );
 				}
 
 				zui::same_line( );
 
 				if ( zui::button( "pause", button_w, button_h ) )
 				{
-					demo_scene.pause( );
+					demo_playing.store( false );
 				}
 
 				zui::end_window( );
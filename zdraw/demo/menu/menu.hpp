@@ -2,11 +2,20 @@
 
 #include <../zdraw/zscene/zscene.hpp>
 
+#include <atomic>
+#include <mutex>
+
 namespace menu {
 
 	inline zscene::scene demo_scene{};
 	inline bool should_demo_play{ true };
 
+	inline std::atomic<bool> demo_playing{ true };
+	inline std::atomic<int> demo_viewport_w{ 0 };
+	inline std::atomic<int> demo_viewport_h{ 0 };
+	inline std::mutex demo_texture_mutex{};
+	inline Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> demo_texture{};
+
 	void initialize( ID3D11Device* device, ID3D11DeviceContext* context );
 	void update( );
 	void draw( );
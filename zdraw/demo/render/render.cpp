@@ -22,6 +22,10 @@ namespace render {
 			return false;
 		}
 
+		zdraw::set_occlusion_culling( true );
+		zdraw::set_deferred_contexts( true );
+		zdraw::set_skip_unchanged_frames( true );
+
 		if ( !zui::initialize( window::hwnd ) )
 		{
 			std::printf( "failed to initialize zui\n" );
@@ -38,6 +42,17 @@ namespace render {
 		constexpr float clear_color[ 4 ]{ 0.0f, 0.0f, 0.0f, 0.0f };
 		MSG msg{};
 
+		// @note: the ui for frame n+1 is built on this thread while frame n is submitted below
+
+		std::thread builder{ [ ]
+			{
+				while ( zdraw::begin_frame_build( ) )
+				{
+					menu::draw( );
+					zdraw::end_frame_build( );
+				}
+			} };
+
 		while ( msg.message != WM_QUIT )
 		{
 			while ( PeekMessage( &msg, nullptr, 0, 0, PM_REMOVE ) )
@@ -64,14 +79,17 @@ namespace render {
 			directx::device_context->OMSetRenderTargets( 1, &directx::render_target_view, nullptr );
 			directx::device_context->ClearRenderTargetView( directx::render_target_view, clear_color );
 
-			zdraw::begin_frame( );
+			if ( zdraw::submit_frame( ) == zdraw::frame_status::unchanged )
 			{
-				menu::draw( );
+				DwmFlush( );
+				continue;
 			}
-			zdraw::end_frame( );
 
 			directx::swap_chain->Present( 1, 0 );
 		}
+
+		zdraw::stop_frame_pipeline( );
+		builder.join( );
 	}
 
 	bool window::initialize( )
@@ -131,6 +149,7 @@ namespace render {
 		}
 
 		swap_chain->ResizeBuffers( 0, width, height, DXGI_FORMAT_UNKNOWN, 0 );
+		zdraw::invalidate_frame( );
 
 		{
 			ID3D11Texture2D* back_buffer{};
@@ -4,6 +4,10 @@
 #include <windows.h>
 #include <d3d11.h>
 #include <dxgi.h>
+#include <dwmapi.h>
+#include <thread>
+
+#pragma comment( lib, "dwmapi.lib" )
 
 namespace render {
 
@@ -6,11 +6,16 @@ namespace shaders {
         cbuffer ProjectionBuffer : register(b0)
         {
             float4x4 projection;
+            float4 pos_params;
         };
 
         struct VS_INPUT
         {
+        #ifdef ZDRAW_COMPACT_VERTEX
+            int2   pos : POSITION;
+        #else
             float2 pos : POSITION;
+        #endif
             float2 uv  : TEXCOORD0;
             float4 col : COLOR0;
         };
@@ -24,8 +29,14 @@ namespace shaders {
 
         PS_INPUT main(VS_INPUT input)
         {
+        #ifdef ZDRAW_COMPACT_VERTEX
+            float2 pos = float2(input.pos) * pos_params.x;
+        #else
+            float2 pos = input.pos;
+        #endif
+
             PS_INPUT output;
-            output.pos = mul(projection, float4(input.pos, 0.0f, 1.0f));
+            output.pos = mul(projection, float4(pos, 0.0f, 1.0f));
             output.uv  = input.uv;
             output.col = input.col;
             return output;
@@ -50,6 +61,113 @@ namespace shaders {
         }
     )";
 
+	constexpr const char* sdf_vertex_shader_src = R"(
+        cbuffer ProjectionBuffer : register(b0)
+        {
+            float4x4 projection;
+        };
+
+        struct VS_INPUT
+        {
+            float2 pos      : POSITION;
+            float2 local    : TEXCOORD0;
+            float4 shape    : TEXCOORD1;
+            float  softness : TEXCOORD2;
+            float4 col      : COLOR0;
+            float4 effect   : COLOR1;
+        };
+
+        struct PS_INPUT
+        {
+            float4 pos                      : SV_POSITION;
+            float2 local                    : TEXCOORD0;
+            nointerpolation float4 shape    : TEXCOORD1;
+            nointerpolation float  softness : TEXCOORD2;
+            float4 col                      : COLOR0;
+            nointerpolation float4 effect   : COLOR1;
+        };
+
+        PS_INPUT main(VS_INPUT input)
+        {
+            PS_INPUT output;
+            output.pos      = mul(projection, float4(input.pos, 0.0f, 1.0f));
+            output.local    = input.local;
+            output.shape    = input.shape;
+            output.softness = input.softness;
+            output.col      = input.col;
+            output.effect   = input.effect;
+            return output;
+        }
+    )";
+
+	constexpr const char* sdf_pixel_shader_src = R"(
+        struct PS_INPUT
+        {
+            float4 pos                      : SV_POSITION;
+            float2 local                    : TEXCOORD0;
+            nointerpolation float4 shape    : TEXCOORD1;
+            nointerpolation float  softness : TEXCOORD2;
+            float4 col                      : COLOR0;
+        };
+
+        float sd_rounded_box(float2 p, float2 half_size, float radius)
+        {
+            float2 q = abs(p) - half_size + radius;
+            return length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - radius;
+        }
+
+        float4 main(PS_INPUT input) : SV_Target
+        {
+            float d = sd_rounded_box(input.local, input.shape.xy, input.shape.z);
+            float pixel = length(float2(ddx(d), ddy(d)));
+
+            float half_stroke = input.shape.w * 0.5f;
+            d = input.shape.w > 0.0f ? abs(d + half_stroke) - half_stroke : d;
+
+            float width = max(input.softness, max(pixel, 0.0001f));
+            float coverage = saturate(0.5f - d / width);
+            return input.col * coverage;
+        }
+    )";
+
+	constexpr const char* glyph_pixel_shader_src = R"(
+        Texture2D tex     : register(t0);
+        SamplerState samp : register(s0);
+
+        struct PS_INPUT
+        {
+            float4 pos                      : SV_POSITION;
+            float2 local                    : TEXCOORD0;
+            nointerpolation float4 shape    : TEXCOORD1;
+            nointerpolation float  softness : TEXCOORD2;
+            float4 col                      : COLOR0;
+            nointerpolation float4 effect   : COLOR1;
+        };
+
+        static const float2 taps[8] =
+        {
+            float2( 1.0f, 0.0f ), float2( -1.0f, 0.0f ), float2( 0.0f, 1.0f ), float2( 0.0f, -1.0f ),
+            float2( 0.7071f, 0.7071f ), float2( -0.7071f, 0.7071f ), float2( 0.7071f, -0.7071f ), float2( -0.7071f, -0.7071f )
+        };
+
+        float4 main(PS_INPUT input) : SV_Target
+        {
+            float fill = tex.SampleLevel(samp, input.local, 0.0f).a;
+
+            float2 uv = input.local - input.shape.xy;
+            float effect = tex.SampleLevel(samp, uv, 0.0f).a;
+
+            [unroll]
+            for (int i = 0; i < 8; ++i)
+            {
+                effect = max(effect, tex.SampleLevel(samp, uv + taps[i] * input.shape.zw, 0.0f).a);
+            }
+
+            float4 color = input.col * fill;
+            return color + input.effect * (effect * (1.0f - color.a));
+        }
+    )";
+
 	constexpr const char* zscene_vertex_shader_src = R"(
 		cbuffer TransformBuffer : register(b0)
 		{
@@ -140,6 +258,7 @@ namespace shaders {
         float4 main(PS_INPUT input) : SV_TARGET
         {
             float4 albedo = albedo_texture.Sample(samp, input.uv);
+            albedo.rgb = albedo.a > 0.0f ? albedo.rgb / albedo.a : albedo.rgb;
 
             float3 light_dir = normalize(float3(0.5f, 1.0f, 0.3f));
             float3 normal = normalize(input.normal);
@@ -1,16 +1,31 @@
-#include "zdraw.hpp"
+﻿#include "zdraw.hpp"
 
 #include <d3dcompiler.h>
 #include <wincodec.h>
 #include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <numbers>
+#include <thread>
 
 #include <ft2build.h>
 #include <freetype/freetype.h>
 
 #include "external/fonts/inter.hpp"
 #include "external/shaders/shaders.hpp"
+#include "zhash/zhash.hpp"
+#include "zimage/zimage.hpp"
+
+#if defined( _M_X64 ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ZDRAW_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace zdraw {
 
@@ -21,11 +36,7 @@ namespace zdraw {
 		struct persistent_buffer
 		{
 			ComPtr<ID3D11Buffer> m_buffer{};
-			void* m_mapped_data{ nullptr };
-			std::uint32_t m_size{ 0 };
-			std::uint32_t m_write_offset{ 0 };
 			std::uint32_t m_capacity{ 0 };
-			bool m_is_mapped{ false };
 
 			bool create( ID3D11Device* device, std::uint32_t initial_capacity, D3D11_BIND_FLAG bind_flags )
 			{
@@ -40,59 +51,22 @@ namespace zdraw {
 				return SUCCEEDED( device->CreateBuffer( &desc, nullptr, &this->m_buffer ) );
 			}
 
-			bool map_discard( ID3D11DeviceContext* context )
+			[[nodiscard]] bool upload( ID3D11DeviceContext* context, const void* data, std::uint32_t bytes ) const
 			{
-				if ( this->m_is_mapped )
+				if ( bytes > this->m_capacity ) [[unlikely]]
 				{
-					this->unmap( context );
+					return false;
 				}
 
 				D3D11_MAPPED_SUBRESOURCE mapped{};
-				auto hr{ context->Map( this->m_buffer.Get( ), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped ) };
-
-				if ( SUCCEEDED( hr ) )
-				{
-					this->m_mapped_data = mapped.pData;
-					this->m_is_mapped = true;
-					this->m_write_offset = 0;
-					return true;
-				}
-				else
+				if ( FAILED( context->Map( this->m_buffer.Get( ), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped ) ) )
 				{
 					return false;
 				}
-			}
-
-			void unmap( ID3D11DeviceContext* context ) noexcept
-			{
-				if ( this->m_is_mapped )
-				{
-					context->Unmap( this->m_buffer.Get( ), 0 );
-					this->m_mapped_data = nullptr;
-					this->m_is_mapped = false;
-				}
-			}
-
-			[[nodiscard]] void* allocate( std::uint32_t bytes )
-			{
-				if ( !this->m_is_mapped )
-				{
-					return nullptr;
-				}
-
-				if ( this->m_write_offset + bytes > this->m_capacity ) [[unlikely]]
-				{
-					return nullptr;
-				}
 
-				auto result{ static_cast< char* >( this->m_mapped_data ) + this->m_write_offset };
-				this->m_write_offset += bytes;
-				return result;
-			}
-
-			void reset_offsets( ) noexcept
-			{
-				this->m_write_offset = 0;
+				std::memcpy( mapped.pData, data, bytes );
+				context->Unmap( this->m_buffer.Get( ), 0 );
+				return true;
 			}
 
 			[[nodiscard]] bool needs_resize( std::uint32_t required_size ) const noexcept
@@ -100,13 +74,11 @@ namespace zdraw {
 				return required_size > this->m_capacity;
 			}
 
-			void resize( ID3D11Device* device, ID3D11DeviceContext* context, std::uint32_t new_capacity, D3D11_BIND_FLAG bind_flags )
+			void resize( ID3D11Device* device, std::uint32_t new_capacity, D3D11_BIND_FLAG bind_flags )
 			{
-				this->unmap( context );
 				this->m_buffer.Reset( );
 				this->m_capacity = new_capacity;
 				this->create( device, this->m_capacity, bind_flags );
-				this->m_write_offset = 0;
 			}
 		};
 
@@ -153,18 +125,247 @@ namespace zdraw {
 			}
 		};
 
+		struct worker_pool
+		{
+			std::vector<std::thread> m_threads{};
+			std::deque<std::function<void( )>> m_jobs{};
+			std::mutex m_mutex{};
+			std::condition_variable m_cv{};
+			bool m_stopping{ false };
+
+			~worker_pool( )
+			{
+				this->stop( );
+			}
+
+			void submit( std::function<void( )> job )
+			{
+				{
+					std::scoped_lock lock{ this->m_mutex };
+
+					if ( this->m_threads.empty( ) )
+					{
+						this->start( );
+					}
+
+					this->m_jobs.push_back( std::move( job ) );
+				}
+
+				this->m_cv.notify_one( );
+			}
+
+			void stop( )
+			{
+				{
+					std::scoped_lock lock{ this->m_mutex };
+					this->m_stopping = true;
+				}
+
+				this->m_cv.notify_all( );
+
+				for ( auto& thread : this->m_threads )
+				{
+					if ( thread.joinable( ) )
+					{
+						thread.join( );
+					}
+				}
+
+				this->m_threads.clear( );
+			}
+
+		private:
+			void start( )
+			{
+				const auto hardware_threads{ std::max( std::thread::hardware_concurrency( ), 2u ) };
+				const auto thread_count{ std::min( hardware_threads / 2u, 4u ) };
+
+				for ( std::uint32_t i{ 0 }; i < thread_count; ++i )
+				{
+					this->m_threads.emplace_back( [ this ] { this->run( ); } );
+				}
+			}
+
+			void run( )
+			{
+				( void )CoInitializeEx( nullptr, COINIT_MULTITHREADED );
+
+				for ( ;; )
+				{
+					std::function<void( )> job{};
+
+					{
+						std::unique_lock lock{ this->m_mutex };
+						this->m_cv.wait( lock, [ this ] { return this->m_stopping || !this->m_jobs.empty( ); } );
+
+						if ( this->m_stopping )
+						{
+							break;
+						}
+
+						job = std::move( this->m_jobs.front( ) );
+						this->m_jobs.pop_front( );
+					}
+
+					job( );
+				}
+
+				CoUninitialize( );
+			}
+		};
+
+		static constexpr std::uint32_t k_max_parallel_helpers{ 4u };
+		static constexpr std::uint32_t k_parallel_tessellation_vertices{ 16384u };
+		static constexpr std::uint32_t k_tessellation_chunk_vertices{ 4096u };
+
+		struct parallel_batch
+		{
+			std::atomic<std::uint64_t> m_cursor{ 0 };
+			std::atomic<std::uint32_t> m_count{ 0 };
+			std::atomic<std::uint32_t> m_completed{ 0 };
+			std::uint32_t m_generation{ 0 };
+			void( *m_fn )( void* context, std::uint32_t index ){ nullptr };
+			void* m_context{ nullptr };
+		};
+
+		struct texture_upload
+		{
+			texture_handle m_target{};
+			zimage::image m_image{};
+			std::vector<zimage::mip_level> m_levels{};
+			ComPtr<ID3D11Texture2D> m_texture{};
+			std::uint32_t m_level{ 0 };
+			std::uint32_t m_next_row{ 0 };
+		};
+
+		struct texture_upload_queue
+		{
+			std::mutex m_mutex{};
+			std::vector<texture_upload> m_decoded{};
+			std::deque<texture_upload> m_pending{};
+			std::atomic<std::size_t> m_in_flight{ 0 };
+
+			std::atomic<std::uint32_t> m_max_bytes_per_frame{ 4u * 1024u * 1024u };
+			std::atomic<float> m_max_milliseconds_per_frame{ 2.0f };
+		};
+
+		struct dynamic_texture
+		{
+			static constexpr std::uint32_t k_staging_ring{ 3u };
+			static constexpr std::uint32_t k_max_buffers{ 3u };
+			static constexpr std::size_t k_max_dirty_rects{ 16u };
+
+			texture_handle m_target{};
+			ComPtr<ID3D11Texture2D> m_textures[ k_max_buffers ]{};
+			ComPtr<ID3D11ShaderResourceView> m_views[ k_max_buffers ]{};
+			ComPtr<ID3D11Texture2D> m_staging[ k_staging_ring ]{};
+			std::vector<std::uint8_t> m_shadow{};
+			std::vector<D3D11_RECT> m_dirty{};
+			std::vector<D3D11_RECT> m_stale[ k_max_buffers ]{};
+			std::uint32_t m_bytes_per_pixel{ 4 };
+			std::uint32_t m_buffer_count{ 1 };
+			std::uint32_t m_front{ 0 };
+			std::uint32_t m_next_staging{ 0 };
+			std::uint32_t m_released_frames{ 0 };
+		};
+
+		struct dynamic_texture_store
+		{
+			std::mutex m_mutex{};
+			ankerl::unordered_dense::map<const texture*, dynamic_texture> m_textures{};
+		};
+
+		struct texture_generations
+		{
+			std::mutex m_mutex{};
+			ankerl::unordered_dense::map<const ID3D11ShaderResourceView*, std::uint64_t> m_values{};
+		};
+
+		struct texture_cache_key
+		{
+			std::uint64_t m_hash{ 0 };
+			std::uint64_t m_check{ 0 };
+			std::size_t m_size{ 0 };
+		};
+
+		struct texture_cache_entry
+		{
+			texture_handle m_texture{};
+			std::uint64_t m_last_used{ 0 };
+			std::uint64_t m_check{ 0 };
+			std::size_t m_size{ 0 };
+		};
+
+		struct texture_cache
+		{
+			std::mutex m_mutex{};
+			ankerl::unordered_dense::map<std::uint64_t, texture_cache_entry> m_entries{};
+			ankerl::unordered_dense::map<std::string, texture_cache_key> m_paths{};
+
+			std::uint64_t m_tick{ 0 };
+			std::size_t m_bytes{ 0 };
+			std::size_t m_hits{ 0 };
+			std::size_t m_misses{ 0 };
+		};
+
+		struct render_target
+		{
+			ComPtr<ID3D11Texture2D> m_texture{};
+			ComPtr<ID3D11RenderTargetView> m_rtv{};
+			ComPtr<ID3D11ShaderResourceView> m_srv{};
+			std::uint32_t m_width{ 0 };
+			std::uint32_t m_height{ 0 };
+		};
+
+		struct cached_region
+		{
+			render_target m_target{};
+			std::uint64_t m_hash{ 0 };
+			std::uint64_t m_last_frame{ 0 };
+			bool m_valid{ false };
+		};
+
+		struct active_region
+		{
+			draw_list* m_list{ nullptr };
+			std::uint64_t m_id{ 0 };
+			D3D11_RECT m_rect{};
+			std::uint32_t m_vertices{ 0 };
+			std::uint32_t m_sdf_vertices{ 0 };
+			std::uint32_t m_indices{ 0 };
+			std::uint32_t m_commands{ 0 };
+			std::uint32_t m_occluders{ 0 };
+			std::uint32_t m_nested{ 0 };
+		};
+
+		enum class frame_slot_state : std::uint8_t { free, building, ready, submitting };
+
+		struct frame_slot
+		{
+			draw_list m_draw_lists[ 3 ]{};
+			frame_arena m_frame_arena{};
+			std::vector<render_target> m_retired_targets{};
+			frame_slot_state m_state{ frame_slot_state::free };
+			bool m_invalidated{ false };
+		};
+
 		struct render_data
 		{
 			ComPtr<ID3D11Device> m_device{};
 			ComPtr<ID3D11DeviceContext> m_context{};
 
 			persistent_buffer m_vertex_buffer{};
+			persistent_buffer m_sdf_vertex_buffer{};
 			persistent_buffer m_index_buffer{};
 
 			ComPtr<ID3D11Buffer> m_constant_buffer{};
 			ComPtr<ID3D11VertexShader> m_vertex_shader{};
 			ComPtr<ID3D11PixelShader> m_pixel_shader{};
 			ComPtr<ID3D11InputLayout> m_input_layout{};
+			ComPtr<ID3D11VertexShader> m_sdf_vertex_shader{};
+			ComPtr<ID3D11PixelShader> m_sdf_pixel_shader{};
+			ComPtr<ID3D11PixelShader> m_glyph_pixel_shader{};
+			ComPtr<ID3D11InputLayout> m_sdf_input_layout{};
 			ComPtr<ID3D11RasterizerState> m_rasterizer_state{};
 			ComPtr<ID3D11BlendState> m_blend_state{};
 			ComPtr<ID3D11DepthStencilState> m_depth_stencil_state{};
@@ -173,10 +374,22 @@ namespace zdraw {
 			ComPtr<ID3D11ShaderResourceView> m_white_texture_srv{};
 
 			static constexpr std::uint32_t k_initial_vertex_capacity{ 65536u * static_cast< std::uint32_t >( sizeof( vertex ) ) };
+			static constexpr std::uint32_t k_initial_sdf_vertex_capacity{ 4096u * static_cast< std::uint32_t >( sizeof( sdf_vertex ) ) };
 			static constexpr std::uint32_t k_initial_index_capacity{ 131072u * static_cast< std::uint32_t >( sizeof( std::uint32_t ) ) };
 
-			draw_list m_draw_lists[ 3 ]{};
-			render_state_cache m_state_cache{};
+			static constexpr std::uint32_t k_frame_slots{ 2u };
+
+			frame_slot m_frames[ k_frame_slots ]{};
+			std::uint32_t m_build_slot{ 0 };
+			std::uint32_t m_next_build_slot{ 0 };
+			std::uint32_t m_next_submit_slot{ 0 };
+			std::mutex m_frame_mutex{};
+			std::condition_variable m_frame_cv{};
+			bool m_frames_stopped{ false };
+
+			std::atomic<int> m_display_width{ 0 };
+			std::atomic<int> m_display_height{ 0 };
+
 
 			std::vector<std::unique_ptr<font>> m_fonts{};
 			font* m_default_font{ nullptr };
@@ -188,25 +401,57 @@ namespace zdraw {
 
 			LARGE_INTEGER m_performance_frequency{};
 			LARGE_INTEGER m_last_frame_time{};
-			float m_delta_time{ 0.0f };
-			float m_framerate{ 0.0f };
+			std::atomic<float> m_delta_time{ 0.0f };
+			std::atomic<float> m_framerate{ 0.0f };
 
 			static constexpr float k_framerate_smoothing{ 0.1f };
+
+			parallel_batch m_tessellation_batch{};
+			parallel_batch m_submit_batch{};
+			std::atomic<bool> m_deferred_tessellation{ false };
+			std::atomic<bool> m_deferred_contexts{ false };
+			ComPtr<ID3D11DeviceContext> m_recording_contexts[ 3 ]{};
+			std::atomic<bool> m_occlusion_culling{ false };
+			occlusion_stats m_occlusion_stats{};
+
+			std::atomic<bool> m_skip_unchanged_frames{ false };
+			std::atomic<bool> m_frame_hash_valid{ false };
+			std::uint64_t m_frame_hash{ 0 };
+			texture_generations m_texture_generations{};
+
+			texture_upload_queue m_texture_uploads{};
+			texture_cache m_texture_cache{};
+			dynamic_texture_store m_dynamic_textures{};
+			worker_pool m_workers{};
+
+			static constexpr std::uint64_t k_region_evict_frames{ 120u };
+			static constexpr std::size_t k_max_pooled_targets{ 8u };
+			static constexpr std::uint32_t k_target_granularity{ 64u };
+
+			ankerl::unordered_dense::map<std::uint64_t, cached_region> m_cached_regions{};
+			std::vector<render_target> m_target_pool{};
+			active_region m_active_region{};
+			std::uint64_t m_frame_index{ 0 };
 		};
 
 		struct constant_buffer_data
 		{
 			float m_projection[ 4 ][ 4 ];
+			float m_pos_params[ 4 ];
 		};
 
 		static render_data g_render{};
+		static thread_local frame_arena* t_frame_arena{ nullptr };
 
 		[[nodiscard]] static bool create_shaders( )
 		{
 			ComPtr<ID3DBlob> vs_blob{};
 			ComPtr<ID3DBlob> error_blob{};
 
-			auto hr{ D3DCompile( shaders::vertex_shader_src, std::strlen( shaders::vertex_shader_src ), nullptr, nullptr, nullptr, "main", "vs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_SKIP_VALIDATION, 0, &vs_blob, &error_blob ) };
+			using traits = vertex_traits<vertex>;
+			const D3D_SHADER_MACRO defines[ ]{ { traits::k_shader_define, "1" }, { nullptr, nullptr } };
+
+			auto hr{ D3DCompile( shaders::vertex_shader_src, std::strlen( shaders::vertex_shader_src ), nullptr, traits::k_shader_define ? defines : nullptr, nullptr, "main", "vs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_SKIP_VALIDATION, 0, &vs_blob, &error_blob ) };
 			if ( FAILED( hr ) ) [[unlikely]]
 			{
 				return false;
@@ -220,8 +465,8 @@ namespace zdraw {
 
 			constexpr D3D11_INPUT_ELEMENT_DESC layout[ ]
 			{
-				{"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof( vertex, m_pos ),D3D11_INPUT_PER_VERTEX_DATA, 0},
-				{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof( vertex, m_uv ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"POSITION", 0, traits::k_pos_format, 0, offsetof( vertex, m_pos ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TEXCOORD", 0, traits::k_uv_format, 0, offsetof( vertex, m_uv ),D3D11_INPUT_PER_VERTEX_DATA, 0},
 				{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof( vertex, m_col ),D3D11_INPUT_PER_VERTEX_DATA, 0},
 			};
 
@@ -243,6 +488,65 @@ namespace zdraw {
 			return SUCCEEDED( hr );
 		}
 
+		[[nodiscard]] static bool create_sdf_shaders( )
+		{
+			ComPtr<ID3DBlob> vs_blob{};
+			ComPtr<ID3DBlob> error_blob{};
+
+			auto hr{ D3DCompile( shaders::sdf_vertex_shader_src, std::strlen( shaders::sdf_vertex_shader_src ), nullptr, nullptr, nullptr, "main", "vs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_SKIP_VALIDATION, 0, &vs_blob, &error_blob ) };
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			hr = g_render.m_device->CreateVertexShader( vs_blob->GetBufferPointer( ), vs_blob->GetBufferSize( ), nullptr, &g_render.m_sdf_vertex_shader );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			constexpr D3D11_INPUT_ELEMENT_DESC layout[ ]
+			{
+				{"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof( sdf_vertex, m_pos ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof( sdf_vertex, m_local ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TEXCOORD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, offsetof( sdf_vertex, m_shape ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TEXCOORD", 2, DXGI_FORMAT_R32_FLOAT, 0, offsetof( sdf_vertex, m_softness ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof( sdf_vertex, m_col ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"COLOR", 1, DXGI_FORMAT_R8G8B8A8_UNORM, 0, offsetof( sdf_vertex, m_effect_col ),D3D11_INPUT_PER_VERTEX_DATA, 0},
+			};
+
+			hr = g_render.m_device->CreateInputLayout( layout, 6, vs_blob->GetBufferPointer( ), vs_blob->GetBufferSize( ), &g_render.m_sdf_input_layout );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ComPtr<ID3DBlob> ps_blob{};
+			error_blob.Reset( );
+			hr = D3DCompile( shaders::sdf_pixel_shader_src, std::strlen( shaders::sdf_pixel_shader_src ), nullptr, nullptr, nullptr, "main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_SKIP_VALIDATION, 0, &ps_blob, &error_blob );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			hr = g_render.m_device->CreatePixelShader( ps_blob->GetBufferPointer( ), ps_blob->GetBufferSize( ), nullptr, &g_render.m_sdf_pixel_shader );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ps_blob.Reset( );
+			error_blob.Reset( );
+			hr = D3DCompile( shaders::glyph_pixel_shader_src, std::strlen( shaders::glyph_pixel_shader_src ), nullptr, nullptr, nullptr, "main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3 | D3DCOMPILE_SKIP_VALIDATION, 0, &ps_blob, &error_blob );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			hr = g_render.m_device->CreatePixelShader( ps_blob->GetBufferPointer( ), ps_blob->GetBufferSize( ), nullptr, &g_render.m_glyph_pixel_shader );
+			return SUCCEEDED( hr );
+		}
+
 		[[nodiscard]] static bool create_render_states( )
 		{
 			D3D11_RASTERIZER_DESC raster_desc{};
@@ -260,7 +564,7 @@ namespace zdraw {
 
 			D3D11_BLEND_DESC blend_desc{};
 			blend_desc.RenderTarget[ 0 ].BlendEnable = TRUE;
-			blend_desc.RenderTarget[ 0 ].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+			blend_desc.RenderTarget[ 0 ].SrcBlend = D3D11_BLEND_ONE;
 			blend_desc.RenderTarget[ 0 ].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
 			blend_desc.RenderTarget[ 0 ].BlendOp = D3D11_BLEND_OP_ADD;
 			blend_desc.RenderTarget[ 0 ].SrcBlendAlpha = D3D11_BLEND_ONE;
@@ -337,9 +641,14 @@ namespace zdraw {
 
 		[[nodiscard]] static bool create_persistent_buffers( )
 		{
-			return g_render.m_vertex_buffer.create( g_render.m_device.Get( ), g_render.k_initial_vertex_capacity, D3D11_BIND_VERTEX_BUFFER ) && g_render.m_index_buffer.create( g_render.m_device.Get( ), g_render.k_initial_index_capacity, D3D11_BIND_INDEX_BUFFER );
+			return g_render.m_vertex_buffer.create( g_render.m_device.Get( ), g_render.k_initial_vertex_capacity, D3D11_BIND_VERTEX_BUFFER ) &&
+				g_render.m_sdf_vertex_buffer.create( g_render.m_device.Get( ), g_render.k_initial_sdf_vertex_capacity, D3D11_BIND_VERTEX_BUFFER ) &&
+				g_render.m_index_buffer.create( g_render.m_device.Get( ), g_render.k_initial_index_capacity, D3D11_BIND_INDEX_BUFFER );
 		}
 
+		static constexpr int k_glyph_padding{ 4 };
+		static constexpr float k_max_glyph_effect_reach{ static_cast< float >( k_glyph_padding - 1 ) };
+
 		static font* create_font( std::span<const std::byte> font_data, float size_pixels, int atlas_width, int atlas_height )
 		{
 			FT_Library ft_library{ nullptr };
@@ -376,7 +685,15 @@ namespace zdraw {
 
 			std::vector<std::uint8_t> rgba_bitmap( static_cast< std::size_t >( atlas_width ) * static_cast< std::size_t >( atlas_height ) * 4u, 0u );
 
-			constexpr auto padding{ 1 };
+			const auto inv_width{ 1.0f / static_cast< float >( atlas_width ) };
+			const auto inv_height{ 1.0f / static_cast< float >( atlas_height ) };
+
+			for ( auto& baked : new_font->m_glyphs )
+			{
+				baked.m_valid = true;
+			}
+
+			constexpr auto padding{ k_glyph_padding };
 			auto pen_x{ padding };
 			auto pen_y{ padding };
 			auto row_height{ 0 };
@@ -387,8 +704,7 @@ namespace zdraw {
 
 				if ( FT_Load_Char( ft_face, c, FT_LOAD_RENDER | FT_LOAD_TARGET_LIGHT ) != 0 )
 				{
-					auto& info{ new_font->m_glyph_info[ i ] };
-					info.m_advance_x = size_pixels * 0.5f;
+					new_font->m_glyphs[ i ].m_advance_x = size_pixels * 0.5f;
 					continue;
 				}
 
@@ -419,21 +735,24 @@ namespace zdraw {
 						const auto atlas_idx{ static_cast< std::size_t >( atlas_y * atlas_width + atlas_x ) * 4u };
 						const auto bitmap_idx{ static_cast< std::size_t >( y * bitmap.pitch + x ) };
 
-						rgba_bitmap[ atlas_idx + 0 ] = 255u;
-						rgba_bitmap[ atlas_idx + 1 ] = 255u;
-						rgba_bitmap[ atlas_idx + 2 ] = 255u;
-						rgba_bitmap[ atlas_idx + 3 ] = bitmap.buffer[ bitmap_idx ];
+						const auto coverage{ bitmap.buffer[ bitmap_idx ] };
+						rgba_bitmap[ atlas_idx + 0 ] = coverage;
+						rgba_bitmap[ atlas_idx + 1 ] = coverage;
+						rgba_bitmap[ atlas_idx + 2 ] = coverage;
+						rgba_bitmap[ atlas_idx + 3 ] = coverage;
 					}
 				}
 
-				auto& info{ new_font->m_glyph_info[ i ] };
-				info.m_advance_x = static_cast< float >( glyph->advance.x ) / 64.0f;
-				info.m_bearing_x = static_cast< float >( glyph->bitmap_left );
-				info.m_bearing_y = static_cast< float >( glyph->bitmap_top );
-				info.m_width = static_cast< float >( glyph_width );
-				info.m_height = static_cast< float >( glyph_height );
-				info.m_atlas_x = static_cast< float >( pen_x );
-				info.m_atlas_y = static_cast< float >( pen_y );
+				auto& baked{ new_font->m_glyphs[ i ] };
+				baked.m_advance_x = static_cast< float >( glyph->advance.x ) / 64.0f;
+				baked.m_quad_x0 = static_cast< float >( glyph->bitmap_left );
+				baked.m_quad_y0 = -static_cast< float >( glyph->bitmap_top );
+				baked.m_quad_x1 = baked.m_quad_x0 + static_cast< float >( glyph_width );
+				baked.m_quad_y1 = baked.m_quad_y0 + static_cast< float >( glyph_height );
+				baked.m_uv_x0 = static_cast< float >( pen_x ) * inv_width;
+				baked.m_uv_y0 = static_cast< float >( pen_y ) * inv_height;
+				baked.m_uv_x1 = static_cast< float >( pen_x + glyph_width ) * inv_width;
+				baked.m_uv_y1 = static_cast< float >( pen_y + glyph_height ) * inv_height;
 
 				pen_x += glyph_width + padding;
 				row_height = std::max( row_height, glyph_height );
@@ -477,37 +796,45 @@ namespace zdraw {
 			return g_render.m_fonts.back( ).get( );
 		}
 
-		static void ensure_buffer_capacity( draw_list& dl )
+		static void ensure_buffer_capacity( const draw_list& dl )
 		{
 			const std::uint32_t required_vertex_bytes{ static_cast< std::uint32_t >( dl.m_vertices.size( ) ) * static_cast< std::uint32_t >( sizeof( vertex ) ) };
+			const std::uint32_t required_sdf_vertex_bytes{ static_cast< std::uint32_t >( dl.m_sdf_vertices.size( ) ) * static_cast< std::uint32_t >( sizeof( sdf_vertex ) ) };
 			const std::uint32_t required_index_bytes{ static_cast< std::uint32_t >( dl.m_indices.size( ) ) * static_cast< std::uint32_t >( sizeof( std::uint32_t ) ) };
 
 			if ( g_render.m_vertex_buffer.needs_resize( required_vertex_bytes ) )
 			{
 				std::uint32_t new_capacity{ std::max( g_render.m_vertex_buffer.m_capacity * 2u, required_vertex_bytes ) };
-				g_render.m_vertex_buffer.resize( g_render.m_device.Get( ), g_render.m_context.Get( ), new_capacity, D3D11_BIND_VERTEX_BUFFER );
+				g_render.m_vertex_buffer.resize( g_render.m_device.Get( ), new_capacity, D3D11_BIND_VERTEX_BUFFER );
+				g_render.m_buffer_resize_count += 1u;
+			}
+
+			if ( g_render.m_sdf_vertex_buffer.needs_resize( required_sdf_vertex_bytes ) )
+			{
+				std::uint32_t new_capacity{ std::max( g_render.m_sdf_vertex_buffer.m_capacity * 2u, required_sdf_vertex_bytes ) };
+				g_render.m_sdf_vertex_buffer.resize( g_render.m_device.Get( ), new_capacity, D3D11_BIND_VERTEX_BUFFER );
 				g_render.m_buffer_resize_count += 1u;
 			}
 
 			if ( g_render.m_index_buffer.needs_resize( required_index_bytes ) )
 			{
 				std::uint32_t new_capacity{ std::max( g_render.m_index_buffer.m_capacity * 2u, required_index_bytes ) };
-				g_render.m_index_buffer.resize( g_render.m_device.Get( ), g_render.m_context.Get( ), new_capacity, D3D11_BIND_INDEX_BUFFER );
+				g_render.m_index_buffer.resize( g_render.m_device.Get( ), new_capacity, D3D11_BIND_INDEX_BUFFER );
 				g_render.m_buffer_resize_count += 1u;
 			}
 		}
 
-		static void setup_projection_matrix( float width, float height )
+		static void setup_projection_matrix( ID3D11DeviceContext* context, float left, float top, float width, float height, float pos_scale )
 		{
 			D3D11_MAPPED_SUBRESOURCE mapped{};
-			if ( SUCCEEDED( g_render.m_context->Map( g_render.m_constant_buffer.Get( ), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped ) ) )
+			if ( SUCCEEDED( context->Map( g_render.m_constant_buffer.Get( ), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped ) ) )
 			{
 				auto cb{ static_cast< constant_buffer_data* >( mapped.pData ) };
 
-				const auto L{ 0.0f };
-				const auto R{ width };
-				const auto T{ 0.0f };
-				const auto B{ height };
+				const auto L{ left };
+				const auto R{ left + width };
+				const auto T{ top };
+				const auto B{ top + height };
 
 				const float ortho_projection[ 4 ][ 4 ]
 				{
@@ -518,33 +845,79 @@ namespace zdraw {
 				};
 
 				std::memcpy( cb->m_projection, ortho_projection, sizeof( ortho_projection ) );
-				g_render.m_context->Unmap( g_render.m_constant_buffer.Get( ), 0 );
+
+				const float pos_params[ 4 ]{ 1.0f / pos_scale, 0.0f, 0.0f, 0.0f };
+				std::memcpy( cb->m_pos_params, pos_params, sizeof( pos_params ) );
+				context->Unmap( g_render.m_constant_buffer.Get( ), 0 );
 			}
 		}
 
-		static void setup_render_state( )
+		static void setup_render_state( ID3D11DeviceContext* context )
 		{
 			auto& d{ g_render };
 
-			d.m_context->IASetInputLayout( d.m_input_layout.Get( ) );
-			d.m_context->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+			context->IASetInputLayout( d.m_input_layout.Get( ) );
+			context->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
-			d.m_context->VSSetShader( d.m_vertex_shader.Get( ), nullptr, 0 );
-			d.m_context->VSSetConstantBuffers( 0, 1, d.m_constant_buffer.GetAddressOf( ) );
-			d.m_context->PSSetShader( d.m_pixel_shader.Get( ), nullptr, 0 );
-			d.m_context->PSSetSamplers( 0, 1, d.m_sampler_state.GetAddressOf( ) );
+			context->VSSetShader( d.m_vertex_shader.Get( ), nullptr, 0 );
+			context->VSSetConstantBuffers( 0, 1, d.m_constant_buffer.GetAddressOf( ) );
+			context->PSSetShader( d.m_pixel_shader.Get( ), nullptr, 0 );
+			context->PSSetSamplers( 0, 1, d.m_sampler_state.GetAddressOf( ) );
 
-			d.m_context->RSSetState( d.m_rasterizer_state.Get( ) );
+			context->RSSetState( d.m_rasterizer_state.Get( ) );
 
 			constexpr float blend_factor[ 4 ]{ 0.0f, 0.0f, 0.0f, 0.0f };
-			d.m_context->OMSetBlendState( d.m_blend_state.Get( ), blend_factor, 0xFFFFFFFFu );
-			d.m_context->OMSetDepthStencilState( d.m_depth_stencil_state.Get( ), 0 );
+			context->OMSetBlendState( d.m_blend_state.Get( ), blend_factor, 0xFFFFFFFFu );
+			context->OMSetDepthStencilState( d.m_depth_stencil_state.Get( ), 0 );
 
 			constexpr std::uint32_t stride{ static_cast< std::uint32_t >( sizeof( vertex ) ) };
 			constexpr std::uint32_t offset{ 0u };
 
-			d.m_context->IASetVertexBuffers( 0, 1, d.m_vertex_buffer.m_buffer.GetAddressOf( ), &stride, &offset );
-			d.m_context->IASetIndexBuffer( d.m_index_buffer.m_buffer.Get( ), DXGI_FORMAT_R32_UINT, 0 );
+			context->IASetVertexBuffers( 0, 1, d.m_vertex_buffer.m_buffer.GetAddressOf( ), &stride, &offset );
+			context->IASetIndexBuffer( d.m_index_buffer.m_buffer.Get( ), DXGI_FORMAT_R32_UINT, 0 );
+		}
+
+		static void bind_pipeline( ID3D11DeviceContext* context, draw_kind kind )
+		{
+			auto& d{ g_render };
+			constexpr std::uint32_t offset{ 0u };
+
+			if ( kind != draw_kind::geometry )
+			{
+				constexpr std::uint32_t stride{ static_cast< std::uint32_t >( sizeof( sdf_vertex ) ) };
+
+				context->IASetInputLayout( d.m_sdf_input_layout.Get( ) );
+				context->VSSetShader( d.m_sdf_vertex_shader.Get( ), nullptr, 0 );
+				context->PSSetShader( kind == draw_kind::glyph ? d.m_glyph_pixel_shader.Get( ) : d.m_sdf_pixel_shader.Get( ), nullptr, 0 );
+				context->IASetVertexBuffers( 0, 1, d.m_sdf_vertex_buffer.m_buffer.GetAddressOf( ), &stride, &offset );
+				return;
+			}
+
+			constexpr std::uint32_t stride{ static_cast< std::uint32_t >( sizeof( vertex ) ) };
+
+			context->IASetInputLayout( d.m_input_layout.Get( ) );
+			context->VSSetShader( d.m_vertex_shader.Get( ), nullptr, 0 );
+			context->PSSetShader( d.m_pixel_shader.Get( ), nullptr, 0 );
+			context->IASetVertexBuffers( 0, 1, d.m_vertex_buffer.m_buffer.GetAddressOf( ), &stride, &offset );
+		}
+
+		[[nodiscard]] static float sdf_distance( const sdf_shape& shape, float x, float y ) noexcept
+		{
+			const auto radius{ std::clamp( shape.m_radius, 0.0f, std::min( shape.m_half_width, shape.m_half_height ) ) };
+			const auto qx{ std::abs( x - shape.m_center_x ) - shape.m_half_width + radius };
+			const auto qy{ std::abs( y - shape.m_center_y ) - shape.m_half_height + radius };
+
+			const auto outside_x{ std::max( qx, 0.0f ) };
+			const auto outside_y{ std::max( qy, 0.0f ) };
+			auto distance{ std::sqrt( outside_x * outside_x + outside_y * outside_y ) + std::min( std::max( qx, qy ), 0.0f ) - radius };
+
+			if ( shape.m_thickness > 0.0f )
+			{
+				const auto half_stroke{ shape.m_thickness * 0.5f };
+				distance = std::abs( distance + half_stroke ) - half_stroke;
+			}
+
+			return distance;
 		}
 
 		static void generate_circle_vertices( float x, float y, float radius, int segments, nvec<float>& points )
@@ -563,639 +936,3048 @@ namespace zdraw {
 			}
 		}
 
-		static D3D11_RECT intersect_rect( const D3D11_RECT& a, const D3D11_RECT& b )
+		static constexpr int k_max_curve_depth{ 10 };
+
+		static void append_point( nvec<float>& points, float x, float y )
 		{
-			D3D11_RECT r{};
-			r.left = std::max( a.left, b.left );
-			r.top = std::max( a.top, b.top );
-			r.right = std::min( a.right, b.right );
-			r.bottom = std::min( a.bottom, b.bottom );
-			return r;
+			auto data{ points.allocate( 2 ) };
+			data[ 0 ] = x;
+			data[ 1 ] = y;
 		}
 
-	} // namespace detail
+		static void flatten_quadratic( nvec<float>& points, float x0, float y0, float x1, float y1, float x2, float y2, float tolerance, int depth )
+		{
+			const auto dx{ x2 - x0 };
+			const auto dy{ y2 - y0 };
+			const auto chord_sq{ dx * dx + dy * dy };
+			const auto d{ std::abs( ( x1 - x2 ) * dy - ( y1 - y2 ) * dx ) * 0.5f };
+			const auto flat{ chord_sq > 0.0001f ? d * d <= tolerance * tolerance * chord_sq : std::hypot( x1 - x0, y1 - y0 ) <= tolerance };
 
-	void draw_list::push_clip_rect( float x0, float y0, float x1, float y1 )
-	{
-		D3D11_RECT r{};
-		r.left = static_cast< LONG >( std::floor( x0 ) );
-		r.top = static_cast< LONG >( std::floor( y0 ) );
-		r.right = static_cast< LONG >( std::ceil( x1 ) );
-		r.bottom = static_cast< LONG >( std::ceil( y1 ) );
+			if ( flat || depth >= k_max_curve_depth )
+			{
+				append_point( points, x2, y2 );
+				return;
+			}
 
-		if ( !this->m_clip_stack.empty( ) )
-		{
-			const auto& parent = this->m_clip_stack.back( );
-			r.left = std::max( r.left, parent.left );
-			r.top = std::max( r.top, parent.top );
-			r.right = std::min( r.right, parent.right );
-			r.bottom = std::min( r.bottom, parent.bottom );
-		}
+			const auto x01{ ( x0 + x1 ) * 0.5f }, y01{ ( y0 + y1 ) * 0.5f };
+			const auto x12{ ( x1 + x2 ) * 0.5f }, y12{ ( y1 + y2 ) * 0.5f };
+			const auto xm{ ( x01 + x12 ) * 0.5f }, ym{ ( y01 + y12 ) * 0.5f };
 
-		this->m_clip_stack.push_back( r );
-	}
+			flatten_quadratic( points, x0, y0, x01, y01, xm, ym, tolerance, depth + 1 );
+			flatten_quadratic( points, xm, ym, x12, y12, x2, y2, tolerance, depth + 1 );
+		}
 
-	void draw_list::pop_clip_rect( )
-	{
-		if ( !this->m_clip_stack.empty( ) )
+		static void flatten_cubic( nvec<float>& points, float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, float tolerance, int depth )
 		{
-			this->m_clip_stack.pop_back( );
-		}
-	}
+			const auto dx{ x3 - x0 };
+			const auto dy{ y3 - y0 };
+			const auto chord_sq{ dx * dx + dy * dy };
+			const auto d{ ( std::abs( ( x1 - x3 ) * dy - ( y1 - y3 ) * dx ) + std::abs( ( x2 - x3 ) * dy - ( y2 - y3 ) * dx ) ) * 0.75f };
+			const auto flat{ chord_sq > 0.0001f ? d * d <= tolerance * tolerance * chord_sq : std::hypot( x1 - x0, y1 - y0 ) + std::hypot( x2 - x0, y2 - y0 ) <= tolerance };
 
-	void draw_list::ensure_draw_cmd( ID3D11ShaderResourceView* texture )
-	{
-		auto actual_texture{ texture != nullptr ? texture : detail::g_render.m_white_texture_srv.Get( ) };
-		const auto has_clip = !this->m_clip_stack.empty( );
-		D3D11_RECT clip{};
+			if ( flat || depth >= k_max_curve_depth )
+			{
+				append_point( points, x3, y3 );
+				return;
+			}
 
-		if ( has_clip )
-		{
-			clip = this->m_clip_stack.back( );
+			const auto x01{ ( x0 + x1 ) * 0.5f }, y01{ ( y0 + y1 ) * 0.5f };
+			const auto x12{ ( x1 + x2 ) * 0.5f }, y12{ ( y1 + y2 ) * 0.5f };
+			const auto x23{ ( x2 + x3 ) * 0.5f }, y23{ ( y2 + y3 ) * 0.5f };
+			const auto x012{ ( x01 + x12 ) * 0.5f }, y012{ ( y01 + y12 ) * 0.5f };
+			const auto x123{ ( x12 + x23 ) * 0.5f }, y123{ ( y12 + y23 ) * 0.5f };
+			const auto xm{ ( x012 + x123 ) * 0.5f }, ym{ ( y012 + y123 ) * 0.5f };
+
+			flatten_cubic( points, x0, y0, x01, y01, x012, y012, xm, ym, tolerance, depth + 1 );
+			flatten_cubic( points, xm, ym, x123, y123, x23, y23, x3, y3, tolerance, depth + 1 );
 		}
 
-		auto need_new_cmd{ false };
+		static constexpr std::uint32_t k_max_triangulation_grid{ 256u };
 
-		if ( this->m_commands.size( ) == 0 )
-		{
-			need_new_cmd = true;
-		}
-		else
+		[[nodiscard]] static float polygon_winding( std::span<const float> points ) noexcept
 		{
-			const auto& last = this->m_commands.data( )[ this->m_commands.size( ) - 1 ];
-			if ( last.m_texture.Get( ) != actual_texture )
-			{
-				need_new_cmd = true;
-			}
-			else if ( last.m_has_clip != has_clip )
-			{
-				need_new_cmd = true;
-			}
-			else if ( has_clip )
+			const auto n{ points.size( ) / 2 };
+			auto area{ 0.0f };
+
+			for ( std::size_t i{ 0 }, j{ n - 1 }; i < n; j = i++ )
 			{
-				const auto& lr = last.m_clip_rect;
-				if ( lr.left != clip.left || lr.top != clip.top || lr.right != clip.right || lr.bottom != clip.bottom )
-				{
-					need_new_cmd = true;
-				}
+				area += points[ j * 2 + 0 ] * points[ i * 2 + 1 ] - points[ i * 2 + 0 ] * points[ j * 2 + 1 ];
 			}
+
+			return area < 0.0f ? -1.0f : 1.0f;
 		}
 
-		if ( need_new_cmd )
+		static void triangulate_polygon( std::span<const float> points, float winding, nvec<std::uint32_t>& work, nvec<std::uint32_t>& triangles )
 		{
-			auto cmd{ this->m_commands.allocate( 1 ) };
-			*cmd = draw_cmd{};
+			const auto n{ static_cast< std::uint32_t >( points.size( ) / 2 ) };
+			const auto px{ [ & ]( std::uint32_t i ) { return points[ static_cast< std::size_t >( i ) * 2 + 0 ]; } };
+			const auto py{ [ & ]( std::uint32_t i ) { return points[ static_cast< std::size_t >( i ) * 2 + 1 ]; } };
+
+			const auto turn{ [ & ]( std::uint32_t a, std::uint32_t b, std::uint32_t c )
+				{
+					return ( ( px( b ) - px( a ) ) * ( py( c ) - py( b ) ) - ( py( b ) - py( a ) ) * ( px( c ) - px( b ) ) ) * winding;
+				} };
 
-			cmd->m_texture = actual_texture;
-			cmd->m_idx_offset = static_cast< std::uint32_t >( this->m_indices.size( ) );
-			cmd->m_has_clip = has_clip;
+			work.clear( );
+			auto prev{ work.allocate( static_cast< std::size_t >( n ) * 3u ) };
+			auto next{ prev + n };
+			auto reflex{ next + n };
 
-			if ( has_clip )
+			auto reflex_count{ 0u };
+			auto min_x{ std::numeric_limits<float>::max( ) }, min_y{ std::numeric_limits<float>::max( ) };
+			auto max_x{ std::numeric_limits<float>::lowest( ) }, max_y{ std::numeric_limits<float>::lowest( ) };
+
+			for ( std::uint32_t i{ 0 }; i < n; ++i )
 			{
-				cmd->m_clip_rect = clip;
+				prev[ i ] = i == 0 ? n - 1 : i - 1;
+				next[ i ] = i + 1 == n ? 0 : i + 1;
+				reflex[ i ] = turn( prev[ i ], i, next[ i ] ) <= 0.0f ? 1u : 0u;
+
+				if ( reflex[ i ] )
+				{
+					++reflex_count;
+					min_x = std::min( min_x, px( i ) ); max_x = std::max( max_x, px( i ) );
+					min_y = std::min( min_y, py( i ) ); max_y = std::max( max_y, py( i ) );
+				}
 			}
-		}
-	}
 
-	void draw_list::add_line( float x0, float y0, float x1, float y1, rgba color, float thickness )
-	{
-		this->ensure_draw_cmd( nullptr );
+			const auto grid{ std::clamp( static_cast< std::uint32_t >( std::sqrt( static_cast< float >( reflex_count ) ) ), 1u, k_max_triangulation_grid ) };
+			const auto scale_x{ max_x > min_x ? static_cast< float >( grid ) / ( max_x - min_x ) : 0.0f };
+			const auto scale_y{ max_y > min_y ? static_cast< float >( grid ) / ( max_y - min_y ) : 0.0f };
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-		const auto dx{ x1 - x0 };
-		const auto dy{ y1 - y0 };
-		const auto length{ std::sqrt( dx * dx + dy * dy ) };
+			const auto cell_x{ [ & ]( float x ) { return static_cast< std::uint32_t >( std::clamp( ( x - min_x ) * scale_x, 0.0f, static_cast< float >( grid - 1 ) ) ); } };
+			const auto cell_y{ [ & ]( float y ) { return static_cast< std::uint32_t >( std::clamp( ( y - min_y ) * scale_y, 0.0f, static_cast< float >( grid - 1 ) ) ); } };
+
+			const auto cell_count{ grid * grid };
+			auto cell_start{ work.allocate( static_cast< std::size_t >( cell_count ) + 1u + reflex_count ) };
+			auto cell_items{ cell_start + cell_count + 1u };
+
+			prev = work.data( );
+			next = prev + n;
+			reflex = next + n;
+
+			std::fill_n( cell_start, cell_count + 1u, 0u );
+
+			for ( std::uint32_t i{ 0 }; i < n; ++i )
+			{
+				if ( reflex[ i ] )
+				{
+					++cell_start[ cell_y( py( i ) ) * grid + cell_x( px( i ) ) + 1u ];
+				}
+			}
+
+			for ( std::uint32_t c{ 0 }; c < cell_count; ++c )
+			{
+				cell_start[ c + 1u ] += cell_start[ c ];
+			}
+
+			for ( std::uint32_t i{ 0 }; i < n; ++i )
+			{
+				if ( reflex[ i ] )
+				{
+					cell_items[ cell_start[ cell_y( py( i ) ) * grid + cell_x( px( i ) ) ]++ ] = i;
+				}
+			}
+
+			for ( auto c{ cell_count }; c > 0u; --c )
+			{
+				cell_start[ c ] = cell_start[ c - 1u ];
+			}
+
+			cell_start[ 0 ] = 0u;
+
+			const auto is_ear{ [ & ]( std::uint32_t b )
+				{
+					const auto a{ prev[ b ] };
+					const auto c{ next[ b ] };
+
+					if ( reflex[ b ] )
+					{
+						return false;
+					}
+
+					if ( reflex_count == 0u )
+					{
+						return true;
+					}
+
+					const auto lo_x{ std::min( { px( a ), px( b ), px( c ) } ) }, hi_x{ std::max( { px( a ), px( b ), px( c ) } ) };
+					const auto lo_y{ std::min( { py( a ), py( b ), py( c ) } ) }, hi_y{ std::max( { py( a ), py( b ), py( c ) } ) };
+					const auto y0{ cell_y( lo_y ) }, y1{ cell_y( hi_y ) };
+					const std::uint32_t corners[ 3 ]{ a, b, c };
+					float edge_lo[ 3 ]{}, edge_hi[ 3 ]{}, edge_x[ 3 ]{}, edge_y[ 3 ]{}, edge_slope[ 3 ]{};
+
+					for ( int e{ 0 }; e < 3; ++e )
+					{
+						const auto i{ corners[ e ] }, j{ corners[ ( e + 1 ) % 3 ] };
+						const auto ey{ py( j ) - py( i ) };
+
+						edge_lo[ e ] = std::min( py( i ), py( j ) );
+						edge_hi[ e ] = std::max( py( i ), py( j ) );
+						edge_x[ e ] = px( i );
+						edge_y[ e ] = py( i );
+						edge_slope[ e ] = ey != 0.0f ? ( px( j ) - px( i ) ) / ey : 0.0f;
+					}
+
+					for ( auto gy{ y0 }; gy <= y1; ++gy )
+					{
+						const auto band_lo{ gy == y0 ? lo_y : min_y + static_cast< float >( gy ) / scale_y };
+						const auto band_hi{ gy == y1 ? hi_y : min_y + static_cast< float >( gy + 1u ) / scale_y };
+
+						auto row_lo{ hi_x }, row_hi{ lo_x };
+						for ( int e{ 0 }; e < 3; ++e )
+						{
+							const auto y_lo{ std::max( band_lo, edge_lo[ e ] ) }, y_hi{ std::min( band_hi, edge_hi[ e ] ) };
+							if ( y_lo > y_hi )
+							{
+								continue;
+							}
+
+							const auto x_lo{ edge_x[ e ] + ( y_lo - edge_y[ e ] ) * edge_slope[ e ] };
+							const auto x_hi{ edge_x[ e ] + ( y_hi - edge_y[ e ] ) * edge_slope[ e ] };
+							row_lo = std::min( { row_lo, x_lo, x_hi } );
+							row_hi = std::max( { row_hi, x_lo, x_hi } );
+						}
+
+						if ( row_lo > row_hi )
+						{
+							continue;
+						}
+
+						for ( auto gx{ cell_x( row_lo ) }, x1{ cell_x( row_hi ) }; gx <= x1; ++gx )
+						{
+							const auto cell{ gy * grid + gx };
+
+							for ( auto k{ cell_start[ cell ] }; k < cell_start[ cell + 1u ]; ++k )
+							{
+								const auto p{ cell_items[ k ] };
+								if ( px( p ) < lo_x || px( p ) > hi_x || py( p ) < lo_y || py( p ) > hi_y || !reflex[ p ] || p == a || p == c )
+								{
+									continue;
+								}
+
+								if ( ( px( p ) == px( a ) && py( p ) == py( a ) ) || ( px( p ) == px( c ) && py( p ) == py( c ) ) )
+								{
+									continue;
+								}
+
+								if ( turn( a, b, p ) >= 0.0f && turn( b, c, p ) >= 0.0f && turn( c, a, p ) >= 0.0f )
+								{
+									return false;
+								}
+							}
+						}
+					}
+
+					return true;
+				} };
+
+			triangles.clear( );
+			auto out{ triangles.allocate( static_cast< std::size_t >( n - 2 ) * 3u ) };
+
+			auto remaining{ n };
+			auto stalled{ 0u };
+			std::uint32_t b{ 0 };
+
+			while ( remaining > 3u )
+			{
+				if ( stalled < remaining && !is_ear( b ) )
+				{
+					b = next[ b ];
+					++stalled;
+					continue;
+				}
+
+				const auto a{ prev[ b ] };
+				const auto c{ next[ b ] };
+
+				out[ 0 ] = a; out[ 1 ] = b; out[ 2 ] = c;
+				out += 3;
+
+				next[ a ] = c;
+				prev[ c ] = a;
+
+				for ( const auto v : { b, a, c } )
+				{
+					if ( reflex[ v ] && ( v == b || turn( prev[ v ], v, next[ v ] ) > 0.0f ) )
+					{
+						reflex[ v ] = 0u;
+						--reflex_count;
+					}
+				}
+
+				--remaining;
+				stalled = 0u;
+				b = next[ c ];
+			}
+
+			out[ 0 ] = prev[ b ]; out[ 1 ] = b; out[ 2 ] = next[ b ];
+		}
+
+		static void emit_concave_poly_filled( prim_writer& writer, std::span<const float> points, std::span<const std::uint32_t> triangles, float winding, rgba color )
+		{
+			const auto n{ static_cast< std::uint32_t >( points.size( ) / 2 ) };
+			const auto vtx_base{ writer.m_vtx_index };
+
+			constexpr auto aa_fringe{ 1.0f };
+			constexpr auto aa_half{ aa_fringe * 0.5f };
+
+			auto transparent{ color };
+			transparent.a = 0;
+
+			const auto edge_normal{ [ & ]( std::uint32_t i ) -> std::array<float, 2>
+				{
+					const auto j{ i + 1 == n ? 0u : i + 1 };
+					const auto dx{ points[ j * 2 + 0 ] - points[ i * 2 + 0 ] };
+					const auto dy{ points[ j * 2 + 1 ] - points[ i * 2 + 1 ] };
+
+					const auto length{ std::sqrt( dx * dx + dy * dy ) };
+					if ( length > 0.0001f )
+					{
+						return { dy / length * winding, -dx / length * winding };
+					}
+
+					return { 0.0f, 0.0f };
+				} };
+
+			auto prev_normal{ edge_normal( n - 1 ) };
+
+			for ( std::uint32_t i{ 0 }; i < n; ++i )
+			{
+				const auto curr_normal{ edge_normal( i ) };
+
+				auto normal_x{ ( prev_normal[ 0 ] + curr_normal[ 0 ] ) * 0.5f };
+				auto normal_y{ ( prev_normal[ 1 ] + curr_normal[ 1 ] ) * 0.5f };
+
+				const auto length_sq{ normal_x * normal_x + normal_y * normal_y };
+				if ( length_sq > 0.000001f )
+				{
+					const auto inv_length_sq{ std::min( 1.0f / length_sq, 100.0f ) };
+					normal_x *= inv_length_sq;
+					normal_y *= inv_length_sq;
+				}
+
+				prev_normal = curr_normal;
+
+				const auto x{ points[ i * 2 + 0 ] };
+				const auto y{ points[ i * 2 + 1 ] };
+
+				writer.push_vertex( x - normal_x * aa_half, y - normal_y * aa_half, 0.5f, 0.5f, color );
+				writer.push_vertex( x + normal_x * aa_half, y + normal_y * aa_half, 0.5f, 0.5f, transparent );
+			}
+
+			auto idx{ writer.m_idx };
+
+			for ( const auto t : triangles )
+			{
+				*idx++ = vtx_base + t * 2u;
+			}
+
+			for ( std::uint32_t i{ 0 }; i < n; ++i )
+			{
+				const auto j{ i + 1 == n ? 0u : i + 1 };
+				const auto inner_i{ vtx_base + i * 2u }, outer_i{ inner_i + 1u };
+				const auto inner_j{ vtx_base + j * 2u }, outer_j{ inner_j + 1u };
+
+				idx[ 0 ] = inner_i; idx[ 1 ] = inner_j; idx[ 2 ] = outer_j;
+				idx[ 3 ] = inner_i; idx[ 4 ] = outer_j; idx[ 5 ] = outer_i;
+				idx += 6;
+			}
+		}
+
+		static D3D11_RECT intersect_rect( const D3D11_RECT& a, const D3D11_RECT& b )
+		{
+			D3D11_RECT r{};
+			r.left = std::max( a.left, b.left );
+			r.top = std::max( a.top, b.top );
+			r.right = std::min( a.right, b.right );
+			r.bottom = std::min( a.bottom, b.bottom );
+			return r;
+		}
+
+		static constexpr LONG k_min_occluder_area{ 64 * 64 };
+		static constexpr std::uint32_t k_max_scissor_splits{ 4u };
+		static constexpr std::uint32_t k_max_split_indices{ 1536u };
+
+		struct command_visibility
+		{
+			D3D11_RECT m_rects[ k_max_scissor_splits ]{};
+			std::int32_t m_count{ -1 };
+		};
+
+		[[nodiscard]] static bool rect_empty( const D3D11_RECT& r ) noexcept
+		{
+			return r.right <= r.left || r.bottom <= r.top;
+		}
+
+		[[nodiscard]] static std::uint64_t rect_area( const D3D11_RECT& r ) noexcept
+		{
+			return rect_empty( r ) ? 0u : static_cast< std::uint64_t >( r.right - r.left ) * static_cast< std::uint64_t >( r.bottom - r.top );
+		}
+
+		static std::uint32_t subtract_rect( const D3D11_RECT& r, const D3D11_RECT& o, D3D11_RECT* out )
+		{
+			if ( o.left >= r.right || o.right <= r.left || o.top >= r.bottom || o.bottom <= r.top )
+			{
+				out[ 0 ] = r;
+				return 1u;
+			}
+
+			std::uint32_t count{ 0 };
+			const auto top{ std::max( r.top, o.top ) };
+			const auto bottom{ std::min( r.bottom, o.bottom ) };
+
+			if ( o.top > r.top ) { out[ count++ ] = D3D11_RECT{ r.left, r.top, r.right, o.top }; }
+			if ( o.bottom < r.bottom ) { out[ count++ ] = D3D11_RECT{ r.left, o.bottom, r.right, r.bottom }; }
+			if ( o.left > r.left ) { out[ count++ ] = D3D11_RECT{ r.left, top, o.left, bottom }; }
+			if ( o.right < r.right ) { out[ count++ ] = D3D11_RECT{ o.right, top, r.right, bottom }; }
+
+			return count;
+		}
+
+		static D3D11_RECT command_bounds( const draw_list& dl, const draw_cmd& cmd )
+		{
+			auto min_x{ std::numeric_limits<float>::max( ) };
+			auto min_y{ std::numeric_limits<float>::max( ) };
+			auto max_x{ std::numeric_limits<float>::lowest( ) };
+			auto max_y{ std::numeric_limits<float>::lowest( ) };
+
+			const auto indices{ dl.m_indices.data( ) + cmd.m_idx_offset };
+
+			for ( std::uint32_t i{ 0 }; i < cmd.m_idx_count; ++i )
+			{
+				std::array<float, 2> pos{};
+				if ( cmd.m_kind != draw_kind::geometry )
+				{
+					const auto& vtx{ dl.m_sdf_vertices.data( )[ indices[ i ] ] };
+					pos = { vtx.m_pos[ 0 ], vtx.m_pos[ 1 ] };
+				}
+				else
+				{
+					pos = vertex_traits<vertex>::position( dl.m_vertices.data( )[ indices[ i ] ], dl.m_pos_scale );
+				}
+
+				min_x = std::min( min_x, pos[ 0 ] );
+				min_y = std::min( min_y, pos[ 1 ] );
+				max_x = std::max( max_x, pos[ 0 ] );
+				max_y = std::max( max_y, pos[ 1 ] );
+			}
+
+			return D3D11_RECT
+			{
+				static_cast< LONG >( std::floor( min_x ) ),
+				static_cast< LONG >( std::floor( min_y ) ),
+				static_cast< LONG >( std::ceil( max_x ) ),
+				static_cast< LONG >( std::ceil( max_y ) )
+			};
+		}
+
+		static std::span<command_visibility> cull_occluded( const draw_list& dl, const D3D11_RECT& viewport_rect, occlusion_stats& stats )
+		{
+			const auto occluders{ dl.m_occluders.span( ) };
+			if ( occluders.empty( ) )
+			{
+				return {};
+			}
+
+			const auto commands{ dl.m_commands.span( ) };
+			auto visibility{ get_frame_arena( ).allocate_array<command_visibility>( commands.size( ) ) };
+
+			for ( std::uint32_t i{ 0 }; i < occluders.back( ).m_command; ++i )
+			{
+				const auto& cmd{ commands[ i ] };
+				if ( cmd.m_idx_count == 0u )
+				{
+					continue;
+				}
+
+				auto visible{ intersect_rect( command_bounds( dl, cmd ), viewport_rect ) };
+				if ( cmd.has_clip( ) )
+				{
+					visible = intersect_rect( visible, dl.clip_rect_of( cmd ) );
+				}
+
+				if ( rect_empty( visible ) )
+				{
+					continue;
+				}
+
+				D3D11_RECT region[ k_max_scissor_splits ]{ visible };
+				std::uint32_t region_count{ 1 };
+
+				const auto first{ std::upper_bound( occluders.begin( ), occluders.end( ), i, [ ]( std::uint32_t index, const occluder& o ) { return index < o.m_command; } ) };
+
+				for ( auto it{ first }; it != occluders.end( ) && region_count > 0u; ++it )
+				{
+					D3D11_RECT next[ k_max_scissor_splits * 4u ]{};
+					std::uint32_t next_count{ 0 };
+
+					for ( std::uint32_t r{ 0 }; r < region_count; ++r )
+					{
+						next_count += subtract_rect( region[ r ], it->m_rect, next + next_count );
+					}
+
+					if ( next_count > k_max_scissor_splits )
+					{
+						continue;
+					}
+
+					std::copy_n( next, next_count, region );
+					region_count = next_count;
+				}
+
+				auto remaining{ std::uint64_t{ 0 } };
+				for ( std::uint32_t r{ 0 }; r < region_count; ++r )
+				{
+					remaining += rect_area( region[ r ] );
+				}
+
+				const auto saved{ rect_area( visible ) - remaining };
+				if ( saved == 0u || ( region_count > 0u && cmd.m_idx_count > k_max_split_indices ) )
+				{
+					continue;
+				}
+
+				auto& entry{ visibility[ i ] };
+				entry.m_count = static_cast< std::int32_t >( region_count );
+				std::copy_n( region, region_count, entry.m_rects );
+
+				if ( region_count == 0u )
+				{
+					++stats.m_culled_commands;
+				}
+				else
+				{
+					++stats.m_split_commands;
+				}
+
+				stats.m_pixels_saved += saved;
+			}
+
+			return visibility;
+		}
+
+		struct command_key
+		{
+			std::uintptr_t m_texture{ 0 };
+			std::uint32_t m_idx_offset{ 0 };
+			std::uint32_t m_idx_count{ 0 };
+			D3D11_RECT m_clip_rect{};
+			std::uint32_t m_pipeline{ 0 };
+			std::uint32_t m_has_clip{ 0 };
+			std::uint64_t m_generation{ 0 };
+		};
+
+		[[nodiscard]] static std::uint64_t texture_generation( const texture_generations& generations, const ID3D11ShaderResourceView* view ) noexcept
+		{
+			if ( generations.m_values.empty( ) )
+			{
+				return 0u;
+			}
+
+			const auto it{ generations.m_values.find( view ) };
+			return it != generations.m_values.end( ) ? it->second : 0u;
+		}
+
+		[[nodiscard]] static command_key make_command_key( const draw_list& dl, const draw_cmd& cmd, const texture_generations& generations, std::uint32_t idx_base = 0u ) noexcept
+		{
+			return
+			{
+				reinterpret_cast< std::uintptr_t >( dl.texture_of( cmd ) ),
+				cmd.m_idx_offset - idx_base,
+				cmd.m_idx_count,
+				cmd.has_clip( ) ? dl.clip_rect_of( cmd ) : D3D11_RECT{},
+				static_cast< std::uint32_t >( cmd.m_kind ),
+				cmd.has_clip( ) ? 1u : 0u,
+				texture_generation( generations, dl.texture_of( cmd ) )
+			};
+		}
+
+		static std::uint64_t hash_frame( std::span<const draw_list> draw_lists, const D3D11_RECT& viewport_rect )
+		{
+			auto& generations{ g_render.m_texture_generations };
+			std::scoped_lock lock{ generations.m_mutex };
+
+			zhash::hasher hasher{};
+			hasher.update_values( std::span{ &viewport_rect, 1u } );
+
+			for ( const auto& dl : draw_lists )
+			{
+				const std::uint64_t sizes[ ]{ dl.m_vertices.size( ), dl.m_sdf_vertices.size( ), dl.m_indices.size( ), dl.m_commands.size( ) };
+				hasher.update_values( std::span{ sizes } );
+				hasher.update_values( std::span{ &dl.m_pos_scale, 1u } );
+				hasher.update_values( dl.m_vertices.span( ) );
+				hasher.update_values( dl.m_sdf_vertices.span( ) );
+				hasher.update_values( dl.m_indices.span( ) );
+
+				for ( const auto& cmd : dl.m_commands.span( ) )
+				{
+					const auto key{ make_command_key( dl, cmd, generations ) };
+					hasher.update_values( std::span{ &key, 1u } );
+				}
+			}
+
+			return hasher.digest( );
+		}
+
+		static std::uint64_t hash_region( const draw_list& dl, const active_region& region )
+		{
+			auto& generations{ g_render.m_texture_generations };
+			std::scoped_lock lock{ generations.m_mutex };
+
+			zhash::hasher hasher{};
+			hasher.update_values( std::span{ &region.m_rect, 1u } );
+			hasher.update_values( std::span{ &dl.m_pos_scale, 1u } );
+
+			const auto vertices{ dl.m_vertices.span( ).subspan( region.m_vertices ) };
+			const auto sdf_vertices{ dl.m_sdf_vertices.span( ).subspan( region.m_sdf_vertices ) };
+			const auto commands{ dl.m_commands.span( ).subspan( region.m_commands ) };
+
+			const std::uint64_t sizes[ ]{ vertices.size( ), sdf_vertices.size( ), dl.m_indices.size( ) - region.m_indices, commands.size( ) };
+			hasher.update_values( std::span{ sizes } );
+			hasher.update_values( vertices );
+			hasher.update_values( sdf_vertices );
+
+			std::uint32_t rebased[ 256 ]{};
+
+			for ( const auto& cmd : commands )
+			{
+				const auto key{ make_command_key( dl, cmd, generations, region.m_indices ) };
+				hasher.update_values( std::span{ &key, 1u } );
+
+				const auto vtx_base{ cmd.m_kind != draw_kind::geometry ? region.m_sdf_vertices : region.m_vertices };
+				const auto indices{ dl.m_indices.span( ).subspan( cmd.m_idx_offset, cmd.m_idx_count ) };
+
+				for ( std::size_t first{ 0 }; first < indices.size( ); first += std::size( rebased ) )
+				{
+					const auto count{ std::min( indices.size( ) - first, std::size( rebased ) ) };
+					for ( std::size_t i{ 0 }; i < count; ++i )
+					{
+						rebased[ i ] = indices[ first + i ] - vtx_base;
+					}
+
+					hasher.update_values( std::span<const std::uint32_t>{ rebased, count } );
+				}
+			}
+
+			return hasher.digest( );
+		}
+
+		[[nodiscard]] static render_target acquire_render_target( std::uint32_t width, std::uint32_t height )
+		{
+			auto& pool{ g_render.m_target_pool };
+			auto best{ pool.end( ) };
+
+			for ( auto it{ pool.begin( ) }; it != pool.end( ); ++it )
+			{
+				if ( it->m_width >= width && it->m_height >= height && ( best == pool.end( ) || it->m_width * it->m_height < best->m_width * best->m_height ) )
+				{
+					best = it;
+				}
+			}
+
+			if ( best != pool.end( ) )
+			{
+				auto target{ std::move( *best ) };
+				pool.erase( best );
+				return target;
+			}
+
+			constexpr auto granularity{ render_data::k_target_granularity };
+
+			render_target target{};
+			target.m_width = ( width + granularity - 1u ) / granularity * granularity;
+			target.m_height = ( height + granularity - 1u ) / granularity * granularity;
+
+			D3D11_TEXTURE2D_DESC tex_desc{};
+			tex_desc.Width = target.m_width;
+			tex_desc.Height = target.m_height;
+			tex_desc.MipLevels = 1;
+			tex_desc.ArraySize = 1;
+			tex_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			tex_desc.SampleDesc.Count = 1;
+			tex_desc.Usage = D3D11_USAGE_DEFAULT;
+			tex_desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+			if ( FAILED( g_render.m_device->CreateTexture2D( &tex_desc, nullptr, &target.m_texture ) ) ) [[unlikely]]
+			{
+				return {};
+			}
+
+			if ( FAILED( g_render.m_device->CreateRenderTargetView( target.m_texture.Get( ), nullptr, &target.m_rtv ) ) ) [[unlikely]]
+			{
+				return {};
+			}
+
+			if ( FAILED( g_render.m_device->CreateShaderResourceView( target.m_texture.Get( ), nullptr, &target.m_srv ) ) ) [[unlikely]]
+			{
+				return {};
+			}
+
+			return target;
+		}
+
+		static void release_render_target( render_target&& target )
+		{
+			if ( !target.m_texture )
+			{
+				return;
+			}
+
+			auto& pool{ g_render.m_target_pool };
+			pool.push_back( std::move( target ) );
+
+			if ( pool.size( ) > render_data::k_max_pooled_targets )
+			{
+				g_render.m_frames[ g_render.m_build_slot ].m_retired_targets.push_back( std::move( pool.front( ) ) );
+				pool.erase( pool.begin( ) );
+			}
+		}
+
+		static void evict_cached_regions( )
+		{
+			auto& regions{ g_render.m_cached_regions };
+
+			for ( auto it{ regions.begin( ) }; it != regions.end( ); )
+			{
+				if ( g_render.m_frame_index - it->second.m_last_frame > render_data::k_region_evict_frames )
+				{
+					release_render_target( std::move( it->second.m_target ) );
+					it = regions.erase( it );
+					continue;
+				}
+
+				++it;
+			}
+		}
+
+		struct submit_target
+		{
+			ComPtr<ID3D11RenderTargetView> m_rtv{};
+			ComPtr<ID3D11DepthStencilView> m_dsv{};
+			std::span<const D3D11_VIEWPORT> m_viewports{};
+			D3D11_RECT m_viewport_rect{};
+			float m_width{ 0.0f };
+			float m_height{ 0.0f };
+		};
+
+		static void render_cached_regions( ID3D11DeviceContext* context, const draw_list& dl, const submit_target& target )
+		{
+			constexpr float clear_color[ 4 ]{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+			for ( const auto& pass : dl.m_region_passes.span( ) )
+			{
+				const auto region_w{ static_cast< float >( pass.m_rect.right - pass.m_rect.left ) };
+				const auto region_h{ static_cast< float >( pass.m_rect.bottom - pass.m_rect.top ) };
+				const D3D11_VIEWPORT region_viewport{ 0.0f, 0.0f, region_w, region_h, 0.0f, 1.0f };
+
+				context->OMSetRenderTargets( 1, &pass.m_target, nullptr );
+				context->ClearRenderTargetView( pass.m_target, clear_color );
+				context->RSSetViewports( 1, &region_viewport );
+				setup_projection_matrix( context, static_cast< float >( pass.m_rect.left ), static_cast< float >( pass.m_rect.top ), region_w, region_h, dl.m_pos_scale );
+
+				auto bound_kind{ draw_kind::geometry };
+				bind_pipeline( context, bound_kind );
+
+				for ( auto i{ pass.m_first_command }; i < pass.m_end_command; ++i )
+				{
+					const auto& cmd{ dl.m_commands.data( )[ i ] };
+					if ( cmd.m_idx_count == 0u )
+					{
+						continue;
+					}
+
+					const auto clip{ cmd.has_clip( ) ? intersect_rect( pass.m_rect, dl.clip_rect_of( cmd ) ) : pass.m_rect };
+					if ( clip.right <= clip.left || clip.bottom <= clip.top )
+					{
+						continue;
+					}
+
+					if ( cmd.m_kind != bound_kind )
+					{
+						bind_pipeline( context, cmd.m_kind );
+						bound_kind = cmd.m_kind;
+					}
+
+					const D3D11_RECT scissor{ clip.left - pass.m_rect.left, clip.top - pass.m_rect.top, clip.right - pass.m_rect.left, clip.bottom - pass.m_rect.top };
+					const auto texture{ dl.texture_of( cmd ) };
+
+					context->PSSetShaderResources( 0, 1, &texture );
+					context->RSSetScissorRects( 1, &scissor );
+					context->DrawIndexed( cmd.m_idx_count, cmd.m_idx_offset, 0 );
+				}
+			}
+
+			context->OMSetRenderTargets( 1, target.m_rtv.GetAddressOf( ), target.m_dsv.Get( ) );
+			context->RSSetViewports( static_cast< UINT >( target.m_viewports.size( ) ), target.m_viewports.data( ) );
+			setup_projection_matrix( context, 0.0f, 0.0f, target.m_width, target.m_height, dl.m_pos_scale );
+			setup_render_state( context );
+		}
+
+		static void emit_polyline( prim_writer& writer, std::span<const float> points, std::span<const rgba> colors, rgba color, bool closed, float thickness )
+		{
+			const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
+			const auto num_segments{ closed ? num_points : ( num_points - 1 ) };
+			const auto vtx_base{ writer.m_vtx_index };
+
+			constexpr auto aa_fringe{ 1.0f };
+			constexpr auto aa_half{ aa_fringe * 0.5f };
+			const auto half_thickness{ std::max( 0.0f, thickness ) * 0.5f };
+			const auto core_thickness{ std::max( 0.0f, half_thickness - aa_half ) };
+			const auto outer_thickness{ half_thickness + aa_half };
+
+			const auto segment_normal{ [ & ]( int segment ) -> std::array<float, 2>
+				{
+					const auto p2_idx{ closed ? ( ( segment + 1 ) % num_points ) : ( segment + 1 ) };
+					const auto dx{ points[ static_cast< std::size_t >( p2_idx * 2 + 0 ) ] - points[ static_cast< std::size_t >( segment * 2 + 0 ) ] };
+					const auto dy{ points[ static_cast< std::size_t >( p2_idx * 2 + 1 ) ] - points[ static_cast< std::size_t >( segment * 2 + 1 ) ] };
+
+					const auto length{ std::sqrt( dx * dx + dy * dy ) };
+					if ( length > 0.0001f )
+					{
+						return { -dy / length, dx / length };
+					}
+
+					return { 0.0f, 0.0f };
+				} };
+
+			auto prev_normal{ segment_normal( closed ? num_segments - 1 : 0 ) };
+
+			for ( int i{ 0 }; i < num_points; ++i )
+			{
+				const auto x{ points[ static_cast< std::size_t >( i ) * 2 + 0 ] };
+				const auto y{ points[ static_cast< std::size_t >( i ) * 2 + 1 ] };
+				const auto curr_normal{ i < num_segments ? segment_normal( i ) : prev_normal };
+
+				auto normal_x{ 0.0f };
+				auto normal_y{ 0.0f };
+
+				if ( closed || ( i > 0 && i < num_points - 1 ) )
+				{
+					normal_x = ( prev_normal[ 0 ] + curr_normal[ 0 ] ) * 0.5f;
+					normal_y = ( prev_normal[ 1 ] + curr_normal[ 1 ] ) * 0.5f;
+				}
+				else if ( i == 0 )
+				{
+					normal_x = curr_normal[ 0 ];
+					normal_y = curr_normal[ 1 ];
+				}
+				else
+				{
+					normal_x = prev_normal[ 0 ];
+					normal_y = prev_normal[ 1 ];
+				}
+
+				prev_normal = curr_normal;
+
+				const auto normal_length{ std::sqrt( normal_x * normal_x + normal_y * normal_y ) };
+				if ( normal_length > 0.0001f )
+				{
+					normal_x /= normal_length;
+					normal_y /= normal_length;
+				}
+
+				const auto vertex_color{ colors.empty( ) ? color : colors[ static_cast< std::size_t >( i ) ] };
+				auto transparent_color{ vertex_color };
+				transparent_color.a = 0;
+
+				writer.push_vertex( x + normal_x * core_thickness, y + normal_y * core_thickness, 0.0f, 0.0f, vertex_color );
+				writer.push_vertex( x - normal_x * core_thickness, y - normal_y * core_thickness, 1.0f, 1.0f, vertex_color );
+
+				writer.push_vertex( x + normal_x * outer_thickness, y + normal_y * outer_thickness, 0.0f, 0.0f, transparent_color );
+				writer.push_vertex( x - normal_x * outer_thickness, y - normal_y * outer_thickness, 1.0f, 1.0f, transparent_color );
+			}
+
+			auto idx{ writer.m_idx };
+
+			for ( int i{ 0 }; i < num_segments; ++i )
+			{
+				const auto next_i{ closed ? ( ( i + 1 ) % num_points ) : ( i + 1 ) };
+				const auto base_idx{ i * 18 };
+
+				const auto curr_core_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 0 ) };
+				const auto curr_core_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 1 ) };
+				const auto curr_outer_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 2 ) };
+				const auto curr_outer_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 3 ) };
+				const auto next_core_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 0 ) };
+				const auto next_core_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 1 ) };
+				const auto next_outer_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 2 ) };
+				const auto next_outer_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 3 ) };
+
+				idx[ base_idx + 0 ] = curr_core_top;
+				idx[ base_idx + 1 ] = curr_core_bot;
+				idx[ base_idx + 2 ] = next_core_bot;
+				idx[ base_idx + 3 ] = curr_core_top;
+				idx[ base_idx + 4 ] = next_core_bot;
+				idx[ base_idx + 5 ] = next_core_top;
+				idx[ base_idx + 6 ] = curr_outer_top;
+				idx[ base_idx + 7 ] = curr_core_top;
+				idx[ base_idx + 8 ] = next_core_top;
+				idx[ base_idx + 9 ] = curr_outer_top;
+				idx[ base_idx + 10 ] = next_core_top;
+				idx[ base_idx + 11 ] = next_outer_top;
+				idx[ base_idx + 12 ] = curr_core_bot;
+				idx[ base_idx + 13 ] = curr_outer_bot;
+				idx[ base_idx + 14 ] = next_outer_bot;
+				idx[ base_idx + 15 ] = curr_core_bot;
+				idx[ base_idx + 16 ] = next_outer_bot;
+				idx[ base_idx + 17 ] = next_core_bot;
+			}
+		}
+
+		static void emit_triangle_filled( prim_writer& writer, float x0, float y0, float x1, float y1, float x2, float y2, const rgba( &colors )[ 3 ] )
+		{
+			const auto vtx_base{ writer.m_vtx_index };
+
+			constexpr auto aa_fringe{ 1.0f };
+			constexpr auto aa_half{ aa_fringe * 0.5f };
+
+			rgba transparent[ 3 ]{ colors[ 0 ], colors[ 1 ], colors[ 2 ] };
+			transparent[ 0 ].a = 0;
+			transparent[ 1 ].a = 0;
+			transparent[ 2 ].a = 0;
+
+			const float vx[ 3 ]{ x0, x1, x2 };
+			const float vy[ 3 ]{ y0, y1, y2 };
+
+			const auto cx{ ( x0 + x1 + x2 ) / 3.0f };
+			const auto cy{ ( y0 + y1 + y2 ) / 3.0f };
+
+			float nx[ 3 ]{}, ny[ 3 ]{};
+
+			for ( int i{ 0 }; i < 3; ++i )
+			{
+				const auto j{ ( i + 1 ) % 3 };
+				const auto ex{ vx[ j ] - vx[ i ] };
+				const auto ey{ vy[ j ] - vy[ i ] };
+				const auto len{ std::sqrt( ex * ex + ey * ey ) };
+
+				if ( len < 0.0001f )
+				{
+					continue;
+				}
+
+				nx[ i ] = -ey / len;
+				ny[ i ] = ex / len;
+
+				const auto mid_dx{ ( vx[ i ] + vx[ j ] ) * 0.5f - cx };
+				const auto mid_dy{ ( vy[ i ] + vy[ j ] ) * 0.5f - cy };
+
+				if ( nx[ i ] * mid_dx + ny[ i ] * mid_dy < 0.0f )
+				{
+					nx[ i ] = -nx[ i ];
+					ny[ i ] = -ny[ i ];
+				}
+			}
+
+			float off_x[ 3 ]{}, off_y[ 3 ]{};
+
+			for ( int i{ 0 }; i < 3; ++i )
+			{
+				const auto prev{ ( i + 2 ) % 3 };
+				auto mx{ nx[ prev ] + nx[ i ] };
+				auto my{ ny[ prev ] + ny[ i ] };
+				const auto ml{ std::sqrt( mx * mx + my * my ) };
+
+				if ( ml > 0.0001f )
+				{
+					mx /= ml;
+					my /= ml;
+				}
+
+				const auto d{ mx * nx[ prev ] + my * ny[ prev ] };
+				const auto s{ d > 0.1f ? aa_half / d : aa_half * 2.0f };
+
+				off_x[ i ] = mx * s;
+				off_y[ i ] = my * s;
+			}
+
+			for ( int i{ 0 }; i < 3; ++i )
+			{
+				writer.push_vertex( vx[ i ] - off_x[ i ], vy[ i ] - off_y[ i ], 0.0f, 0.0f, colors[ i ] );
+			}
+
+			for ( int i{ 0 }; i < 3; ++i )
+			{
+				writer.push_vertex( vx[ i ] + off_x[ i ], vy[ i ] + off_y[ i ], 0.0f, 0.0f, transparent[ i ] );
+			}
+
+			auto idx{ writer.m_idx };
+
+			idx[ 0 ] = vtx_base + 0; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
+			idx[ 3 ] = vtx_base + 0; idx[ 4 ] = vtx_base + 3; idx[ 5 ] = vtx_base + 4;
+			idx[ 6 ] = vtx_base + 0; idx[ 7 ] = vtx_base + 4; idx[ 8 ] = vtx_base + 1;
+			idx[ 9 ] = vtx_base + 1; idx[ 10 ] = vtx_base + 4; idx[ 11 ] = vtx_base + 5;
+			idx[ 12 ] = vtx_base + 1; idx[ 13 ] = vtx_base + 5; idx[ 14 ] = vtx_base + 2;
+			idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 5; idx[ 17 ] = vtx_base + 3;
+			idx[ 18 ] = vtx_base + 2; idx[ 19 ] = vtx_base + 3; idx[ 20 ] = vtx_base + 0;
+		}
+
+		static void emit_rect_filled( prim_writer& writer, float x, float y, float w, float h, rgba color )
+		{
+			writer.push_vertex( x, y, 0.0f, 0.0f, color );
+			writer.push_vertex( x + w, y, 1.0f, 0.0f, color );
+			writer.push_vertex( x + w, y + h, 1.0f, 1.0f, color );
+			writer.push_vertex( x, y + h, 0.0f, 1.0f, color );
+			writer.push_quad_indices( );
+		}
+
+		static void emit_line( prim_writer& writer, float x0, float y0, float x1, float y1, rgba color, float thickness )
+		{
+			const auto vtx_base{ writer.m_vtx_index };
+			const auto dx{ x1 - x0 };
+			const auto dy{ y1 - y0 };
+			const auto length{ std::sqrt( dx * dx + dy * dy ) };
+
+			const auto norm_dx{ length >= 0.0001f ? dx / length : 0.0f };
+			const auto norm_dy{ length >= 0.0001f ? dy / length : 0.0f };
+
+			const auto perp_x{ -norm_dy };
+			const auto perp_y{ norm_dx };
+
+			const auto half_thickness{ std::max( 0.0f, thickness ) * 0.5f };
+			constexpr auto aa_fringe{ 1.0f };
+			constexpr auto aa_half{ aa_fringe * 0.5f };
+
+			const auto core_offset{ half_thickness - aa_half };
+			const auto core_tx{ perp_x * core_offset };
+			const auto core_ty{ perp_y * core_offset };
+
+			const auto outer_offset{ half_thickness + aa_half };
+			const auto outer_tx{ perp_x * outer_offset };
+			const auto outer_ty{ perp_y * outer_offset };
+
+			auto transparent_color{ color };
+			transparent_color.a = 0;
+
+			writer.push_vertex( x0 + core_tx, y0 + core_ty, 0.0f, 0.0f, color );
+			writer.push_vertex( x1 + core_tx, y1 + core_ty, 1.0f, 0.0f, color );
+			writer.push_vertex( x1 - core_tx, y1 - core_ty, 1.0f, 1.0f, color );
+			writer.push_vertex( x0 - core_tx, y0 - core_ty, 0.0f, 1.0f, color );
+
+			writer.push_vertex( x0 + outer_tx, y0 + outer_ty, 0.0f, 0.0f, transparent_color );
+			writer.push_vertex( x1 + outer_tx, y1 + outer_ty, 1.0f, 0.0f, transparent_color );
+			writer.push_vertex( x1 - outer_tx, y1 - outer_ty, 1.0f, 1.0f, transparent_color );
+			writer.push_vertex( x0 - outer_tx, y0 - outer_ty, 0.0f, 1.0f, transparent_color );
+
+			auto idx{ writer.m_idx };
+			idx[ 0 ] = vtx_base + 0; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
+			idx[ 3 ] = vtx_base + 0; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+			idx[ 6 ] = vtx_base + 0; idx[ 7 ] = vtx_base + 4; idx[ 8 ] = vtx_base + 5;
+			idx[ 9 ] = vtx_base + 0; idx[ 10 ] = vtx_base + 5; idx[ 11 ] = vtx_base + 1;
+			idx[ 12 ] = vtx_base + 2; idx[ 13 ] = vtx_base + 6; idx[ 14 ] = vtx_base + 7;
+			idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 7; idx[ 17 ] = vtx_base + 3;
+		}
+
+		template<typename U>
+		static void emit_circle_filled( prim_writer& writer, float x, float y, float radius, rgba color, int segments, const U& unit )
+		{
+			const auto vtx_base{ writer.m_vtx_index };
+
+			constexpr auto aa_fringe{ 1.0f };
+			const auto inner_radius = radius - aa_fringe * 0.5f;
+			const auto outer_radius = radius + aa_fringe * 0.5f;
+
+			auto transparent = color;
+			transparent.a = 0;
+
+			writer.push_vertex( x, y, 0.5f, 0.5f, color );
+
+			for ( int i{ 0 }; i < segments; ++i )
+			{
+				const auto [cos_a, sin_a] { unit( i ) };
+
+				writer.push_vertex( x + cos_a * inner_radius, y + sin_a * inner_radius, 0.5f, 0.5f, color );
+				writer.push_vertex( x + cos_a * outer_radius, y + sin_a * outer_radius, 0.5f, 0.5f, transparent );
+			}
+
+			auto idx{ writer.m_idx };
+
+			for ( int i = 0; i < segments; ++i )
+			{
+				const auto next = ( i + 1 ) % segments;
+
+				const auto curr_inner = vtx_base + 1 + static_cast< std::uint32_t >( i * 2 );
+				const auto curr_outer = vtx_base + 2 + static_cast< std::uint32_t >( i * 2 );
+				const auto next_inner = vtx_base + 1 + static_cast< std::uint32_t >( next * 2 );
+				const auto next_outer = vtx_base + 2 + static_cast< std::uint32_t >( next * 2 );
+
+				const auto base_idx = i * 9;
+				idx[ base_idx + 0 ] = vtx_base;
+				idx[ base_idx + 1 ] = curr_inner;
+				idx[ base_idx + 2 ] = next_inner;
+				idx[ base_idx + 3 ] = curr_inner;
+				idx[ base_idx + 4 ] = curr_outer;
+				idx[ base_idx + 5 ] = next_outer;
+				idx[ base_idx + 6 ] = curr_inner;
+				idx[ base_idx + 7 ] = next_outer;
+				idx[ base_idx + 8 ] = next_inner;
+			}
+		}
+
+		[[nodiscard]] static std::span<const float> make_unit_circle( int segments )
+		{
+			auto table{ get_frame_arena( ).allocate_array<float>( static_cast< std::size_t >( segments ) * 2u ) };
+			const auto angle_increment{ 2.0f * std::numbers::pi_v<float> / static_cast< float >( segments ) };
+
+			for ( int i{ 0 }; i < segments; ++i )
+			{
+				const auto angle{ angle_increment * static_cast< float >( i ) };
+				table[ static_cast< std::size_t >( i ) * 2u + 0u ] = std::cos( angle );
+				table[ static_cast< std::size_t >( i ) * 2u + 1u ] = std::sin( angle );
+			}
+
+			return table;
+		}
+
+		[[nodiscard]] static rgba instance_color( std::span<const rgba> colors, std::size_t index ) noexcept
+		{
+			return colors[ colors.size( ) == 1u ? 0u : index ];
+		}
+
+		[[nodiscard]] static std::size_t soa_count( std::initializer_list<std::size_t> sizes, std::size_t color_count ) noexcept
+		{
+			const auto count{ std::min( sizes ) };
+			return color_count == 1u ? count : std::min( count, color_count );
+		}
+
+		static constexpr std::size_t k_instance_chunk{ 1024u };
+
+		[[nodiscard]] static std::uint32_t count_glyph_quads( const font& font, std::string_view text )
+		{
+			auto count{ 0u };
+
+			for ( char c : text )
+			{
+				if ( c < 32 || c > 126 )
+				{
+					continue;
+				}
+
+				const auto& glyph{ font.get_glyph( c ) };
+				if ( glyph.m_valid && glyph.m_quad_x1 - glyph.m_quad_x0 > 0.0f && glyph.m_quad_y1 - glyph.m_quad_y0 > 0.0f )
+				{
+					++count;
+				}
+			}
+
+			return count;
+		}
+
+		[[nodiscard]] static bool run_parallel_job( parallel_batch& batch, std::uint32_t generation )
+		{
+			auto cursor{ batch.m_cursor.load( std::memory_order_acquire ) };
+
+			for ( ;; )
+			{
+				if ( static_cast< std::uint32_t >( cursor >> 32 ) != generation || static_cast< std::uint32_t >( cursor ) >= batch.m_count.load( std::memory_order_relaxed ) )
+				{
+					return false;
+				}
+
+				if ( batch.m_cursor.compare_exchange_weak( cursor, cursor + 1u, std::memory_order_acquire ) )
+				{
+					break;
+				}
+			}
+
+			batch.m_fn( batch.m_context, static_cast< std::uint32_t >( cursor ) );
+			batch.m_completed.fetch_add( 1u, std::memory_order_release );
+			return true;
+		}
+
+		static void run_parallel( parallel_batch& batch, std::uint32_t count, void( *fn )( void* context, std::uint32_t index ), void* context )
+		{
+			const auto generation{ ++batch.m_generation };
+
+			batch.m_fn = fn;
+			batch.m_context = context;
+			batch.m_count.store( count, std::memory_order_relaxed );
+			batch.m_completed.store( 0u, std::memory_order_relaxed );
+			batch.m_cursor.store( static_cast< std::uint64_t >( generation ) << 32, std::memory_order_release );
+
+			const auto helpers{ std::min( count - 1u, k_max_parallel_helpers ) };
+			for ( std::uint32_t i{ 0 }; i < helpers; ++i )
+			{
+				g_render.m_workers.submit( [ &batch, generation ] { while ( run_parallel_job( batch, generation ) ) {} } );
+			}
+
+			while ( run_parallel_job( batch, generation ) ) {}
+
+			while ( batch.m_completed.load( std::memory_order_acquire ) < count )
+			{
+				std::this_thread::yield( );
+			}
+		}
+
+		struct tessellation_chunks
+		{
+			const deferred_prim* m_prims{ nullptr };
+			const std::uint32_t* m_bounds{ nullptr };
+			vertex* m_vertices{ nullptr };
+			std::uint32_t* m_indices{ nullptr };
+			float m_pos_scale{ vertex_traits<vertex>::k_pos_scale };
+		};
+
+		static void tessellate_range( const tessellation_chunks& chunks, std::uint32_t begin, std::uint32_t end )
+		{
+			for ( auto i{ begin }; i < end; ++i )
+			{
+				const auto& prim{ chunks.m_prims[ i ] };
+				prim_writer writer{ chunks.m_vertices + prim.m_vtx_offset, chunks.m_indices + prim.m_idx_offset, prim.m_vtx_offset, prim.m_blend };
+				writer.m_pos_scale = chunks.m_pos_scale;
+				prim.m_emit( prim.m_closure, writer );
+			}
+		}
+
+		static void tessellate_deferred( draw_list& dl )
+		{
+			const auto prim_count{ static_cast< std::uint32_t >( dl.m_deferred_prims.size( ) ) };
+			const auto total_vertices{ static_cast< std::uint32_t >( dl.m_vertices.size( ) ) };
+
+			tessellation_chunks chunks{ dl.m_deferred_prims.data( ), nullptr, dl.m_vertices.data( ), dl.m_indices.data( ), dl.m_pos_scale };
+
+			if ( total_vertices < k_parallel_tessellation_vertices )
+			{
+				tessellate_range( chunks, 0u, prim_count );
+				return;
+			}
+
+			const auto target{ std::max( total_vertices / ( k_max_parallel_helpers + 1u ) / 4u, k_tessellation_chunk_vertices ) };
+
+			frame_vector<std::uint32_t> bounds{};
+			bounds.reserve( total_vertices / target + 2u );
+			bounds.push_back( 0u );
+
+			auto accumulated{ 0u };
+			for ( std::uint32_t i{ 0 }; i < prim_count; ++i )
+			{
+				accumulated += chunks.m_prims[ i ].m_vtx_count;
+
+				if ( accumulated >= target )
+				{
+					bounds.push_back( i + 1u );
+					accumulated = 0u;
+				}
+			}
+
+			if ( bounds[ bounds.size( ) - 1 ] != prim_count )
+			{
+				bounds.push_back( prim_count );
+			}
+
+			chunks.m_bounds = bounds.data( );
+
+			run_parallel( g_render.m_tessellation_batch, static_cast< std::uint32_t >( bounds.size( ) - 1 ), [ ]( void* context, std::uint32_t index )
+				{
+					const auto& chunks{ *static_cast< const tessellation_chunks* >( context ) };
+					tessellate_range( chunks, chunks.m_bounds[ index ], chunks.m_bounds[ index + 1 ] );
+				}, &chunks );
+		}
+
+		static void swap_channel( draw_list& dl, draw_channel& channel ) noexcept
+		{
+			std::swap( dl.m_indices, channel.m_indices );
+			std::swap( dl.m_commands, channel.m_commands );
+			std::swap( dl.m_deferred_prims, channel.m_deferred_prims );
+			std::swap( dl.m_occluders, channel.m_occluders );
+			std::swap( dl.m_region_passes, channel.m_region_passes );
+			std::swap( dl.m_command_barrier, channel.m_command_barrier );
+		}
+
+		static void flush_all_deferred( draw_list& dl )
+		{
+			const auto current{ dl.m_current_channel };
+			for ( std::uint32_t i{ 0 }; i < dl.m_channel_count; ++i )
+			{
+				dl.set_channel( i );
+				dl.flush_deferred( );
+			}
+
+			dl.set_channel( current );
+			dl.flush_deferred( );
+		}
+
+		static void forget_occluders( draw_list& dl, std::uint32_t first_command )
+		{
+			if ( dl.m_channel_count != 0u )
+			{
+				dl.m_occluders.clear( );
+				for ( std::uint32_t i{ 0 }; i < dl.m_channel_count; ++i )
+				{
+					dl.m_channels[ i ].m_occluders.clear( );
+				}
+
+				return;
+			}
+
+			auto keep{ dl.m_occluders.size( ) };
+			while ( keep > 0u && dl.m_occluders.data( )[ keep - 1u ].m_command + 1u >= first_command )
+			{
+				--keep;
+			}
+
+			dl.m_occluders.truncate( keep );
+		}
+
+		static void transform_points( std::byte* base, std::size_t stride, std::size_t count, const mat2x3& m ) noexcept
+		{
+			std::size_t i{ 0 };
+
+#if defined( ZDRAW_SSE2 )
+			const auto col_x{ _mm_setr_ps( m.m_xx, m.m_yx, m.m_xx, m.m_yx ) };
+			const auto col_y{ _mm_setr_ps( m.m_xy, m.m_yy, m.m_xy, m.m_yy ) };
+			const auto offset{ _mm_setr_ps( m.m_tx, m.m_ty, m.m_tx, m.m_ty ) };
+
+			for ( ; i + 2u <= count; i += 2u )
+			{
+				auto* p0{ reinterpret_cast< __m64* >( base + i * stride ) };
+				auto* p1{ reinterpret_cast< __m64* >( base + ( i + 1u ) * stride ) };
+
+				const auto p{ _mm_loadh_pi( _mm_loadl_pi( _mm_setzero_ps( ), p0 ), p1 ) };
+				const auto x{ _mm_shuffle_ps( p, p, _MM_SHUFFLE( 2, 2, 0, 0 ) ) };
+				const auto y{ _mm_shuffle_ps( p, p, _MM_SHUFFLE( 3, 3, 1, 1 ) ) };
+				const auto r{ _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, col_x ), _mm_mul_ps( y, col_y ) ), offset ) };
+
+				_mm_storel_pi( p0, r );
+				_mm_storeh_pi( p1, r );
+			}
+#endif
+
+			for ( ; i < count; ++i )
+			{
+				float p[ 2 ];
+				std::memcpy( p, base + i * stride, sizeof( p ) );
+
+				const float r[ 2 ]{ m.m_xx * p[ 0 ] + m.m_xy * p[ 1 ] + m.m_tx, m.m_yx * p[ 0 ] + m.m_yy * p[ 1 ] + m.m_ty };
+				std::memcpy( base + i * stride, r, sizeof( r ) );
+			}
+		}
+
+		static void modulate_colors( std::byte* base, std::size_t stride, std::size_t count, rgba factor ) noexcept
+		{
+			std::size_t i{ 0 };
+
+#if defined( ZDRAW_SSE2 )
+			const auto zero{ _mm_setzero_si128( ) };
+			const auto mul{ _mm_unpacklo_epi8( _mm_set1_epi32( static_cast< int >( factor.val ) ), zero ) };
+			const auto bias{ _mm_set1_epi16( 128 ) };
+
+			const auto scale{ [ & ]( __m128i c )
+				{
+					const auto v{ _mm_add_epi16( _mm_mullo_epi16( c, mul ), bias ) };
+					return _mm_srli_epi16( _mm_add_epi16( v, _mm_srli_epi16( v, 8 ) ), 8 );
+				} };
+
+			for ( ; i + 4u <= count; i += 4u )
+			{
+				std::uint32_t colors[ 4 ];
+				for ( std::size_t k{ 0 }; k < 4u; ++k )
+				{
+					std::memcpy( &colors[ k ], base + ( i + k ) * stride, sizeof( std::uint32_t ) );
+				}
+
+				const auto packed{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( colors ) ) };
+				const auto result{ _mm_packus_epi16( scale( _mm_unpacklo_epi8( packed, zero ) ), scale( _mm_unpackhi_epi8( packed, zero ) ) ) };
+				_mm_storeu_si128( reinterpret_cast< __m128i* >( colors ), result );
+
+				for ( std::size_t k{ 0 }; k < 4u; ++k )
+				{
+					std::memcpy( base + ( i + k ) * stride, &colors[ k ], sizeof( std::uint32_t ) );
+				}
+			}
+#endif
+
+			const auto scale_channel{ [ ]( std::uint8_t channel, std::uint8_t f )
+				{
+					const auto value{ static_cast< std::uint32_t >( channel ) * f + 128u };
+					return static_cast< std::uint8_t >( ( value + ( value >> 8 ) ) >> 8 );
+				} };
+
+			for ( ; i < count; ++i )
+			{
+				rgba c{};
+				std::memcpy( &c.val, base + i * stride, sizeof( c.val ) );
+				c = rgba{ scale_channel( c.r, factor.r ), scale_channel( c.g, factor.g ), scale_channel( c.b, factor.b ), scale_channel( c.a, factor.a ) };
+				std::memcpy( base + i * stride, &c.val, sizeof( c.val ) );
+			}
+		}
+
+		[[nodiscard]] static bool can_fold_commands( const draw_cmd& a, const draw_cmd& b ) noexcept
+		{
+			return a.m_texture == b.m_texture && a.m_clip == b.m_clip && a.m_kind == b.m_kind && a.m_idx_offset + a.m_idx_count == b.m_idx_offset;
+		}
+
+		[[nodiscard]] static IWICImagingFactory* get_wic_factory( )
+		{
+			static ComPtr<IWICImagingFactory> factory = [ ]
+				{
+					( void )CoInitializeEx( nullptr, COINIT_MULTITHREADED );
+					ComPtr<IWICImagingFactory> f;
+					( void )CoCreateInstance( CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS( &f ) );
+					return f;
+				}( );
+
+			return factory.Get( );
+		}
+
+		[[nodiscard]] static bool read_file( std::string_view filepath, std::vector<std::byte>& buffer )
+		{
+			std::ifstream file{ std::string( filepath ), std::ios::binary | std::ios::ate };
+			if ( !file.is_open( ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const std::streamsize size{ file.tellg( ) };
+			file.seekg( 0, std::ios::beg );
+
+			buffer.resize( static_cast< std::size_t >( size ) );
+			return static_cast< bool >( file.read( reinterpret_cast< char* >( buffer.data( ) ), size ) );
+		}
+
+		static_assert( zimage::k_max_dimension <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION );
+
+		[[nodiscard]] static bool decode_image( std::span<const std::byte> data, zimage::image& image )
+		{
+			if ( zimage::decode( data, image ) )
+			{
+				return true;
+			}
+
+			auto factory{ get_wic_factory( ) };
+			if ( factory == nullptr ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ComPtr<IWICStream> stream;
+			auto hr = factory->CreateStream( &stream );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			hr = stream->InitializeFromMemory( reinterpret_cast< BYTE* >( const_cast< std::byte* >( data.data( ) ) ), static_cast< DWORD >( data.size( ) ) );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ComPtr<IWICBitmapDecoder> decoder;
+			hr = factory->CreateDecoderFromStream( stream.Get( ), nullptr, WICDecodeMetadataCacheOnDemand, &decoder );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ComPtr<IWICBitmapFrameDecode> frame;
+			hr = decoder->GetFrame( 0, &frame );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			UINT width{ 0 }, height{ 0 };
+			hr = frame->GetSize( &width, &height );
+			if ( FAILED( hr ) || width == 0u || height == 0u || width > zimage::k_max_dimension || height > zimage::k_max_dimension ) [[unlikely]]
+			{
+				return false;
+			}
+
+			ComPtr<IWICFormatConverter> converter;
+			hr = factory->CreateFormatConverter( &converter );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			hr = converter->Initialize( frame.Get( ), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			image.m_pixels.resize( static_cast< std::size_t >( width ) * height * 4u );
+			hr = converter->CopyPixels( nullptr, width * 4, static_cast< UINT >( image.m_pixels.size( ) ), image.m_pixels.data( ) );
+			if ( FAILED( hr ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			image.m_width = width;
+			image.m_height = height;
+			return true;
+		}
+
+		[[nodiscard]] static ComPtr<ID3D11Texture2D> create_mipmapped_texture( const zimage::image& image, std::span<const zimage::mip_level> levels, bool immutable )
+		{
+			D3D11_TEXTURE2D_DESC tex_desc{};
+			tex_desc.Width = image.m_width;
+			tex_desc.Height = image.m_height;
+			tex_desc.MipLevels = static_cast< UINT >( levels.size( ) );
+			tex_desc.ArraySize = 1;
+			tex_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			tex_desc.SampleDesc.Count = 1;
+			tex_desc.Usage = immutable ? D3D11_USAGE_IMMUTABLE : D3D11_USAGE_DEFAULT;
+			tex_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+			std::vector<D3D11_SUBRESOURCE_DATA> init_data{};
+			if ( immutable )
+			{
+				init_data.reserve( levels.size( ) );
+				for ( const auto& level : levels )
+				{
+					init_data.push_back( { image.m_pixels.data( ) + level.m_offset, level.m_width * 4u, 0u } );
+				}
+			}
+
+			ComPtr<ID3D11Texture2D> texture;
+			if ( FAILED( g_render.m_device->CreateTexture2D( &tex_desc, immutable ? init_data.data( ) : nullptr, &texture ) ) ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			return texture;
+		}
+
+		[[nodiscard]] static ComPtr<ID3D11ShaderResourceView> create_texture_view( ID3D11Texture2D* texture )
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
+			srv_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			srv_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+			srv_desc.Texture2D.MipLevels = static_cast< UINT >( -1 );
+
+			ComPtr<ID3D11ShaderResourceView> texture_srv;
+			if ( FAILED( g_render.m_device->CreateShaderResourceView( texture, &srv_desc, &texture_srv ) ) ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			return texture_srv;
+		}
+
+		[[nodiscard]] static ComPtr<ID3D11ShaderResourceView> create_texture_from_image( zimage::image& image )
+		{
+			zimage::premultiply_alpha( image.m_pixels.data( ), image.m_pixels.size( ) / 4u );
+			const auto levels{ zimage::generate_mips( image ) };
+
+			auto texture{ create_mipmapped_texture( image, levels, true ) };
+			if ( !texture ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			return create_texture_view( texture.Get( ) );
+		}
+
+		[[nodiscard]] static std::uint64_t hash_bytes( std::span<const std::byte> data ) noexcept
+		{
+			return ankerl::unordered_dense::detail::wyhash::hash( data.data( ), data.size( ) );
+		}
+
+		[[nodiscard]] static texture_cache_key make_texture_cache_key( std::span<const std::byte> data ) noexcept
+		{
+			return { hash_bytes( data ), zhash::hash( data ), data.size( ) };
+		}
+
+		[[nodiscard]] static bool matches_cache_key( const texture_cache_entry& entry, const texture_cache_key& key ) noexcept
+		{
+			return entry.m_size == key.m_size && entry.m_check == key.m_check;
+		}
+
+		[[nodiscard]] static texture_handle find_cached_texture( const texture_cache_key& key )
+		{
+			auto& cache{ g_render.m_texture_cache };
+
+			auto it{ cache.m_entries.find( key.m_hash ) };
+			if ( it == cache.m_entries.end( ) || !matches_cache_key( it->second, key ) )
+			{
+				return nullptr;
+			}
+
+			++cache.m_hits;
+			it->second.m_last_used = ++cache.m_tick;
+			return it->second.m_texture;
+		}
+
+		[[nodiscard]] static texture_handle create_cached_texture( std::span<const std::byte> data )
+		{
+			zimage::image image{};
+			if ( !decode_image( data, image ) ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			auto target{ std::make_shared<texture>( ) };
+			target->m_width = static_cast< int >( image.m_width );
+			target->m_height = static_cast< int >( image.m_height );
+			target->m_srv = create_texture_from_image( image );
+			target->m_bytes = image.m_pixels.size( );
+
+			if ( !target->m_srv ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			target->m_status.store( texture_status::ready, std::memory_order_release );
+			return target;
+		}
+
+		[[nodiscard]] static texture_handle load_cached_texture( std::span<const std::byte> data, std::string path )
+		{
+			auto& cache{ g_render.m_texture_cache };
+			const auto key{ make_texture_cache_key( data ) };
+
+			{
+				std::scoped_lock lock{ cache.m_mutex };
+
+				if ( auto cached{ find_cached_texture( key ) } )
+				{
+					if ( !path.empty( ) )
+					{
+						cache.m_paths[ std::move( path ) ] = key;
+					}
+
+					return cached;
+				}
+
+				++cache.m_misses;
+			}
+
+			auto created{ create_cached_texture( data ) };
+			if ( !created ) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			std::scoped_lock lock{ cache.m_mutex };
+
+			auto [it, inserted] { cache.m_entries.try_emplace( key.m_hash ) };
+			if ( inserted )
+			{
+				it->second = { created, ++cache.m_tick, key.m_check, key.m_size };
+				cache.m_bytes += created->m_bytes;
+			}
+			else if ( !matches_cache_key( it->second, key ) ) [[unlikely]]
+			{
+				return created;
+			}
+
+			if ( !path.empty( ) )
+			{
+				cache.m_paths[ std::move( path ) ] = key;
+			}
+
+			return it->second.m_texture;
+		}
+
+		static void erase_cached_texture( std::uint64_t key )
+		{
+			auto& cache{ g_render.m_texture_cache };
+
+			auto it{ cache.m_entries.find( key ) };
+			if ( it == cache.m_entries.end( ) )
+			{
+				return;
+			}
+
+			cache.m_bytes -= it->second.m_texture->m_bytes;
+			cache.m_entries.erase( it );
+		}
+
+		static void finish_texture( const texture_handle& target, texture_status status )
+		{
+			target->m_status.store( status, std::memory_order_release );
+			g_render.m_texture_uploads.m_in_flight.fetch_sub( 1u, std::memory_order_relaxed );
+		}
+
+		static void queue_texture_decode( texture_handle target, std::vector<std::byte> encoded, std::string filepath )
+		{
+			g_render.m_texture_uploads.m_in_flight.fetch_add( 1u, std::memory_order_relaxed );
+
+			g_render.m_workers.submit( [ target = std::move( target ), encoded = std::move( encoded ), filepath = std::move( filepath ) ]( ) mutable
+				{
+					if ( target.use_count( ) == 1 )
+					{
+						finish_texture( target, texture_status::failed );
+						return;
+					}
+
+					try
+					{
+						if ( !filepath.empty( ) && !read_file( filepath, encoded ) )
+						{
+							finish_texture( target, texture_status::failed );
+							return;
+						}
+
+						texture_upload upload{};
+						if ( !decode_image( encoded, upload.m_image ) || upload.m_image.m_width == 0u || upload.m_image.m_height == 0u )
+						{
+							finish_texture( target, texture_status::failed );
+							return;
+						}
+
+						zimage::premultiply_alpha( upload.m_image.m_pixels.data( ), upload.m_image.m_pixels.size( ) / 4u );
+						upload.m_levels = zimage::generate_mips( upload.m_image );
+						upload.m_target = target;
+						upload.m_target->m_bytes = upload.m_image.m_pixels.size( );
+
+						std::scoped_lock lock{ g_render.m_texture_uploads.m_mutex };
+						g_render.m_texture_uploads.m_decoded.push_back( std::move( upload ) );
+					}
+					catch ( ... )
+					{
+						finish_texture( target, texture_status::failed );
+					}
+				} );
+		}
+
+		static void process_texture_uploads( )
+		{
+			auto& uploads{ g_render.m_texture_uploads };
+
+			{
+				std::scoped_lock lock{ uploads.m_mutex };
+
+				for ( auto& upload : uploads.m_decoded )
+				{
+					uploads.m_pending.push_back( std::move( upload ) );
+				}
+
+				uploads.m_decoded.clear( );
+			}
+
+			if ( uploads.m_pending.empty( ) )
+			{
+				return;
+			}
+
+			LARGE_INTEGER start_time{};
+			QueryPerformanceCounter( &start_time );
+
+			const auto max_bytes{ uploads.m_max_bytes_per_frame.load( std::memory_order_relaxed ) };
+			const auto max_ticks{ static_cast< LONGLONG >( uploads.m_max_milliseconds_per_frame.load( std::memory_order_relaxed ) * 0.001f * static_cast< float >( g_render.m_performance_frequency.QuadPart ) ) };
+			std::uint32_t uploaded_bytes{ 0 };
+
+			while ( !uploads.m_pending.empty( ) )
+			{
+				auto& upload{ uploads.m_pending.front( ) };
+
+				if ( upload.m_target.use_count( ) == 1 )
+				{
+					finish_texture( upload.m_target, texture_status::failed );
+					uploads.m_pending.pop_front( );
+					continue;
+				}
+
+				if ( !upload.m_texture )
+				{
+					upload.m_texture = create_mipmapped_texture( upload.m_image, upload.m_levels, false );
+					if ( !upload.m_texture ) [[unlikely]]
+					{
+						finish_texture( upload.m_target, texture_status::failed );
+						uploads.m_pending.pop_front( );
+						continue;
+					}
+				}
+
+				const auto& level{ upload.m_levels[ upload.m_level ] };
+				const auto row_pitch{ level.m_width * 4u };
+				const auto remaining_bytes{ max_bytes > uploaded_bytes ? max_bytes - uploaded_bytes : 0u };
+				const auto rows{ std::clamp( remaining_bytes / row_pitch, 1u, level.m_height - upload.m_next_row ) };
+
+				const D3D11_BOX box{ 0u, upload.m_next_row, 0u, level.m_width, upload.m_next_row + rows, 1u };
+				g_render.m_context->UpdateSubresource( upload.m_texture.Get( ), upload.m_level, &box, upload.m_image.m_pixels.data( ) + level.m_offset + static_cast< std::size_t >( upload.m_next_row ) * row_pitch, row_pitch, 0 );
+
+				upload.m_next_row += rows;
+				uploaded_bytes += rows * row_pitch;
+
+				if ( upload.m_next_row == level.m_height )
+				{
+					upload.m_next_row = 0u;
+					++upload.m_level;
+				}
+
+				if ( upload.m_level == upload.m_levels.size( ) )
+				{
+					auto texture_srv{ create_texture_view( upload.m_texture.Get( ) ) };
+
+					upload.m_target->m_srv = std::move( texture_srv );
+					upload.m_target->m_width = static_cast< int >( upload.m_image.m_width );
+					upload.m_target->m_height = static_cast< int >( upload.m_image.m_height );
+					finish_texture( upload.m_target, upload.m_target->m_srv ? texture_status::ready : texture_status::failed );
+					uploads.m_pending.pop_front( );
+				}
+
+				LARGE_INTEGER current_time{};
+				QueryPerformanceCounter( &current_time );
+
+				if ( uploaded_bytes >= max_bytes || current_time.QuadPart - start_time.QuadPart >= max_ticks )
+				{
+					break;
+				}
+			}
+		}
+
+		[[nodiscard]] static std::uint32_t dynamic_texture_bytes_per_pixel( DXGI_FORMAT format ) noexcept
+		{
+			switch ( format )
+			{
+			case DXGI_FORMAT_R8G8B8A8_UNORM:
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+			case DXGI_FORMAT_B8G8R8A8_UNORM:
+			case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+				return 4u;
+			case DXGI_FORMAT_R8_UNORM:
+			case DXGI_FORMAT_A8_UNORM:
+				return 1u;
+			default:
+				return 0u;
+			}
+		}
+
+		[[nodiscard]] static bool create_dynamic_resources( dynamic_texture& dyn, std::uint32_t width, std::uint32_t height, DXGI_FORMAT format )
+		{
+			D3D11_TEXTURE2D_DESC tex_desc{};
+			tex_desc.Width = width;
+			tex_desc.Height = height;
+			tex_desc.MipLevels = 1;
+			tex_desc.ArraySize = 1;
+			tex_desc.Format = format;
+			tex_desc.SampleDesc.Count = 1;
+			tex_desc.Usage = D3D11_USAGE_DEFAULT;
+			tex_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+			const D3D11_SUBRESOURCE_DATA init_data{ dyn.m_shadow.data( ), width * dyn.m_bytes_per_pixel, 0u };
+
+			D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
+			srv_desc.Format = format;
+			srv_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+			srv_desc.Texture2D.MipLevels = 1;
+
+			for ( std::uint32_t i{ 0 }; i < dyn.m_buffer_count; ++i )
+			{
+				if ( FAILED( g_render.m_device->CreateTexture2D( &tex_desc, &init_data, &dyn.m_textures[ i ] ) ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				if ( FAILED( g_render.m_device->CreateShaderResourceView( dyn.m_textures[ i ].Get( ), &srv_desc, &dyn.m_views[ i ] ) ) ) [[unlikely]]
+				{
+					return false;
+				}
+			}
+
+			tex_desc.Usage = D3D11_USAGE_STAGING;
+			tex_desc.BindFlags = 0;
+			tex_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+			for ( auto& staging : dyn.m_staging )
+			{
+				if ( FAILED( g_render.m_device->CreateTexture2D( &tex_desc, nullptr, &staging ) ) ) [[unlikely]]
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		static void add_dirty_rect( std::vector<D3D11_RECT>& rects, const D3D11_RECT& rect )
+		{
+			for ( const auto& dirty : rects )
+			{
+				if ( rect.left >= dirty.left && rect.top >= dirty.top && rect.right <= dirty.right && rect.bottom <= dirty.bottom )
+				{
+					return;
+				}
+			}
+
+			if ( rects.size( ) < dynamic_texture::k_max_dirty_rects )
+			{
+				rects.push_back( rect );
+				return;
+			}
+
+			auto bounds{ rect };
+			for ( const auto& dirty : rects )
+			{
+				bounds.left = std::min( bounds.left, dirty.left );
+				bounds.top = std::min( bounds.top, dirty.top );
+				bounds.right = std::max( bounds.right, dirty.right );
+				bounds.bottom = std::max( bounds.bottom, dirty.bottom );
+			}
+
+			rects.assign( 1u, bounds );
+		}
+
+		[[nodiscard]] static bool flush_dynamic_texture( dynamic_texture& dyn )
+		{
+			auto* context{ g_render.m_context.Get( ) };
+			auto* staging{ dyn.m_staging[ dyn.m_next_staging ].Get( ) };
+
+			// @note: each buffer collects every rect written since it was last the back buffer, so a rotation only uploads what that buffer missed
+			const auto back{ dyn.m_buffer_count > 1u ? ( dyn.m_front + 1u ) % dyn.m_buffer_count : dyn.m_front };
+			auto missed{ dyn.m_stale[ back ] };
+			for ( const auto& rect : dyn.m_dirty )
+			{
+				add_dirty_rect( missed, rect );
+			}
+
+			D3D11_MAPPED_SUBRESOURCE mapped{};
+			if ( FAILED( context->Map( staging, 0, D3D11_MAP_WRITE, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped ) ) )
+			{
+				return false;
+			}
+
+			const auto shadow_pitch{ static_cast< std::size_t >( dyn.m_target->m_width ) * dyn.m_bytes_per_pixel };
+			for ( const auto& rect : missed )
+			{
+				const auto row_bytes{ static_cast< std::size_t >( rect.right - rect.left ) * dyn.m_bytes_per_pixel };
+				const auto column{ static_cast< std::size_t >( rect.left ) * dyn.m_bytes_per_pixel };
+
+				for ( auto y{ rect.top }; y < rect.bottom; ++y )
+				{
+					std::memcpy( static_cast< std::uint8_t* >( mapped.pData ) + static_cast< std::size_t >( y ) * mapped.RowPitch + column, dyn.m_shadow.data( ) + static_cast< std::size_t >( y ) * shadow_pitch + column, row_bytes );
+				}
+			}
+
+			context->Unmap( staging, 0 );
+
+			for ( const auto& rect : missed )
+			{
+				const D3D11_BOX box{ static_cast< UINT >( rect.left ), static_cast< UINT >( rect.top ), 0u, static_cast< UINT >( rect.right ), static_cast< UINT >( rect.bottom ), 1u };
+				context->CopySubresourceRegion( dyn.m_textures[ back ].Get( ), 0, box.left, box.top, 0, staging, 0, &box );
+			}
+
+			for ( std::uint32_t i{ 0 }; i < dyn.m_buffer_count; ++i )
+			{
+				if ( i == back )
+				{
+					dyn.m_stale[ i ].clear( );
+					continue;
+				}
+
+				for ( const auto& rect : dyn.m_dirty )
+				{
+					add_dirty_rect( dyn.m_stale[ i ], rect );
+				}
+			}
+
+			dyn.m_front = back;
+			dyn.m_target->m_view.store( dyn.m_views[ back ].Get( ), std::memory_order_release );
+			dyn.m_dirty.clear( );
+			dyn.m_next_staging = ( dyn.m_next_staging + 1u ) % dynamic_texture::k_staging_ring;
+			return true;
+		}
+
+		static void bump_texture_generation( const ID3D11ShaderResourceView* view )
+		{
+			auto& generations{ g_render.m_texture_generations };
+			std::scoped_lock lock{ generations.m_mutex };
+
+			++generations.m_values[ view ];
+		}
+
+		static void forget_texture_generations( const dynamic_texture& dyn )
+		{
+			auto& generations{ g_render.m_texture_generations };
+			std::scoped_lock lock{ generations.m_mutex };
+
+			for ( const auto& view : dyn.m_views )
+			{
+				generations.m_values.erase( view.Get( ) );
+			}
+		}
+
+		static void process_dynamic_textures( )
+		{
+			auto& store{ g_render.m_dynamic_textures };
+			std::scoped_lock lock{ store.m_mutex };
+
+			for ( auto it{ store.m_textures.begin( ) }; it != store.m_textures.end( ); )
+			{
+				auto& dyn{ it->second };
+
+				if ( dyn.m_target.use_count( ) == 1 )
+				{
+					if ( ++dyn.m_released_frames > render_data::k_frame_slots )
+					{
+						forget_texture_generations( dyn );
+						it = store.m_textures.erase( it );
+						continue;
+					}
+				}
+				else if ( !dyn.m_dirty.empty( ) && flush_dynamic_texture( dyn ) )
+				{
+					bump_texture_generation( dyn.m_views[ dyn.m_front ].Get( ) );
+				}
+
+				++it;
+			}
+		}
+
+		static void refresh_display_size( )
+		{
+			D3D11_VIEWPORT viewport{};
+			UINT num_viewports{ 1u };
+			g_render.m_context->RSGetViewports( &num_viewports, &viewport );
+
+			const auto valid{ num_viewports > 0 && viewport.Width > 0.0f && viewport.Height > 0.0f };
+			g_render.m_display_width.store( valid ? static_cast< int >( std::lround( viewport.Width ) ) : 0, std::memory_order_relaxed );
+			g_render.m_display_height.store( valid ? static_cast< int >( std::lround( viewport.Height ) ) : 0, std::memory_order_relaxed );
+		}
+
+		static void prepare_submit( )
+		{
+			auto& d{ g_render };
+
+			d.m_frame_vertex_count = 0u;
+			d.m_frame_index_count = 0u;
+
+			process_texture_uploads( );
+			process_dynamic_textures( );
+			refresh_display_size( );
+		}
+
+		[[nodiscard]] static bool acquire_build_slot( )
+		{
+			auto& d{ g_render };
+			std::unique_lock lock{ d.m_frame_mutex };
+
+			auto& slot{ d.m_frames[ d.m_next_build_slot ] };
+			d.m_frame_cv.wait( lock, [ & ] { return d.m_frames_stopped || slot.m_state == frame_slot_state::free; } );
+
+			if ( d.m_frames_stopped )
+			{
+				return false;
+			}
+
+			slot.m_state = frame_slot_state::building;
+			d.m_build_slot = d.m_next_build_slot;
+			d.m_next_build_slot = ( d.m_next_build_slot + 1u ) % render_data::k_frame_slots;
+			return true;
+		}
+
+		static void publish_build_slot( )
+		{
+			auto& d{ g_render };
+
+			{
+				std::scoped_lock lock{ d.m_frame_mutex };
+				d.m_frames[ d.m_build_slot ].m_state = frame_slot_state::ready;
+			}
+
+			d.m_frame_cv.notify_all( );
+		}
+
+		[[nodiscard]] static frame_slot* acquire_submit_slot( )
+		{
+			auto& d{ g_render };
+			std::unique_lock lock{ d.m_frame_mutex };
+
+			auto& slot{ d.m_frames[ d.m_next_submit_slot ] };
+			d.m_frame_cv.wait( lock, [ & ] { return d.m_frames_stopped || slot.m_state == frame_slot_state::ready; } );
+
+			if ( slot.m_state != frame_slot_state::ready )
+			{
+				return nullptr;
+			}
+
+			slot.m_state = frame_slot_state::submitting;
+			d.m_next_submit_slot = ( d.m_next_submit_slot + 1u ) % render_data::k_frame_slots;
+			return &slot;
+		}
+
+		static void release_submit_slot( frame_slot& slot )
+		{
+			{
+				std::scoped_lock lock{ g_render.m_frame_mutex };
+				slot.m_state = frame_slot_state::free;
+			}
+
+			g_render.m_frame_cv.notify_all( );
+		}
+
+		struct layer_submission
+		{
+			const draw_list* m_list{ nullptr };
+			std::span<const command_visibility> m_visibility{};
+			ID3D11DeviceContext* m_context{ nullptr };
+			ComPtr<ID3D11CommandList> m_command_list{};
+			bool m_encoded{ false };
+		};
+
+		struct frame_submission
+		{
+			const submit_target* m_target{ nullptr };
+			layer_submission m_layers[ 3 ]{};
+		};
+
+		// @note: every state change and draw goes through the context argument, so the immediate and deferred paths share this encoder; bench/submit.cpp renders both and compares the pixels
+		[[nodiscard]] static bool encode_draw_list( ID3D11DeviceContext* context, const draw_list& dl, std::span<const command_visibility> visibility, const submit_target& target )
+		{
+			auto& d{ g_render };
+
+			if ( dl.m_sdf_vertices.size( ) > 0 && !d.m_sdf_vertex_buffer.upload( context, dl.m_sdf_vertices.data( ), static_cast< std::uint32_t >( dl.m_sdf_vertices.size( ) * sizeof( sdf_vertex ) ) ) )
+			{
+				return false;
+			}
+
+			if ( !d.m_vertex_buffer.upload( context, dl.m_vertices.data( ), static_cast< std::uint32_t >( dl.m_vertices.size( ) * sizeof( vertex ) ) ) ||
+				!d.m_index_buffer.upload( context, dl.m_indices.data( ), static_cast< std::uint32_t >( dl.m_indices.size( ) * sizeof( std::uint32_t ) ) ) )
+			{
+				return false;
+			}
+
+			setup_projection_matrix( context, 0.0f, 0.0f, target.m_width, target.m_height, dl.m_pos_scale );
+			setup_render_state( context );
+
+			if ( dl.m_region_passes.size( ) > 0 )
+			{
+				render_cached_regions( context, dl, target );
+			}
+
+			render_state_cache state_cache{};
+			context->RSSetScissorRects( 1, &target.m_viewport_rect );
+			state_cache.set_scissor( target.m_viewport_rect );
+
+			auto bound_kind{ draw_kind::geometry };
+
+			const auto passes{ dl.m_region_passes.span( ) };
+			std::size_t next_pass{ 0 };
+
+			for ( std::size_t i{ 0 }; i < dl.m_commands.size( ); ++i )
+			{
+				if ( next_pass < passes.size( ) && i == passes[ next_pass ].m_first_command )
+				{
+					i = passes[ next_pass++ ].m_end_command - 1u;
+					continue;
+				}
+
+				const auto& cmd{ dl.m_commands.data( )[ i ] };
+				if ( cmd.m_idx_count == 0u || ( !visibility.empty( ) && visibility[ i ].m_count == 0 ) )
+				{
+					continue;
+				}
+
+				if ( cmd.m_kind != bound_kind )
+				{
+					bind_pipeline( context, cmd.m_kind );
+					bound_kind = cmd.m_kind;
+				}
+
+				D3D11_RECT scissor{ target.m_viewport_rect };
+				if ( cmd.has_clip( ) )
+				{
+					scissor = intersect_rect( scissor, dl.clip_rect_of( cmd ) );
+					if ( scissor.right <= scissor.left || scissor.bottom <= scissor.top )
+					{
+						continue;
+					}
+				}
+
+				std::span<const D3D11_RECT> scissors{ &scissor, 1u };
+				if ( !visibility.empty( ) && visibility[ i ].m_count > 0 )
+				{
+					scissors = std::span<const D3D11_RECT>{ visibility[ i ].m_rects, static_cast< std::size_t >( visibility[ i ].m_count ) };
+				}
+
+				const auto texture{ dl.texture_of( cmd ) };
+				if ( state_cache.needs_texture_bind( texture ) )
+				{
+					context->PSSetShaderResources( 0, 1, &texture );
+					state_cache.set_texture( texture );
+				}
+
+				for ( const auto& rect : scissors )
+				{
+					if ( state_cache.needs_scissor( rect ) )
+					{
+						context->RSSetScissorRects( 1, &rect );
+						state_cache.set_scissor( rect );
+					}
+
+					context->DrawIndexed( cmd.m_idx_count, cmd.m_idx_offset, 0 );
+				}
+			}
+
+			return true;
+		}
+
+		static void record_layer( void* context, std::uint32_t index )
+		{
+			auto& submission{ *static_cast< frame_submission* >( context ) };
+			auto& layer{ submission.m_layers[ index ] };
+			const auto& target{ *submission.m_target };
+
+			layer.m_context->OMSetRenderTargets( 1, target.m_rtv.GetAddressOf( ), target.m_dsv.Get( ) );
+			layer.m_context->RSSetViewports( static_cast< UINT >( target.m_viewports.size( ) ), target.m_viewports.data( ) );
+			layer.m_encoded = encode_draw_list( layer.m_context, *layer.m_list, layer.m_visibility, target );
+
+			if ( FAILED( layer.m_context->FinishCommandList( FALSE, &layer.m_command_list ) ) ) [[unlikely]]
+			{
+				layer.m_encoded = false;
+			}
+		}
+
+		// @note: get_occlusion_stats may run on another thread while the submit thread culls, so stats are gathered locally and published whole
+		static void publish_occlusion_stats( const occlusion_stats& stats )
+		{
+			std::scoped_lock lock{ g_render.m_frame_mutex };
+			g_render.m_occlusion_stats = stats;
+		}
+
+		[[nodiscard]] static bool ensure_recording_contexts( )
+		{
+			auto& d{ g_render };
+
+			for ( auto& context : d.m_recording_contexts )
+			{
+				if ( !context && FAILED( d.m_device->CreateDeferredContext( 0, &context ) ) ) [[unlikely]]
+				{
+					d.m_deferred_contexts.store( false, std::memory_order_relaxed );
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		[[nodiscard]] static frame_status submit_draw_lists( frame_slot& slot )
+		{
+			auto& d{ g_render };
+			t_frame_arena = &slot.m_frame_arena;
+
+			D3D11_VIEWPORT viewport{};
+			UINT num_viewports{ 1u };
+			d.m_context->RSGetViewports( &num_viewports, &viewport );
+
+			submit_target target{};
+			d.m_context->OMGetRenderTargets( 1, &target.m_rtv, &target.m_dsv );
+			target.m_viewports = std::span<const D3D11_VIEWPORT>{ &viewport, num_viewports };
+			target.m_width = num_viewports > 0 ? viewport.Width : static_cast< float >( GetSystemMetrics( SM_CXSCREEN ) );
+			target.m_height = num_viewports > 0 ? viewport.Height : static_cast< float >( GetSystemMetrics( SM_CYSCREEN ) );
+			target.m_viewport_rect = D3D11_RECT{ 0, 0, static_cast< LONG >( std::ceil( target.m_width ) ), static_cast< LONG >( std::ceil( target.m_height ) ) };
+
+			d.m_frame_vertex_count = 0u;
+			d.m_frame_index_count = 0u;
+
+			if ( d.m_skip_unchanged_frames.load( std::memory_order_relaxed ) )
+			{
+				const auto hash{ hash_frame( slot.m_draw_lists, target.m_viewport_rect ) };
+				const auto unchanged{ !slot.m_invalidated && d.m_frame_hash_valid && hash == d.m_frame_hash };
+
+				d.m_frame_hash = hash;
+				d.m_frame_hash_valid = true;
+
+				if ( unchanged )
+				{
+					publish_occlusion_stats( occlusion_stats{} );
+					return frame_status::unchanged;
+				}
+			}
+
+			frame_submission submission{ &target };
+			std::uint32_t layer_count{ 0 };
+			occlusion_stats stats{};
+
+			for ( const auto& dl : slot.m_draw_lists )
+			{
+				if ( ( dl.m_vertices.size( ) == 0 && dl.m_sdf_vertices.size( ) == 0 ) || dl.m_commands.size( ) == 0 )
+				{
+					continue;
+				}
+
+				ensure_buffer_capacity( dl );
+
+				auto& layer{ submission.m_layers[ layer_count++ ] };
+				layer.m_list = &dl;
+				layer.m_visibility = d.m_occlusion_culling.load( std::memory_order_relaxed ) ? cull_occluded( dl, target.m_viewport_rect, stats ) : std::span<command_visibility>{};
+			}
+
+			publish_occlusion_stats( stats );
+
+			const auto layers{ std::span{ submission.m_layers, layer_count } };
+
+			if ( d.m_deferred_contexts.load( std::memory_order_relaxed ) && layer_count > 1u && ensure_recording_contexts( ) )
+			{
+				for ( std::uint32_t i{ 0 }; i < layer_count; ++i )
+				{
+					layers[ i ].m_context = d.m_recording_contexts[ i ].Get( );
+				}
+
+				run_parallel( d.m_submit_batch, layer_count, record_layer, &submission );
+
+				for ( const auto& layer : layers )
+				{
+					if ( layer.m_encoded )
+					{
+						d.m_context->ExecuteCommandList( layer.m_command_list.Get( ), TRUE );
+					}
+				}
+			}
+			else
+			{
+				for ( auto& layer : layers )
+				{
+					layer.m_encoded = encode_draw_list( d.m_context.Get( ), *layer.m_list, layer.m_visibility, target );
+				}
+			}
 
-		if ( length < 0.0001f ) [[unlikely]]
-		{
-			return;
+			for ( const auto& layer : layers )
+			{
+				if ( layer.m_encoded )
+				{
+					d.m_frame_vertex_count += static_cast< std::uint32_t >( layer.m_list->m_vertices.size( ) + layer.m_list->m_sdf_vertices.size( ) );
+					d.m_frame_index_count += static_cast< std::uint32_t >( layer.m_list->m_indices.size( ) );
+				}
+			}
+
+			return frame_status::rendered;
 		}
 
-		const auto norm_dx{ dx / length };
-		const auto norm_dy{ dy / length };
+	} // namespace detail
 
-		const auto perp_x{ -norm_dy };
-		const auto perp_y{ norm_dx };
+	void* frame_arena::allocate( std::size_t size, std::size_t alignment )
+	{
+		const auto offset{ this->m_buffer.size( ) };
+		const auto padding{ ( alignment - offset % alignment ) % alignment };
 
-		const auto half_thickness{ std::max( 0.0f, thickness ) * 0.5f };
-		constexpr auto aa_fringe{ 1.0f };
-		constexpr auto aa_half{ aa_fringe * 0.5f };
+		return this->m_buffer.allocate( padding + std::max<std::size_t>( size, 1u ) ) + padding;
+	}
 
-		const auto core_offset{ half_thickness - aa_half };
-		const auto core_tx{ perp_x * core_offset };
-		const auto core_ty{ perp_y * core_offset };
+	void* frame_arena::reallocate( void* block, std::size_t old_size, std::size_t new_size, std::size_t alignment )
+	{
+		if ( block != nullptr && static_cast< std::byte* >( block ) + old_size == this->m_buffer.data( ) + this->m_buffer.size( ) )
+		{
+			if ( new_size > old_size )
+			{
+				( void )this->m_buffer.allocate( new_size - old_size );
+			}
 
-		const auto outer_offset{ half_thickness + aa_half };
-		const auto outer_tx{ perp_x * outer_offset };
-		const auto outer_ty{ perp_y * outer_offset };
+			return block;
+		}
 
-		auto transparent_color{ color };
-		transparent_color.a = 0;
+		auto result{ this->allocate( new_size, alignment ) };
+		if ( block != nullptr && old_size != 0u )
+		{
+			std::memcpy( result, block, std::min( old_size, new_size ) );
+		}
 
-		this->push_vertex( x0 + core_tx, y0 + core_ty, 0.0f, 0.0f, color );
-		this->push_vertex( x1 + core_tx, y1 + core_ty, 1.0f, 0.0f, color );
-		this->push_vertex( x1 - core_tx, y1 - core_ty, 1.0f, 1.0f, color );
-		this->push_vertex( x0 - core_tx, y0 - core_ty, 0.0f, 1.0f, color );
+		return result;
+	}
 
-		this->push_vertex( x0 + outer_tx, y0 + outer_ty, 0.0f, 0.0f, transparent_color );
-		this->push_vertex( x1 + outer_tx, y1 + outer_ty, 1.0f, 0.0f, transparent_color );
-		this->push_vertex( x1 - outer_tx, y1 - outer_ty, 1.0f, 1.0f, transparent_color );
-		this->push_vertex( x0 - outer_tx, y0 - outer_ty, 0.0f, 1.0f, transparent_color );
+	std::string_view frame_arena::copy( std::string_view text )
+	{
+		if ( text.empty( ) )
+		{
+			return {};
+		}
 
-		auto idx{ this->m_indices.allocate( 18 ) };
-		idx[ 0 ] = vtx_base + 0; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base + 0; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
-		idx[ 6 ] = vtx_base + 0; idx[ 7 ] = vtx_base + 4; idx[ 8 ] = vtx_base + 5;
-		idx[ 9 ] = vtx_base + 0; idx[ 10 ] = vtx_base + 5; idx[ 11 ] = vtx_base + 1;
-		idx[ 12 ] = vtx_base + 2; idx[ 13 ] = vtx_base + 6; idx[ 14 ] = vtx_base + 7;
-		idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 7; idx[ 17 ] = vtx_base + 3;
+		auto storage{ static_cast< char* >( this->allocate( text.size( ), 1u ) ) };
+		std::memcpy( storage, text.data( ), text.size( ) );
+		return { storage, text.size( ) };
+	}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 18u;
+	void frame_arena::reset( ) noexcept
+	{
+		this->m_buffer.clear( );
+		this->m_buffer.trim( );
 	}
 
-	void draw_list::add_rect( float x, float y, float w, float h, rgba color, float thickness )
+	frame_string& frame_string::append( std::string_view text )
 	{
-		if ( w <= 0.0f || h <= 0.0f )
+		if ( this->m_size + text.size( ) > this->m_capacity )
 		{
-			return;
+			const auto capacity{ std::max( { std::size_t{ 32 }, this->m_capacity * 2u, this->m_size + text.size( ) } ) };
+			this->m_data = static_cast< char* >( get_frame_arena( ).reallocate( this->m_data, this->m_capacity, capacity, 1u ) );
+			this->m_capacity = capacity;
 		}
 
-		this->ensure_draw_cmd( nullptr );
+		std::memcpy( this->m_data + this->m_size, text.data( ), text.size( ) );
+		this->m_size += text.size( );
+		return *this;
+	}
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-		const auto max_th{ 0.5f * std::min( w, h ) };
+	void draw_list::push_clip_rect( float x0, float y0, float x1, float y1 )
+	{
+		D3D11_RECT r{};
+		r.left = static_cast< LONG >( std::floor( x0 ) );
+		r.top = static_cast< LONG >( std::floor( y0 ) );
+		r.right = static_cast< LONG >( std::ceil( x1 ) );
+		r.bottom = static_cast< LONG >( std::ceil( y1 ) );
 
-		thickness = std::clamp( thickness, 0.0f, max_th );
-		if ( thickness <= 0.0f )
+		if ( !this->m_clip_stack.empty( ) )
 		{
-			return;
+			const auto& parent = this->m_clip_rects.data( )[ this->m_clip_stack.back( ) ];
+			r.left = std::max( r.left, parent.left );
+			r.top = std::max( r.top, parent.top );
+			r.right = std::min( r.right, parent.right );
+			r.bottom = std::min( r.bottom, parent.bottom );
 		}
 
-		const auto inner_x{ x + thickness };
-		const auto inner_y{ y + thickness };
-		const auto inner_w{ std::max( 0.0f, w - thickness * 2.0f ) };
-		const auto inner_h{ std::max( 0.0f, h - thickness * 2.0f ) };
+		this->m_clip_stack.push_back( this->intern_clip_rect( r ) );
+	}
 
-		this->push_vertex( x, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + h, 0.0f, 0.0f, color );
+	void draw_list::pop_clip_rect( )
+	{
+		if ( !this->m_clip_stack.empty( ) )
+		{
+			this->m_clip_stack.pop_back( );
+		}
+	}
 
-		this->push_vertex( inner_x, inner_y, 0.0f, 0.0f, color );
-		this->push_vertex( inner_x + inner_w, inner_y, 0.0f, 0.0f, color );
-		this->push_vertex( inner_x + inner_w, inner_y + inner_h, 0.0f, 0.0f, color );
-		this->push_vertex( inner_x, inner_y + inner_h, 0.0f, 0.0f, color );
+	void draw_list::push_blend( blend mode )
+	{
+		this->m_blend_stack.push_back( this->m_blend );
+		this->m_blend = mode;
+	}
 
-		auto idx{ this->m_indices.allocate( 24 ) };
-		idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 5;
-		idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 5; idx[ 5 ] = vtx_base + 4;
-		idx[ 6 ] = vtx_base + 1; idx[ 7 ] = vtx_base + 2; idx[ 8 ] = vtx_base + 6;
-		idx[ 9 ] = vtx_base + 1; idx[ 10 ] = vtx_base + 6; idx[ 11 ] = vtx_base + 5;
-		idx[ 12 ] = vtx_base + 2; idx[ 13 ] = vtx_base + 3; idx[ 14 ] = vtx_base + 7;
-		idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 7; idx[ 17 ] = vtx_base + 6;
-		idx[ 18 ] = vtx_base + 3; idx[ 19 ] = vtx_base; idx[ 20 ] = vtx_base + 4;
-		idx[ 21 ] = vtx_base + 3; idx[ 22 ] = vtx_base + 4; idx[ 23 ] = vtx_base + 7;
+	void draw_list::pop_blend( )
+	{
+		if ( !this->m_blend_stack.empty( ) )
+		{
+			this->m_blend = this->m_blend_stack.back( );
+			this->m_blend_stack.pop_back( );
+		}
+	}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 24u;
+	mat2x3 mat2x3::rotation( float radians, float cx, float cy ) noexcept
+	{
+		const auto c{ std::cos( radians ) };
+		const auto s{ std::sin( radians ) };
+		return mat2x3{ c, -s, cx - c * cx + s * cy, s, c, cy - s * cx - c * cy };
 	}
 
-	void draw_list::add_rect_cornered( float x, float y, float w, float h, rgba color, float corner_length, float thickness )
+	void draw_list::push_transform( const mat2x3& transform )
 	{
-		this->ensure_draw_cmd( nullptr );
+		this->m_transform_stack.push_back( pending_transform{ this->mark( ), transform } );
+	}
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-		const auto max_corner{ std::min( w, h ) * 0.5f };
-		const auto actual_corner_length{ std::min( corner_length, max_corner ) };
-		const auto max_th{ 0.5f * std::min( w, h ) };
+	void draw_list::pop_transform( )
+	{
+		if ( this->m_transform_stack.empty( ) )
+		{
+			return;
+		}
 
-		thickness = std::clamp( thickness, 0.0f, max_th );
-		if ( thickness <= 0.0f )
+		const auto entry{ this->m_transform_stack.back( ) };
+		this->m_transform_stack.pop_back( );
+		this->transform_range( entry.m_begin, this->mark( ), entry.m_transform );
+	}
+
+	void draw_list::transform_range( const vertex_mark& begin, const vertex_mark& end, const mat2x3& transform )
+	{
+		const auto vtx_end{ std::min( end.m_vertex, static_cast< std::uint32_t >( this->m_vertices.size( ) ) ) };
+		const auto sdf_end{ std::min( end.m_sdf_vertex, static_cast< std::uint32_t >( this->m_sdf_vertices.size( ) ) ) };
+
+		if ( begin.m_vertex >= vtx_end && begin.m_sdf_vertex >= sdf_end )
 		{
 			return;
 		}
 
-		this->push_vertex( x, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + actual_corner_length, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + actual_corner_length, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + thickness, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + thickness, y + actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + actual_corner_length, 0.0f, 0.0f, color );
+		detail::flush_all_deferred( *this );
+		detail::forget_occluders( *this, begin.m_command );
+
+		if ( begin.m_vertex < vtx_end )
+		{
+#if defined( ZDRAW_COMPACT_VERTEX )
+			for ( auto& vtx : std::span{ this->m_vertices.data( ) + begin.m_vertex, vtx_end - begin.m_vertex } )
+			{
+				const auto [x, y] { vertex_traits<vertex>::position( vtx, this->m_pos_scale ) };
+				vtx.m_pos[ 0 ] = vertex_traits<vertex>::quantize_pos( transform.m_xx * x + transform.m_xy * y + transform.m_tx, this->m_pos_scale );
+				vtx.m_pos[ 1 ] = vertex_traits<vertex>::quantize_pos( transform.m_yx * x + transform.m_yy * y + transform.m_ty, this->m_pos_scale );
+			}
+#else
+			detail::transform_points( reinterpret_cast< std::byte* >( this->m_vertices.data( ) + begin.m_vertex ), sizeof( vertex ), vtx_end - begin.m_vertex, transform );
+#endif
+		}
 
-		this->push_vertex( x + w - actual_corner_length, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - actual_corner_length, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - thickness, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - thickness, y + actual_corner_length, 0.0f, 0.0f, color );
+		if ( begin.m_sdf_vertex < sdf_end )
+		{
+			detail::transform_points( reinterpret_cast< std::byte* >( this->m_sdf_vertices.data( ) + begin.m_sdf_vertex ), sizeof( sdf_vertex ), sdf_end - begin.m_sdf_vertex, transform );
+		}
+	}
 
-		this->push_vertex( x + w - thickness, y + h - actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h - actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - thickness, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - actual_corner_length, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h, 0.0f, 0.0f, color );
-		this->push_vertex( x + w - actual_corner_length, y + h, 0.0f, 0.0f, color );
+	void draw_list::modulate_range( const vertex_mark& begin, const vertex_mark& end, rgba color )
+	{
+		const auto vtx_end{ std::min( end.m_vertex, static_cast< std::uint32_t >( this->m_vertices.size( ) ) ) };
+		const auto sdf_end{ std::min( end.m_sdf_vertex, static_cast< std::uint32_t >( this->m_sdf_vertices.size( ) ) ) };
 
-		this->push_vertex( x, y + h - actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x + thickness, y + h - actual_corner_length, 0.0f, 0.0f, color );
-		this->push_vertex( x + thickness, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + actual_corner_length, y + h - thickness, 0.0f, 0.0f, color );
-		this->push_vertex( x + actual_corner_length, y + h, 0.0f, 0.0f, color );
-		this->push_vertex( x, y + h, 0.0f, 0.0f, color );
+		if ( color.val == 0xffffffffu || ( begin.m_vertex >= vtx_end && begin.m_sdf_vertex >= sdf_end ) )
+		{
+			return;
+		}
 
-		auto idx{ this->m_indices.allocate( 48 ) };
+		detail::flush_all_deferred( *this );
 
-		for ( int i{ 0 }; i < 8; ++i )
+		if ( color.a != 255u )
 		{
-			const auto base{ i * 6 };
-			const auto vertex_base{ static_cast< std::uint32_t >( vtx_base + i * 4 ) };
+			detail::forget_occluders( *this, begin.m_command );
+		}
+
+		const auto factor{ premultiply( color, blend::normal ) };
 
-			idx[ base + 0 ] = vertex_base; idx[ base + 1 ] = vertex_base + 1;
-			idx[ base + 2 ] = vertex_base + 2;
-			idx[ base + 3 ] = vertex_base; idx[ base + 4 ] = vertex_base + 2;
-			idx[ base + 5 ] = vertex_base + 3;
+		if ( begin.m_vertex < vtx_end )
+		{
+			detail::modulate_colors( reinterpret_cast< std::byte* >( &this->m_vertices.data( )[ begin.m_vertex ].m_col ), sizeof( vertex ), vtx_end - begin.m_vertex, factor );
 		}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 48u;
+		if ( begin.m_sdf_vertex < sdf_end )
+		{
+			auto* first{ this->m_sdf_vertices.data( ) + begin.m_sdf_vertex };
+			detail::modulate_colors( reinterpret_cast< std::byte* >( &first->m_col ), sizeof( sdf_vertex ), sdf_end - begin.m_sdf_vertex, factor );
+			detail::modulate_colors( reinterpret_cast< std::byte* >( &first->m_effect_col ), sizeof( sdf_vertex ), sdf_end - begin.m_sdf_vertex, factor );
+		}
 	}
 
-	void draw_list::add_rect_filled( float x, float y, float w, float h, rgba color )
+	std::uint32_t draw_list::intern_texture( ID3D11ShaderResourceView* texture )
 	{
-		if ( w <= 0.0f || h <= 0.0f )
+		const auto [it, inserted] { this->m_texture_lookup.try_emplace( texture, static_cast< std::uint32_t >( this->m_textures.size( ) ) ) };
+		if ( inserted )
 		{
-			return;
+			this->m_textures.emplace_back( texture );
+		}
+
+		return it->second;
+	}
+
+	std::uint32_t draw_list::intern_clip_rect( const D3D11_RECT& rect )
+	{
+		const auto [it, inserted] { this->m_clip_lookup.try_emplace( rect, static_cast< std::uint32_t >( this->m_clip_rects.size( ) ) ) };
+		if ( inserted )
+		{
+			*this->m_clip_rects.allocate( 1 ) = rect;
 		}
 
-		this->ensure_draw_cmd( nullptr );
+		return it->second;
+	}
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+	void draw_list::ensure_draw_cmd( ID3D11ShaderResourceView* texture, draw_kind kind )
+	{
+		auto actual_texture{ texture != nullptr ? texture : detail::g_render.m_white_texture_srv.Get( ) };
+		const auto clip{ this->m_clip_stack.empty( ) ? draw_cmd::k_no_clip : this->m_clip_stack.back( ) };
 
-		this->push_vertex( x, y, 0.0f, 0.0f, color );
-		this->push_vertex( x + w, y, 1.0f, 0.0f, color );
-		this->push_vertex( x + w, y + h, 1.0f, 1.0f, color );
-		this->push_vertex( x, y + h, 0.0f, 1.0f, color );
+		if ( this->m_commands.size( ) != 0 )
+		{
+			const auto& last = this->m_commands.data( )[ this->m_commands.size( ) - 1 ];
+			if ( this->m_commands.size( ) > this->m_command_barrier && last.m_kind == kind && last.m_clip == clip && this->texture_of( last ) == actual_texture )
+			{
+				return;
+			}
+		}
 
-		auto idx{ this->m_indices.allocate( 6 ) };
-		idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+		*this->m_commands.allocate( 1 ) = draw_cmd
+		{
+			static_cast< std::uint32_t >( this->m_indices.size( ) ),
+			0u,
+			this->intern_texture( actual_texture ),
+			clip,
+			kind
+		};
+	}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+	prim_writer draw_list::prim_reserve( std::uint32_t vtx_count, std::uint32_t idx_count, ID3D11ShaderResourceView* texture )
+	{
+		this->ensure_draw_cmd( texture );
+
+		const auto vtx_offset{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		prim_writer writer{ this->m_vertices.allocate( vtx_count ), this->m_indices.allocate( idx_count ), vtx_offset, this->m_blend };
+		writer.m_pos_scale = this->m_pos_scale;
+
+		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += idx_count;
+		return writer;
 	}
 
-	void draw_list::add_rect_filled_multi_color( float x, float y, float w, float h, rgba color_tl, rgba color_tr, rgba color_br, rgba color_bl )
+	template<typename F>
+	void draw_list::emit_prim( ID3D11ShaderResourceView* texture, std::uint32_t vtx_count, std::uint32_t idx_count, const F& emit )
 	{
-		if ( w <= 0.0f || h <= 0.0f )
+		static_assert( std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>, "primitive emitters must be trivially copyable" );
+
+		auto reserved{ this->prim_reserve( vtx_count, idx_count, texture ) };
+
+		constexpr auto thunk{ [ ]( const void* closure, prim_writer& writer ) { ( *static_cast< const F* >( closure ) )( writer ); } };
+
+		if ( !this->m_deferred )
 		{
+			thunk( &emit, reserved );
 			return;
 		}
 
-		this->ensure_draw_cmd( nullptr );
-
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		auto closure{ get_frame_arena( ).allocate( sizeof( F ), alignof( F ) ) };
+		std::memcpy( closure, &emit, sizeof( F ) );
 
-		this->push_vertex( x, y, 0.0f, 0.0f, color_tl );
-		this->push_vertex( x + w, y, 1.0f, 0.0f, color_tr );
-		this->push_vertex( x + w, y + h, 1.0f, 1.0f, color_br );
-		this->push_vertex( x, y + h, 0.0f, 1.0f, color_bl );
+		const auto idx_offset{ static_cast< std::uint32_t >( reserved.m_idx - this->m_indices.data( ) ) };
+		*this->m_deferred_prims.allocate( 1 ) = deferred_prim{ thunk, closure, reserved.m_vtx_index, idx_offset, vtx_count, this->m_blend };
+	}
 
-		auto idx{ this->m_indices.allocate( 6 ) };
-		idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+	template<typename F>
+	void draw_list::emit_instances( ID3D11ShaderResourceView* texture, std::size_t count, std::uint32_t vtx_per_instance, std::uint32_t idx_per_instance, const F& emit )
+	{
+		for ( std::size_t first{ 0 }; first < count; first += detail::k_instance_chunk )
+		{
+			const auto last{ std::min( count, first + detail::k_instance_chunk ) };
+			const auto instances{ static_cast< std::uint32_t >( last - first ) };
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+			this->emit_prim( texture, instances * vtx_per_instance, instances * idx_per_instance, [ = ]( prim_writer& writer )
+				{
+					for ( auto i{ first }; i < last; ++i )
+					{
+						emit( writer, i );
+					}
+				} );
+		}
 	}
 
-	void draw_list::add_rect_textured( float x, float y, float w, float h, ID3D11ShaderResourceView* tex, float u0, float v0, float u1, float v1, rgba color )
+	template<typename T>
+	std::span<const T> draw_list::retain( std::span<const T> data )
 	{
-		this->ensure_draw_cmd( tex );
+		if ( !this->m_deferred || data.empty( ) )
+		{
+			return data;
+		}
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		auto copy{ get_frame_arena( ).allocate_array<T>( data.size( ) ) };
+		std::memcpy( copy.data( ), data.data( ), data.size_bytes( ) );
+		return copy;
+	}
 
-		this->push_vertex( x, y, u0, v0, color );
-		this->push_vertex( x + w, y, u1, v0, color );
-		this->push_vertex( x + w, y + h, u1, v1, color );
-		this->push_vertex( x, y + h, u0, v1, color );
+	std::string_view draw_list::retain( std::string_view text )
+	{
+		return this->m_deferred ? get_frame_arena( ).copy( text ) : text;
+	}
 
-		auto idx{ this->m_indices.allocate( 6 ) };
-		idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+	void draw_list::flush_deferred( )
+	{
+		if ( this->m_deferred_prims.size( ) == 0 )
+		{
+			return;
+		}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+		detail::tessellate_deferred( *this );
+		this->m_deferred_prims.clear( );
 	}
 
-	void draw_list::add_convex_poly_filled( std::span<const float> points, rgba color )
+	void draw_list::split( std::uint32_t count )
 	{
-		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
-		if ( num_points < 3 ) [[unlikely]]
+		if ( this->m_channel_count != 0u || count < 2u )
 		{
 			return;
 		}
 
-		this->ensure_draw_cmd( nullptr );
-
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		if ( this->m_channels.size( ) < count )
+		{
+			this->m_channels.resize( count );
+		}
 
-		for ( std::size_t i{ 0 }; i < static_cast< std::size_t >( num_points ); ++i )
+		for ( std::uint32_t i{ 0 }; i < count; ++i )
 		{
-			const auto x{ points[ i * 2 + 0 ] };
-			const auto y{ points[ i * 2 + 1 ] };
-			this->push_vertex( x, y, 0.5f, 0.5f, color );
+			this->m_channels[ i ].clear( );
 		}
 
-		const auto num_triangles{ num_points - 2 };
-		auto idx{ this->m_indices.allocate( static_cast< std::size_t >( num_triangles ) * 3u ) };
+		this->m_channel_count = count;
+		this->m_current_channel = 0u;
+	}
 
-		for ( int i{ 0 }; i < num_triangles; ++i )
+	void draw_list::set_channel( std::uint32_t index )
+	{
+		if ( index >= this->m_channel_count || index == this->m_current_channel )
 		{
-			const auto base_idx{ i * 3 };
-			idx[ base_idx + 0 ] = vtx_base;
-			idx[ base_idx + 1 ] = vtx_base + static_cast< std::uint32_t >( i + 1 );
-			idx[ base_idx + 2 ] = vtx_base + static_cast< std::uint32_t >( i + 2 );
+			return;
 		}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += static_cast< std::uint32_t >( num_triangles ) * 3u;
+		detail::swap_channel( *this, this->m_channels[ this->m_current_channel ] );
+		detail::swap_channel( *this, this->m_channels[ index ] );
+		this->m_current_channel = index;
 	}
 
-	void draw_list::add_polyline( std::span<const float> points, rgba color, bool closed, float thickness )
+	void draw_list::merge( )
 	{
-		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
-		if ( num_points < 2 ) [[unlikely]]
+		if ( this->m_channel_count == 0u )
 		{
 			return;
 		}
 
-		this->ensure_draw_cmd( nullptr );
+		this->set_channel( 0u );
 
-		const auto num_segments{ closed ? num_points : ( num_points - 1 ) };
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		for ( std::uint32_t i{ 1 }; i < this->m_channel_count; ++i )
+		{
+			auto& channel{ this->m_channels[ i ] };
+			const auto cmd_count{ static_cast< std::uint32_t >( channel.m_commands.size( ) ) };
 
-		constexpr auto aa_fringe{ 1.0f };
-		constexpr auto aa_half{ aa_fringe * 0.5f };
-		const auto half_thickness{ std::max( 0.0f, thickness ) * 0.5f };
-		const auto core_thickness{ std::max( 0.0f, half_thickness - aa_half ) };
-		const auto outer_thickness{ half_thickness + aa_half };
+			if ( cmd_count == 0u )
+			{
+				continue;
+			}
 
-		auto transparent_color{ color };
-		transparent_color.a = 0;
+			const auto idx_base{ static_cast< std::uint32_t >( this->m_indices.size( ) ) };
+			const auto idx_count{ channel.m_indices.size( ) };
+			if ( idx_count != 0u )
+			{
+				std::memcpy( this->m_indices.allocate( idx_count ), channel.m_indices.data( ), idx_count * sizeof( std::uint32_t ) );
+			}
 
-		const auto normals_size = static_cast< std::size_t >( num_segments );
+			auto commands{ channel.m_commands.data( ) };
+			for ( std::uint32_t c{ 0 }; c < cmd_count; ++c )
+			{
+				commands[ c ].m_idx_offset += idx_base;
+			}
 
-		this->m_scratch_normals_x.clear( );
-		this->m_scratch_normals_y.clear( );
+			const auto cmd_base{ static_cast< std::uint32_t >( this->m_commands.size( ) ) };
+			const auto region_first{ channel.m_region_passes.size( ) != 0u && channel.m_region_passes.data( )[ 0 ].m_first_command == 0u };
 
-		auto normals_x = this->m_scratch_normals_x.allocate( normals_size );
-		auto normals_y = this->m_scratch_normals_y.allocate( normals_size );
+			auto folded{ 0u };
+			if ( cmd_base > this->m_command_barrier && !region_first )
+			{
+				auto& last{ this->m_commands.data( )[ cmd_base - 1u ] };
+				if ( detail::can_fold_commands( last, commands[ 0 ] ) )
+				{
+					last.m_idx_count += commands[ 0 ].m_idx_count;
+					folded = 1u;
+				}
+			}
 
-		for ( int i{ 0 }; i < num_segments; ++i )
-		{
-			const auto p1_idx{ i };
-			const auto p2_idx{ closed ? ( ( i + 1 ) % num_points ) : ( i + 1 ) };
-			const auto dx{ points[ static_cast< std::size_t >( p2_idx * 2 + 0 ) ] - points[ static_cast< std::size_t >( p1_idx * 2 + 0 ) ] };
-			const auto dy{ points[ static_cast< std::size_t >( p2_idx * 2 + 1 ) ] - points[ static_cast< std::size_t >( p1_idx * 2 + 1 ) ] };
+			if ( cmd_count > folded )
+			{
+				std::memcpy( this->m_commands.allocate( cmd_count - folded ), commands + folded, ( cmd_count - folded ) * sizeof( draw_cmd ) );
+			}
 
-			const auto length{ std::sqrt( dx * dx + dy * dy ) };
-			if ( length > 0.0001f )
+			const auto cmd_shift{ cmd_base - folded };
+
+			for ( auto& prim : std::span{ channel.m_deferred_prims.data( ), channel.m_deferred_prims.size( ) } )
 			{
-				normals_x[ i ] = -dy / length;
-				normals_y[ i ] = dx / length;
+				auto& dst{ *this->m_deferred_prims.allocate( 1 ) };
+				dst = prim;
+				dst.m_idx_offset += idx_base;
 			}
-			else
+
+			for ( auto& occ : std::span{ channel.m_occluders.data( ), channel.m_occluders.size( ) } )
+			{
+				*this->m_occluders.allocate( 1 ) = occluder{ occ.m_rect, occ.m_command + cmd_shift };
+			}
+
+			for ( auto& pass : std::span{ channel.m_region_passes.data( ), channel.m_region_passes.size( ) } )
+			{
+				*this->m_region_passes.allocate( 1 ) = region_pass{ pass.m_target, pass.m_rect, pass.m_first_command + cmd_shift, pass.m_end_command + cmd_shift };
+			}
+
+			if ( channel.m_command_barrier != 0u )
 			{
-				normals_x[ i ] = 0.0f;
-				normals_y[ i ] = 0.0f;
+				this->m_command_barrier = channel.m_command_barrier + cmd_shift;
 			}
+
+			channel.clear( );
+		}
+
+		this->m_channel_count = 0u;
+		this->m_current_channel = 0u;
+	}
+
+	void draw_list::add_occluder( float x, float y, float w, float h )
+	{
+		if ( !this->m_cull_occluded || this->m_blend != blend::normal || this->m_commands.size( ) == 0 )
+		{
+			return;
+		}
+
+		D3D11_RECT r{};
+		r.left = static_cast< LONG >( std::ceil( x ) );
+		r.top = static_cast< LONG >( std::ceil( y ) );
+		r.right = static_cast< LONG >( std::floor( x + w ) );
+		r.bottom = static_cast< LONG >( std::floor( y + h ) );
+
+		if ( !this->m_clip_stack.empty( ) )
+		{
+			r = detail::intersect_rect( r, this->m_clip_rects.data( )[ this->m_clip_stack.back( ) ] );
 		}
 
-		for ( int i{ 0 }; i < num_points; ++i )
+		if ( detail::rect_empty( r ) || ( r.right - r.left ) * ( r.bottom - r.top ) < detail::k_min_occluder_area )
 		{
-			const auto x{ points[ static_cast< std::size_t >( i ) * 2 + 0 ] };
-			const auto y{ points[ static_cast< std::size_t >( i ) * 2 + 1 ] };
+			return;
+		}
+
+		*this->m_occluders.allocate( 1 ) = occluder{ r, static_cast< std::uint32_t >( this->m_commands.size( ) - 1 ) };
+	}
+
+	void draw_list::add_line( float x0, float y0, float x1, float y1, rgba color, float thickness )
+	{
+		const auto dx{ x1 - x0 };
+		const auto dy{ y1 - y0 };
+		const auto length{ std::sqrt( dx * dx + dy * dy ) };
 
-			auto normal_x{ 0.0f };
-			auto normal_y{ 0.0f };
+		if ( length < 0.0001f ) [[unlikely]]
+		{
+			return;
+		}
 
-			if ( closed )
+		this->emit_prim( nullptr, 8u, 18u, [ = ]( prim_writer& writer )
 			{
-				const auto prev_seg{ ( i - 1 + num_segments ) % num_segments };
-				const auto curr_seg{ i % num_segments };
-				normal_x = ( normals_x[ static_cast< std::size_t >( prev_seg ) ] + normals_x[ static_cast< std::size_t >( curr_seg ) ] ) * 0.5f;
-				normal_y = ( normals_y[ static_cast< std::size_t >( prev_seg ) ] + normals_y[ static_cast< std::size_t >( curr_seg ) ] ) * 0.5f;
-			}
-			else
+				detail::emit_line( writer, x0, y0, x1, y1, color, thickness );
+			} );
+	}
+
+	void draw_list::add_rect( float x, float y, float w, float h, rgba color, float thickness )
+	{
+		if ( w <= 0.0f || h <= 0.0f )
+		{
+			return;
+		}
+
+		const auto max_th{ 0.5f * std::min( w, h ) };
+
+		thickness = std::clamp( thickness, 0.0f, max_th );
+		if ( thickness <= 0.0f )
+		{
+			return;
+		}
+
+		this->emit_prim( nullptr, 8u, 24u, [ = ]( prim_writer& writer )
 			{
-				if ( i == 0 )
-				{
-					normal_x = normals_x[ 0 ];
-					normal_y = normals_y[ 0 ];
-				}
-				else if ( i == num_points - 1 )
-				{
-					normal_x = normals_x[ static_cast< std::size_t >( num_segments - 1 ) ];
-					normal_y = normals_y[ static_cast< std::size_t >( num_segments - 1 ) ];
-				}
-				else
+				const auto vtx_base{ writer.m_vtx_index };
+				const auto inner_x{ x + thickness };
+				const auto inner_y{ y + thickness };
+				const auto inner_w{ std::max( 0.0f, w - thickness * 2.0f ) };
+				const auto inner_h{ std::max( 0.0f, h - thickness * 2.0f ) };
+
+				writer.push_vertex( x, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + h, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + h, 0.0f, 0.0f, color );
+
+				writer.push_vertex( inner_x, inner_y, 0.0f, 0.0f, color );
+				writer.push_vertex( inner_x + inner_w, inner_y, 0.0f, 0.0f, color );
+				writer.push_vertex( inner_x + inner_w, inner_y + inner_h, 0.0f, 0.0f, color );
+				writer.push_vertex( inner_x, inner_y + inner_h, 0.0f, 0.0f, color );
+
+				auto idx{ writer.m_idx };
+				idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 5;
+				idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 5; idx[ 5 ] = vtx_base + 4;
+				idx[ 6 ] = vtx_base + 1; idx[ 7 ] = vtx_base + 2; idx[ 8 ] = vtx_base + 6;
+				idx[ 9 ] = vtx_base + 1; idx[ 10 ] = vtx_base + 6; idx[ 11 ] = vtx_base + 5;
+				idx[ 12 ] = vtx_base + 2; idx[ 13 ] = vtx_base + 3; idx[ 14 ] = vtx_base + 7;
+				idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 7; idx[ 17 ] = vtx_base + 6;
+				idx[ 18 ] = vtx_base + 3; idx[ 19 ] = vtx_base; idx[ 20 ] = vtx_base + 4;
+				idx[ 21 ] = vtx_base + 3; idx[ 22 ] = vtx_base + 4; idx[ 23 ] = vtx_base + 7;
+			} );
+	}
+
+	void draw_list::add_rect_cornered( float x, float y, float w, float h, rgba color, float corner_length, float thickness )
+	{
+		const auto max_corner{ std::min( w, h ) * 0.5f };
+		const auto actual_corner_length{ std::min( corner_length, max_corner ) };
+		const auto max_th{ 0.5f * std::min( w, h ) };
+
+		thickness = std::clamp( thickness, 0.0f, max_th );
+		if ( thickness <= 0.0f )
+		{
+			return;
+		}
+
+		this->emit_prim( nullptr, 32u, 48u, [ = ]( prim_writer& writer )
+			{
+				const auto vtx_base{ writer.m_vtx_index };
+
+				writer.push_vertex( x, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + actual_corner_length, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + actual_corner_length, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + thickness, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + thickness, y + actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + actual_corner_length, 0.0f, 0.0f, color );
+
+				writer.push_vertex( x + w - actual_corner_length, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - actual_corner_length, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - thickness, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - thickness, y + actual_corner_length, 0.0f, 0.0f, color );
+
+				writer.push_vertex( x + w - thickness, y + h - actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + h - actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - thickness, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - actual_corner_length, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w, y + h, 0.0f, 0.0f, color );
+				writer.push_vertex( x + w - actual_corner_length, y + h, 0.0f, 0.0f, color );
+
+				writer.push_vertex( x, y + h - actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x + thickness, y + h - actual_corner_length, 0.0f, 0.0f, color );
+				writer.push_vertex( x + thickness, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + actual_corner_length, y + h - thickness, 0.0f, 0.0f, color );
+				writer.push_vertex( x + actual_corner_length, y + h, 0.0f, 0.0f, color );
+				writer.push_vertex( x, y + h, 0.0f, 0.0f, color );
+
+				auto idx{ writer.m_idx };
+
+				for ( int i{ 0 }; i < 8; ++i )
 				{
-					normal_x = ( normals_x[ static_cast< std::size_t >( i - 1 ) ] + normals_x[ static_cast< std::size_t >( i ) ] ) * 0.5f;
-					normal_y = ( normals_y[ static_cast< std::size_t >( i - 1 ) ] + normals_y[ static_cast< std::size_t >( i ) ] ) * 0.5f;
+					const auto base{ i * 6 };
+					const auto vertex_base{ static_cast< std::uint32_t >( vtx_base + i * 4 ) };
+
+					idx[ base + 0 ] = vertex_base; idx[ base + 1 ] = vertex_base + 1;
+					idx[ base + 2 ] = vertex_base + 2;
+					idx[ base + 3 ] = vertex_base; idx[ base + 4 ] = vertex_base + 2;
+					idx[ base + 5 ] = vertex_base + 3;
 				}
-			}
+			} );
+	}
 
-			const auto normal_length{ std::sqrt( normal_x * normal_x + normal_y * normal_y ) };
-			if ( normal_length > 0.0001f )
-			{
-				normal_x /= normal_length;
-				normal_y /= normal_length;
-			}
+	void draw_list::add_rect_filled( float x, float y, float w, float h, rgba color )
+	{
+		if ( w <= 0.0f || h <= 0.0f )
+		{
+			return;
+		}
 
-			this->push_vertex( x + normal_x * core_thickness, y + normal_y * core_thickness, 0.0f, 0.0f, color );
-			this->push_vertex( x - normal_x * core_thickness, y - normal_y * core_thickness, 1.0f, 1.0f, color );
+		this->emit_prim( nullptr, 4u, 6u, [ = ]( prim_writer& writer )
+			{
+				detail::emit_rect_filled( writer, x, y, w, h, color );
+			} );
 
-			this->push_vertex( x + normal_x * outer_thickness, y + normal_y * outer_thickness, 0.0f, 0.0f, transparent_color );
-			this->push_vertex( x - normal_x * outer_thickness, y - normal_y * outer_thickness, 1.0f, 1.0f, transparent_color );
+		if ( color.a == 255 )
+		{
+			this->add_occluder( x, y, w, h );
 		}
+	}
 
-		auto idx{ this->m_indices.allocate( static_cast< std::size_t >( num_segments ) * 18u ) };
+	void draw_list::add_rect_filled_multi_color( float x, float y, float w, float h, rgba color_tl, rgba color_tr, rgba color_br, rgba color_bl )
+	{
+		if ( w <= 0.0f || h <= 0.0f )
+		{
+			return;
+		}
 
-		for ( int i{ 0 }; i < num_segments; ++i )
+		this->emit_prim( nullptr, 4u, 6u, [ = ]( prim_writer& writer )
+			{
+				writer.push_vertex( x, y, 0.0f, 0.0f, color_tl );
+				writer.push_vertex( x + w, y, 1.0f, 0.0f, color_tr );
+				writer.push_vertex( x + w, y + h, 1.0f, 1.0f, color_br );
+				writer.push_vertex( x, y + h, 0.0f, 1.0f, color_bl );
+				writer.push_quad_indices( );
+			} );
+
+		if ( color_tl.a == 255 && color_tr.a == 255 && color_br.a == 255 && color_bl.a == 255 )
 		{
-			const auto next_i{ closed ? ( ( i + 1 ) % num_points ) : ( i + 1 ) };
-			const auto base_idx{ i * 18 };
-
-			const auto curr_core_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 0 ) };
-			const auto curr_core_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 1 ) };
-			const auto curr_outer_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 2 ) };
-			const auto curr_outer_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 3 ) };
-			const auto next_core_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 0 ) };
-			const auto next_core_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 1 ) };
-			const auto next_outer_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 2 ) };
-			const auto next_outer_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 3 ) };
-
-			idx[ base_idx + 0 ] = curr_core_top;
-			idx[ base_idx + 1 ] = curr_core_bot;
-			idx[ base_idx + 2 ] = next_core_bot;
-			idx[ base_idx + 3 ] = curr_core_top;
-			idx[ base_idx + 4 ] = next_core_bot;
-			idx[ base_idx + 5 ] = next_core_top;
-			idx[ base_idx + 6 ] = curr_outer_top;
-			idx[ base_idx + 7 ] = curr_core_top;
-			idx[ base_idx + 8 ] = next_core_top;
-			idx[ base_idx + 9 ] = curr_outer_top;
-			idx[ base_idx + 10 ] = next_core_top;
-			idx[ base_idx + 11 ] = next_outer_top;
-			idx[ base_idx + 12 ] = curr_core_bot;
-			idx[ base_idx + 13 ] = curr_outer_bot;
-			idx[ base_idx + 14 ] = next_outer_bot;
-			idx[ base_idx + 15 ] = curr_core_bot;
-			idx[ base_idx + 16 ] = next_outer_bot;
-			idx[ base_idx + 17 ] = next_core_bot;
-		}
-
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += static_cast< std::uint32_t >( num_segments ) * 18u;
+			this->add_occluder( x, y, w, h );
+		}
 	}
 
-	void draw_list::add_polyline_multi_color( std::span<const float> points, std::span<const rgba> colors, bool closed, float thickness )
+	void draw_list::add_rect_textured( float x, float y, float w, float h, ID3D11ShaderResourceView* tex, float u0, float v0, float u1, float v1, rgba color )
+	{
+		this->emit_prim( tex, 4u, 6u, [ = ]( prim_writer& writer )
+			{
+				writer.push_vertex( x, y, u0, v0, color );
+				writer.push_vertex( x + w, y, u1, v0, color );
+				writer.push_vertex( x + w, y + h, u1, v1, color );
+				writer.push_vertex( x, y + h, u0, v1, color );
+				writer.push_quad_indices( );
+			} );
+	}
+
+	void draw_list::add_convex_poly_filled( std::span<const float> points, rgba color )
 	{
 		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
-		if ( num_points < 2 || static_cast< int >( colors.size( ) ) < num_points ) [[unlikely]]
+		if ( num_points < 3 ) [[unlikely]]
 		{
 			return;
 		}
 
-		this->ensure_draw_cmd( nullptr );
-
-		const auto num_segments{ closed ? num_points : ( num_points - 1 ) };
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+		const auto num_triangles{ num_points - 2 };
+		const auto retained{ this->retain( points ) };
 
-		constexpr auto aa_fringe{ 1.0f };
-		constexpr auto aa_half{ aa_fringe * 0.5f };
-		const auto half_thickness{ std::max( 0.0f, thickness ) * 0.5f };
-		const auto core_thickness{ std::max( 0.0f, half_thickness - aa_half ) };
-		const auto outer_thickness{ half_thickness + aa_half };
+		this->emit_prim( nullptr, static_cast< std::uint32_t >( num_points ), static_cast< std::uint32_t >( num_triangles ) * 3u, [ = ]( prim_writer& writer )
+			{
+				const auto vtx_base{ writer.m_vtx_index };
 
-		const auto normals_size = static_cast< std::size_t >( num_segments );
+				for ( std::size_t i{ 0 }; i < static_cast< std::size_t >( num_points ); ++i )
+				{
+					const auto x{ retained[ i * 2 + 0 ] };
+					const auto y{ retained[ i * 2 + 1 ] };
+					writer.push_vertex( x, y, 0.5f, 0.5f, color );
+				}
 
-		this->m_scratch_normals_x.clear( );
-		this->m_scratch_normals_y.clear( );
+				auto idx{ writer.m_idx };
 
-		auto normals_x = this->m_scratch_normals_x.allocate( normals_size );
-		auto normals_y = this->m_scratch_normals_y.allocate( normals_size );
+				for ( int i{ 0 }; i < num_triangles; ++i )
+				{
+					const auto base_idx{ i * 3 };
+					idx[ base_idx + 0 ] = vtx_base;
+					idx[ base_idx + 1 ] = vtx_base + static_cast< std::uint32_t >( i + 1 );
+					idx[ base_idx + 2 ] = vtx_base + static_cast< std::uint32_t >( i + 2 );
+				}
+			} );
+	}
 
-		for ( int i{ 0 }; i < num_segments; ++i )
+	void draw_list::add_concave_poly_filled( std::span<const float> points, rgba color )
+	{
+		auto num_points{ points.size( ) / 2 };
+		if ( num_points >= 2 && points[ 0 ] == points[ num_points * 2 - 2 ] && points[ 1 ] == points[ num_points * 2 - 1 ] )
 		{
-			const auto p1_idx{ i };
-			const auto p2_idx{ closed ? ( ( i + 1 ) % num_points ) : ( i + 1 ) };
-			const auto dx{ points[ static_cast< std::size_t >( p2_idx * 2 + 0 ) ] - points[ static_cast< std::size_t >( p1_idx * 2 + 0 ) ] };
-			const auto dy{ points[ static_cast< std::size_t >( p2_idx * 2 + 1 ) ] - points[ static_cast< std::size_t >( p1_idx * 2 + 1 ) ] };
-
-			const auto length{ std::sqrt( dx * dx + dy * dy ) };
-			if ( length > 0.0001f )
-			{
-				normals_x[ i ] = -dy / length;
-				normals_y[ i ] = dx / length;
-			}
-			else
-			{
-				normals_x[ i ] = 0.0f;
-				normals_y[ i ] = 0.0f;
-			}
+			--num_points;
 		}
 
-		for ( int i{ 0 }; i < num_points; ++i )
+		if ( num_points < 3 ) [[unlikely]]
 		{
-			const auto x{ points[ static_cast< std::size_t >( i ) * 2 + 0 ] };
-			const auto y{ points[ static_cast< std::size_t >( i ) * 2 + 1 ] };
-			const auto color{ colors[ static_cast< std::size_t >( i ) ] };
+			return;
+		}
 
-			auto transparent_color{ color };
-			transparent_color.a = 0;
+		const auto outline{ points.first( num_points * 2 ) };
+		const auto winding{ detail::polygon_winding( outline ) };
+		detail::triangulate_polygon( outline, winding, this->m_scratch_indices, this->m_scratch_triangles );
 
-			auto normal_x{ 0.0f };
-			auto normal_y{ 0.0f };
+		const auto retained_points{ this->retain( outline ) };
+		const auto retained_triangles{ this->retain( this->m_scratch_triangles.span( ) ) };
+		const auto vtx_count{ static_cast< std::uint32_t >( num_points ) * 2u };
+		const auto idx_count{ static_cast< std::uint32_t >( retained_triangles.size( ) + num_points * 6 ) };
 
-			if ( closed )
-			{
-				const auto prev_seg{ ( i - 1 + num_segments ) % num_segments };
-				const auto curr_seg{ i % num_segments };
-				normal_x = ( normals_x[ static_cast< std::size_t >( prev_seg ) ] + normals_x[ static_cast< std::size_t >( curr_seg ) ] ) * 0.5f;
-				normal_y = ( normals_y[ static_cast< std::size_t >( prev_seg ) ] + normals_y[ static_cast< std::size_t >( curr_seg ) ] ) * 0.5f;
-			}
-			else
+		this->emit_prim( nullptr, vtx_count, idx_count, [ = ]( prim_writer& writer )
 			{
-				if ( i == 0 )
-				{
-					normal_x = normals_x[ 0 ];
-					normal_y = normals_y[ 0 ];
-				}
-				else if ( i == num_points - 1 )
-				{
-					normal_x = normals_x[ static_cast< std::size_t >( num_segments - 1 ) ];
-					normal_y = normals_y[ static_cast< std::size_t >( num_segments - 1 ) ];
-				}
-				else
-				{
-					normal_x = ( normals_x[ static_cast< std::size_t >( i - 1 ) ] + normals_x[ static_cast< std::size_t >( i ) ] ) * 0.5f;
-					normal_y = ( normals_y[ static_cast< std::size_t >( i - 1 ) ] + normals_y[ static_cast< std::size_t >( i ) ] ) * 0.5f;
-				}
-			}
+				detail::emit_concave_poly_filled( writer, retained_points, retained_triangles, winding, color );
+			} );
+	}
 
-			const auto normal_length{ std::sqrt( normal_x * normal_x + normal_y * normal_y ) };
-			if ( normal_length > 0.0001f )
-			{
-				normal_x /= normal_length;
-				normal_y /= normal_length;
-			}
+	void draw_list::add_polyline( std::span<const float> points, rgba color, bool closed, float thickness )
+	{
+		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
+		if ( num_points < 2 ) [[unlikely]]
+		{
+			return;
+		}
 
-			this->push_vertex( x + normal_x * core_thickness, y + normal_y * core_thickness, 0.0f, 0.0f, color );
-			this->push_vertex( x - normal_x * core_thickness, y - normal_y * core_thickness, 1.0f, 1.0f, color );
+		const auto num_segments{ closed ? num_points : ( num_points - 1 ) };
+		const auto retained{ this->retain( points ) };
+
+		this->emit_prim( nullptr, static_cast< std::uint32_t >( num_points ) * 4u, static_cast< std::uint32_t >( num_segments ) * 18u, [ = ]( prim_writer& writer )
+			{
+				detail::emit_polyline( writer, retained, {}, color, closed, thickness );
+			} );
+	}
 
-			this->push_vertex( x + normal_x * outer_thickness, y + normal_y * outer_thickness, 0.0f, 0.0f, transparent_color );
-			this->push_vertex( x - normal_x * outer_thickness, y - normal_y * outer_thickness, 1.0f, 1.0f, transparent_color );
+	void draw_list::add_polyline_multi_color( std::span<const float> points, std::span<const rgba> colors, bool closed, float thickness )
+	{
+		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
+		if ( num_points < 2 || static_cast< int >( colors.size( ) ) < num_points ) [[unlikely]]
+		{
+			return;
 		}
 
-		auto idx{ this->m_indices.allocate( static_cast< std::size_t >( num_segments ) * 18u ) };
+		const auto num_segments{ closed ? num_points : ( num_points - 1 ) };
+		const auto retained_points{ this->retain( points ) };
+		const auto retained_colors{ this->retain( colors.first( static_cast< std::size_t >( num_points ) ) ) };
 
-		for ( int i{ 0 }; i < num_segments; ++i )
-		{
-			const auto next_i{ closed ? ( ( i + 1 ) % num_points ) : ( i + 1 ) };
-			const auto base_idx{ i * 18 };
-
-			const auto curr_core_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 0 ) };
-			const auto curr_core_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 1 ) };
-			const auto curr_outer_top{ vtx_base + static_cast< std::uint32_t >( i * 4 + 2 ) };
-			const auto curr_outer_bot{ vtx_base + static_cast< std::uint32_t >( i * 4 + 3 ) };
-			const auto next_core_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 0 ) };
-			const auto next_core_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 1 ) };
-			const auto next_outer_top{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 2 ) };
-			const auto next_outer_bot{ vtx_base + static_cast< std::uint32_t >( next_i * 4 + 3 ) };
-
-			idx[ base_idx + 0 ] = curr_core_top;
-			idx[ base_idx + 1 ] = curr_core_bot;
-			idx[ base_idx + 2 ] = next_core_bot;
-			idx[ base_idx + 3 ] = curr_core_top;
-			idx[ base_idx + 4 ] = next_core_bot;
-			idx[ base_idx + 5 ] = next_core_top;
-			idx[ base_idx + 6 ] = curr_outer_top;
-			idx[ base_idx + 7 ] = curr_core_top;
-			idx[ base_idx + 8 ] = next_core_top;
-			idx[ base_idx + 9 ] = curr_outer_top;
-			idx[ base_idx + 10 ] = next_core_top;
-			idx[ base_idx + 11 ] = next_outer_top;
-			idx[ base_idx + 12 ] = curr_core_bot;
-			idx[ base_idx + 13 ] = curr_outer_bot;
-			idx[ base_idx + 14 ] = next_outer_bot;
-			idx[ base_idx + 15 ] = curr_core_bot;
-			idx[ base_idx + 16 ] = next_outer_bot;
-			idx[ base_idx + 17 ] = next_core_bot;
-		}
-
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += static_cast< std::uint32_t >( num_segments ) * 18u;
+		this->emit_prim( nullptr, static_cast< std::uint32_t >( num_points ) * 4u, static_cast< std::uint32_t >( num_segments ) * 18u, [ = ]( prim_writer& writer )
+			{
+				detail::emit_polyline( writer, retained_points, retained_colors, rgba{}, closed, thickness );
+			} );
 	}
 
 	void draw_list::add_triangle( float x0, float y0, float x1, float y1, float x2, float y2, rgba color, float thickness )
@@ -1206,184 +3988,147 @@ namespace zdraw {
 
 	void draw_list::add_triangle_filled( float x0, float y0, float x1, float y1, float x2, float y2, rgba color )
 	{
-		this->ensure_draw_cmd( nullptr );
-
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-
-		constexpr auto aa_fringe{ 1.0f };
-		constexpr auto aa_half{ aa_fringe * 0.5f };
-
-		auto transparent{ color };
-		transparent.a = 0;
+		this->emit_prim( nullptr, 6u, 21u, [ = ]( prim_writer& writer )
+			{
+				const rgba colors[ 3 ]{ color, color, color };
+				detail::emit_triangle_filled( writer, x0, y0, x1, y1, x2, y2, colors );
+			} );
+	}
 
-		const float vx[ 3 ]{ x0, x1, x2 };
-		const float vy[ 3 ]{ y0, y1, y2 };
+	void draw_list::add_triangle_filled_multi_color( float x0, float y0, float x1, float y1, float x2, float y2, rgba color0, rgba color1, rgba color2 )
+	{
+		this->emit_prim( nullptr, 6u, 21u, [ = ]( prim_writer& writer )
+			{
+				const rgba colors[ 3 ]{ color0, color1, color2 };
+				detail::emit_triangle_filled( writer, x0, y0, x1, y1, x2, y2, colors );
+			} );
+	}
 
-		const auto cx{ ( x0 + x1 + x2 ) / 3.0f };
-		const auto cy{ ( y0 + y1 + y2 ) / 3.0f };
+	void draw_list::add_bezier_quadratic( float x0, float y0, float x1, float y1, float x2, float y2, rgba color, float thickness, float tolerance )
+	{
+		this->m_scratch_points.clear( );
+		detail::append_point( this->m_scratch_points, x0, y0 );
+		detail::flatten_quadratic( this->m_scratch_points, x0, y0, x1, y1, x2, y2, std::max( tolerance, 0.01f ), 0 );
+		this->add_polyline( this->m_scratch_points.span( ), color, false, thickness );
+	}
 
-		float nx[ 3 ]{}, ny[ 3 ]{};
+	void draw_list::add_bezier_cubic( float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, rgba color, float thickness, float tolerance )
+	{
+		this->m_scratch_points.clear( );
+		detail::append_point( this->m_scratch_points, x0, y0 );
+		detail::flatten_cubic( this->m_scratch_points, x0, y0, x1, y1, x2, y2, x3, y3, std::max( tolerance, 0.01f ), 0 );
+		this->add_polyline( this->m_scratch_points.span( ), color, false, thickness );
+	}
 
-		for ( int i{ 0 }; i < 3; ++i )
+	void draw_list::add_catmull_rom( std::span<const float> points, rgba color, bool closed, float thickness, float tolerance )
+	{
+		const auto num_points{ static_cast< int >( points.size( ) ) / 2 };
+		if ( num_points < ( closed ? 3 : 2 ) ) [[unlikely]]
 		{
-			const auto j{ ( i + 1 ) % 3 };
-			const auto ex{ vx[ j ] - vx[ i ] };
-			const auto ey{ vy[ j ] - vy[ i ] };
-			const auto len{ std::sqrt( ex * ex + ey * ey ) };
+			return;
+		}
 
-			if ( len < 0.0001f )
+		const auto point{ [ & ]( int i )
 			{
-				continue;
-			}
-
-			nx[ i ] = -ey / len;
-			ny[ i ] = ex / len;
+				i = closed ? ( i + num_points ) % num_points : std::clamp( i, 0, num_points - 1 );
+				return std::array{ points[ static_cast< std::size_t >( i ) * 2u ], points[ static_cast< std::size_t >( i ) * 2u + 1u ] };
+			} };
 
-			const auto mid_dx{ ( vx[ i ] + vx[ j ] ) * 0.5f - cx };
-			const auto mid_dy{ ( vy[ i ] + vy[ j ] ) * 0.5f - cy };
+		const auto num_segments{ closed ? num_points : num_points - 1 };
+		const auto tol{ std::max( tolerance, 0.01f ) };
 
-			if ( nx[ i ] * mid_dx + ny[ i ] * mid_dy < 0.0f )
-			{
-				nx[ i ] = -nx[ i ];
-				ny[ i ] = -ny[ i ];
-			}
-		}
+		this->m_scratch_points.clear( );
+		detail::append_point( this->m_scratch_points, points[ 0 ], points[ 1 ] );
 
-		float off_x[ 3 ]{}, off_y[ 3 ]{};
-		for ( int i{ 0 }; i < 3; ++i )
+		for ( int i{ 0 }; i < num_segments; ++i )
 		{
-			const auto prev{ ( i + 2 ) % 3 };
-			auto mx{ nx[ prev ] + nx[ i ] };
-			auto my{ ny[ prev ] + ny[ i ] };
-			const auto ml{ std::sqrt( mx * mx + my * my ) };
-
-			if ( ml > 0.0001f )
-			{
-				mx /= ml;
-				my /= ml;
-			}
+			const auto p0{ point( i - 1 ) };
+			const auto p1{ point( i ) };
+			const auto p2{ point( i + 1 ) };
+			const auto p3{ point( i + 2 ) };
 
-			const auto d{ mx * nx[ prev ] + my * ny[ prev ] };
-			const auto s{ d > 0.1f ? aa_half / d : aa_half * 2.0f };
-
-			off_x[ i ] = mx * s;
-			off_y[ i ] = my * s;
-		}
+			const auto c1x{ p1[ 0 ] + ( p2[ 0 ] - p0[ 0 ] ) / 6.0f };
+			const auto c1y{ p1[ 1 ] + ( p2[ 1 ] - p0[ 1 ] ) / 6.0f };
+			const auto c2x{ p2[ 0 ] - ( p3[ 0 ] - p1[ 0 ] ) / 6.0f };
+			const auto c2y{ p2[ 1 ] - ( p3[ 1 ] - p1[ 1 ] ) / 6.0f };
 
-		for ( int i{ 0 }; i < 3; ++i )
-		{
-			this->push_vertex( vx[ i ] - off_x[ i ], vy[ i ] - off_y[ i ], 0.0f, 0.0f, color );
+			detail::flatten_cubic( this->m_scratch_points, p1[ 0 ], p1[ 1 ], c1x, c1y, c2x, c2y, p2[ 0 ], p2[ 1 ], tol, 0 );
 		}
 
-		for ( int i{ 0 }; i < 3; ++i )
+		auto flattened{ this->m_scratch_points.span( ) };
+		if ( closed )
 		{
-			this->push_vertex( vx[ i ] + off_x[ i ], vy[ i ] + off_y[ i ], 0.0f, 0.0f, transparent );
+			flattened = flattened.first( flattened.size( ) - 2u );
 		}
 
-		auto idx{ this->m_indices.allocate( 21 ) };
-
-		idx[ 0 ] = vtx_base + 0; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base + 0; idx[ 4 ] = vtx_base + 3; idx[ 5 ] = vtx_base + 4;
-		idx[ 6 ] = vtx_base + 0; idx[ 7 ] = vtx_base + 4; idx[ 8 ] = vtx_base + 1;
-		idx[ 9 ] = vtx_base + 1; idx[ 10 ] = vtx_base + 4; idx[ 11 ] = vtx_base + 5;
-		idx[ 12 ] = vtx_base + 1; idx[ 13 ] = vtx_base + 5; idx[ 14 ] = vtx_base + 2;
-		idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 5; idx[ 17 ] = vtx_base + 3;
-		idx[ 18 ] = vtx_base + 2; idx[ 19 ] = vtx_base + 3; idx[ 20 ] = vtx_base + 0;
-
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 21u;
+		this->add_polyline( flattened, color, closed, thickness );
 	}
 
-	void draw_list::add_triangle_filled_multi_color( float x0, float y0, float x1, float y1, float x2, float y2, rgba color0, rgba color1, rgba color2 )
+	void draw_list::path_move_to( float x, float y )
 	{
-		this->ensure_draw_cmd( nullptr );
-
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-
-		constexpr auto aa_fringe{ 1.0f };
-		constexpr auto aa_half{ aa_fringe * 0.5f };
-
-		const rgba colors[ 3 ]{ color0, color1, color2 };
-		rgba transparent[ 3 ]{ color0, color1, color2 };
-		transparent[ 0 ].a = 0;
-		transparent[ 1 ].a = 0;
-		transparent[ 2 ].a = 0;
-
-		const float vx[ 3 ]{ x0, x1, x2 };
-		const float vy[ 3 ]{ y0, y1, y2 };
-
-		const auto cx{ ( x0 + x1 + x2 ) / 3.0f };
-		const auto cy{ ( y0 + y1 + y2 ) / 3.0f };
-
-		float nx[ 3 ]{}, ny[ 3 ]{};
+		this->m_scratch_path.clear( );
+		detail::append_point( this->m_scratch_path, x, y );
+	}
 
-		for ( int i{ 0 }; i < 3; ++i )
+	void draw_list::path_line_to( float x, float y )
+	{
+		const auto size{ this->m_scratch_path.size( ) };
+		if ( size >= 2 && this->m_scratch_path.data( )[ size - 2 ] == x && this->m_scratch_path.data( )[ size - 1 ] == y )
 		{
-			const auto j{ ( i + 1 ) % 3 };
-			const auto ex{ vx[ j ] - vx[ i ] };
-			const auto ey{ vy[ j ] - vy[ i ] };
-			const auto len{ std::sqrt( ex * ex + ey * ey ) };
-
-			if ( len < 0.0001f )
-			{
-				continue;
-			}
-
-			nx[ i ] = -ey / len;
-			ny[ i ] = ex / len;
-
-			const auto mid_dx{ ( vx[ i ] + vx[ j ] ) * 0.5f - cx };
-			const auto mid_dy{ ( vy[ i ] + vy[ j ] ) * 0.5f - cy };
-
-			if ( nx[ i ] * mid_dx + ny[ i ] * mid_dy < 0.0f )
-			{
-				nx[ i ] = -nx[ i ];
-				ny[ i ] = -ny[ i ];
-			}
+			return;
 		}
 
-		float off_x[ 3 ]{}, off_y[ 3 ]{};
-
-		for ( int i{ 0 }; i < 3; ++i )
-		{
-			const auto prev{ ( i + 2 ) % 3 };
-			auto mx{ nx[ prev ] + nx[ i ] };
-			auto my{ ny[ prev ] + ny[ i ] };
-			const auto ml{ std::sqrt( mx * mx + my * my ) };
-
-			if ( ml > 0.0001f )
-			{
-				mx /= ml;
-				my /= ml;
-			}
+		detail::append_point( this->m_scratch_path, x, y );
+	}
 
-			const auto d{ mx * nx[ prev ] + my * ny[ prev ] };
-			const auto s{ d > 0.1f ? aa_half / d : aa_half * 2.0f };
+	void draw_list::path_arc_to( float x, float y, float radius, float start_angle, float end_angle, int segments )
+	{
+		segments = std::max( segments, 1 );
+		const auto angle_increment{ ( end_angle - start_angle ) / static_cast< float >( segments ) };
 
-			off_x[ i ] = mx * s;
-			off_y[ i ] = my * s;
+		for ( int i{ 0 }; i <= segments; ++i )
+		{
+			const auto angle{ start_angle + angle_increment * static_cast< float >( i ) };
+			this->path_line_to( x + std::cos( angle ) * radius, y + std::sin( angle ) * radius );
 		}
+	}
 
-		for ( int i{ 0 }; i < 3; ++i )
+	void draw_list::path_bezier_quadratic_to( float x1, float y1, float x2, float y2, float tolerance )
+	{
+		const auto size{ this->m_scratch_path.size( ) };
+		if ( size < 2 ) [[unlikely]]
 		{
-			this->push_vertex( vx[ i ] - off_x[ i ], vy[ i ] - off_y[ i ], 0.0f, 0.0f, colors[ i ] );
+			return;
 		}
 
-		for ( int i{ 0 }; i < 3; ++i )
+		const auto x0{ this->m_scratch_path.data( )[ size - 2 ] };
+		const auto y0{ this->m_scratch_path.data( )[ size - 1 ] };
+		detail::flatten_quadratic( this->m_scratch_path, x0, y0, x1, y1, x2, y2, std::max( tolerance, 0.01f ), 0 );
+	}
+
+	void draw_list::path_bezier_to( float x1, float y1, float x2, float y2, float x3, float y3, float tolerance )
+	{
+		const auto size{ this->m_scratch_path.size( ) };
+		if ( size < 2 ) [[unlikely]]
 		{
-			this->push_vertex( vx[ i ] + off_x[ i ], vy[ i ] + off_y[ i ], 0.0f, 0.0f, transparent[ i ] );
+			return;
 		}
 
-		auto idx{ this->m_indices.allocate( 21 ) };
+		const auto x0{ this->m_scratch_path.data( )[ size - 2 ] };
+		const auto y0{ this->m_scratch_path.data( )[ size - 1 ] };
+		detail::flatten_cubic( this->m_scratch_path, x0, y0, x1, y1, x2, y2, x3, y3, std::max( tolerance, 0.01f ), 0 );
+	}
 
-		idx[ 0 ] = vtx_base + 0; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-		idx[ 3 ] = vtx_base + 0; idx[ 4 ] = vtx_base + 3; idx[ 5 ] = vtx_base + 4;
-		idx[ 6 ] = vtx_base + 0; idx[ 7 ] = vtx_base + 4; idx[ 8 ] = vtx_base + 1;
-		idx[ 9 ] = vtx_base + 1; idx[ 10 ] = vtx_base + 4; idx[ 11 ] = vtx_base + 5;
-		idx[ 12 ] = vtx_base + 1; idx[ 13 ] = vtx_base + 5; idx[ 14 ] = vtx_base + 2;
-		idx[ 15 ] = vtx_base + 2; idx[ 16 ] = vtx_base + 5; idx[ 17 ] = vtx_base + 3;
-		idx[ 18 ] = vtx_base + 2; idx[ 19 ] = vtx_base + 3; idx[ 20 ] = vtx_base + 0;
+	void draw_list::path_fill( rgba color )
+	{
+		this->add_concave_poly_filled( this->m_scratch_path.span( ), color );
+		this->m_scratch_path.clear( );
+	}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 21u;
+	void draw_list::path_stroke( rgba color, bool closed, float thickness )
+	{
+		this->add_polyline( this->m_scratch_path.span( ), color, closed, thickness );
+		this->m_scratch_path.clear( );
 	}
 
 	void draw_list::add_circle( float x, float y, float radius, rgba color, int segments, float thickness )
@@ -1394,56 +4139,23 @@ namespace zdraw {
 
 	void draw_list::add_circle_filled( float x, float y, float radius, rgba color, int segments )
 	{
-		this->ensure_draw_cmd( nullptr );
-
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-
-		constexpr auto aa_fringe{ 1.0f };
-		const auto inner_radius = radius - aa_fringe * 0.5f;
-		const auto outer_radius = radius + aa_fringe * 0.5f;
-
-		auto transparent = color;
-		transparent.a = 0;
-
-		this->push_vertex( x, y, 0.5f, 0.5f, color );
-
-		const auto angle_increment{ 2.0f * std::numbers::pi_v<float> / static_cast< float >( segments ) };
-
-		for ( int i{ 0 }; i < segments; ++i )
+		if ( segments <= 0 ) [[unlikely]]
 		{
-			const auto angle{ angle_increment * static_cast< float >( i ) };
-			const auto cos_a = std::cos( angle );
-			const auto sin_a = std::sin( angle );
-
-			this->push_vertex( x + cos_a * inner_radius, y + sin_a * inner_radius, 0.5f, 0.5f, color );
-			this->push_vertex( x + cos_a * outer_radius, y + sin_a * outer_radius, 0.5f, 0.5f, transparent );
+			return;
 		}
 
-		const auto tri_count = segments * 3;
-		auto idx = this->m_indices.allocate( static_cast< std::size_t >( tri_count ) * 3u );
-
-		for ( int i = 0; i < segments; ++i )
-		{
-			const auto next = ( i + 1 ) % segments;
-
-			const auto curr_inner = vtx_base + 1 + static_cast< std::uint32_t >( i * 2 );
-			const auto curr_outer = vtx_base + 2 + static_cast< std::uint32_t >( i * 2 );
-			const auto next_inner = vtx_base + 1 + static_cast< std::uint32_t >( next * 2 );
-			const auto next_outer = vtx_base + 2 + static_cast< std::uint32_t >( next * 2 );
+		const auto tri_count{ static_cast< std::uint32_t >( segments ) * 3u };
 
-			const auto base_idx = i * 9;
-			idx[ base_idx + 0 ] = vtx_base;
-			idx[ base_idx + 1 ] = curr_inner;
-			idx[ base_idx + 2 ] = next_inner;
-			idx[ base_idx + 3 ] = curr_inner;
-			idx[ base_idx + 4 ] = curr_outer;
-			idx[ base_idx + 5 ] = next_outer;
-			idx[ base_idx + 6 ] = curr_inner;
-			idx[ base_idx + 7 ] = next_outer;
-			idx[ base_idx + 8 ] = next_inner;
-		}
+		this->emit_prim( nullptr, 1u + static_cast< std::uint32_t >( segments ) * 2u, tri_count * 3u, [ = ]( prim_writer& writer )
+			{
+				const auto angle_increment{ 2.0f * std::numbers::pi_v<float> / static_cast< float >( segments ) };
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += static_cast< std::uint32_t >( tri_count ) * 3u;
+				detail::emit_circle_filled( writer, x, y, radius, color, segments, [ angle_increment ]( int i )
+					{
+						const auto angle{ angle_increment * static_cast< float >( i ) };
+						return std::array{ std::cos( angle ), std::sin( angle ) };
+					} );
+			} );
 	}
 
 	void draw_list::add_arc( float x, float y, float radius, float start_angle, float end_angle, rgba color, int segments, float thickness )
@@ -1478,57 +4190,232 @@ namespace zdraw {
 			segments = 3;
 		}
 
-		this->ensure_draw_cmd( nullptr );
+		const auto tri_count{ static_cast< std::uint32_t >( segments ) * 3u };
 
-		const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
-		const auto angle_range{ end_angle - start_angle };
-		const auto angle_increment{ angle_range / static_cast< float >( segments ) };
+		this->emit_prim( nullptr, 1u + static_cast< std::uint32_t >( segments + 1 ) * 2u, tri_count * 3u, [ = ]( prim_writer& writer )
+			{
+				const auto vtx_base{ writer.m_vtx_index };
+				const auto angle_range{ end_angle - start_angle };
+				const auto angle_increment{ angle_range / static_cast< float >( segments ) };
+
+				constexpr auto aa_fringe{ 1.0f };
+				const auto inner_radius = radius - aa_fringe * 0.5f;
+				const auto outer_radius = radius + aa_fringe * 0.5f;
+
+				auto transparent = color;
+				transparent.a = 0;
+
+				writer.push_vertex( x, y, 0.5f, 0.5f, color );
+
+				for ( int i{ 0 }; i <= segments; ++i )
+				{
+					const auto angle{ start_angle + angle_increment * static_cast< float >( i ) };
+					const auto cos_a = std::cos( angle );
+					const auto sin_a = std::sin( angle );
+
+					writer.push_vertex( x + cos_a * inner_radius, y + sin_a * inner_radius, 0.5f, 0.5f, color );
+					writer.push_vertex( x + cos_a * outer_radius, y + sin_a * outer_radius, 0.5f, 0.5f, transparent );
+				}
+
+				auto idx_data{ writer.m_idx };
+
+				for ( int i{ 0 }; i < segments; ++i )
+				{
+					const auto curr_inner = vtx_base + 1 + static_cast< std::uint32_t >( i * 2 );
+					const auto curr_outer = vtx_base + 2 + static_cast< std::uint32_t >( i * 2 );
+					const auto next_inner = vtx_base + 1 + static_cast< std::uint32_t >( ( i + 1 ) * 2 );
+					const auto next_outer = vtx_base + 2 + static_cast< std::uint32_t >( ( i + 1 ) * 2 );
+
+					const auto base_idx = i * 9;
+					idx_data[ base_idx + 0 ] = vtx_base;
+					idx_data[ base_idx + 1 ] = curr_inner;
+					idx_data[ base_idx + 2 ] = next_inner;
+					idx_data[ base_idx + 3 ] = curr_inner;
+					idx_data[ base_idx + 4 ] = curr_outer;
+					idx_data[ base_idx + 5 ] = next_outer;
+					idx_data[ base_idx + 6 ] = curr_inner;
+					idx_data[ base_idx + 7 ] = next_outer;
+					idx_data[ base_idx + 8 ] = next_inner;
+				}
+			} );
+	}
+
+	void draw_list::add_rects_filled( std::span<const rect_instance> rects )
+	{
+		const auto data{ this->retain( rects ) };
+
+		this->emit_instances( nullptr, data.size( ), 4u, 6u, [ data ]( prim_writer& writer, std::size_t i )
+			{
+				const auto& r{ data[ i ] };
+				detail::emit_rect_filled( writer, r.m_x, r.m_y, r.m_w, r.m_h, r.m_color );
+			} );
+	}
+
+	void draw_list::add_rects_filled( const rect_instances_soa& rects )
+	{
+		const auto count{ detail::soa_count( { rects.m_x.size( ), rects.m_y.size( ), rects.m_w.size( ), rects.m_h.size( ) }, rects.m_color.size( ) ) };
+		if ( count == 0u )
+		{
+			return;
+		}
+
+		const auto x{ this->retain( rects.m_x.first( count ) ) };
+		const auto y{ this->retain( rects.m_y.first( count ) ) };
+		const auto w{ this->retain( rects.m_w.first( count ) ) };
+		const auto h{ this->retain( rects.m_h.first( count ) ) };
+		const auto color{ this->retain( rects.m_color.first( std::min( rects.m_color.size( ), count ) ) ) };
+
+		this->emit_instances( nullptr, count, 4u, 6u, [ = ]( prim_writer& writer, std::size_t i )
+			{
+				detail::emit_rect_filled( writer, x[ i ], y[ i ], w[ i ], h[ i ], detail::instance_color( color, i ) );
+			} );
+	}
+
+	void draw_list::add_circles_filled( std::span<const circle_instance> circles, int segments )
+	{
+		if ( segments <= 0 || circles.empty( ) ) [[unlikely]]
+		{
+			return;
+		}
+
+		const auto data{ this->retain( circles ) };
+		const auto unit_circle{ detail::make_unit_circle( segments ) };
+		const auto idx_per_circle{ static_cast< std::uint32_t >( segments ) * 9u };
+
+		this->emit_instances( nullptr, data.size( ), 1u + static_cast< std::uint32_t >( segments ) * 2u, idx_per_circle, [ = ]( prim_writer& writer, std::size_t i )
+			{
+				const auto& c{ data[ i ] };
+				detail::emit_circle_filled( writer, c.m_x, c.m_y, c.m_radius, c.m_color, segments, [ unit_circle ]( int k )
+					{
+						return std::array{ unit_circle[ k * 2 ], unit_circle[ k * 2 + 1 ] };
+					} );
+				writer.m_idx += idx_per_circle;
+			} );
+	}
+
+	void draw_list::add_circles_filled( const circle_instances_soa& circles, int segments )
+	{
+		const auto count{ detail::soa_count( { circles.m_x.size( ), circles.m_y.size( ), circles.m_radius.size( ) }, circles.m_color.size( ) ) };
+		if ( segments <= 0 || count == 0u ) [[unlikely]]
+		{
+			return;
+		}
+
+		const auto x{ this->retain( circles.m_x.first( count ) ) };
+		const auto y{ this->retain( circles.m_y.first( count ) ) };
+		const auto radius{ this->retain( circles.m_radius.first( count ) ) };
+		const auto color{ this->retain( circles.m_color.first( std::min( circles.m_color.size( ), count ) ) ) };
+		const auto unit_circle{ detail::make_unit_circle( segments ) };
+		const auto idx_per_circle{ static_cast< std::uint32_t >( segments ) * 9u };
+
+		this->emit_instances( nullptr, count, 1u + static_cast< std::uint32_t >( segments ) * 2u, idx_per_circle, [ = ]( prim_writer& writer, std::size_t i )
+			{
+				detail::emit_circle_filled( writer, x[ i ], y[ i ], radius[ i ], detail::instance_color( color, i ), segments, [ unit_circle ]( int k )
+					{
+						return std::array{ unit_circle[ k * 2 ], unit_circle[ k * 2 + 1 ] };
+					} );
+				writer.m_idx += idx_per_circle;
+			} );
+	}
+
+	void draw_list::add_lines( std::span<const line_instance> lines, float thickness )
+	{
+		const auto data{ this->retain( lines ) };
+
+		this->emit_instances( nullptr, data.size( ), 8u, 18u, [ = ]( prim_writer& writer, std::size_t i )
+			{
+				const auto& l{ data[ i ] };
+				detail::emit_line( writer, l.m_x0, l.m_y0, l.m_x1, l.m_y1, l.m_color, thickness );
+				writer.m_idx += 18;
+			} );
+	}
+
+	void draw_list::add_lines( const line_instances_soa& lines, float thickness )
+	{
+		const auto count{ detail::soa_count( { lines.m_x0.size( ), lines.m_y0.size( ), lines.m_x1.size( ), lines.m_y1.size( ) }, lines.m_color.size( ) ) };
+		if ( count == 0u )
+		{
+			return;
+		}
+
+		const auto x0{ this->retain( lines.m_x0.first( count ) ) };
+		const auto y0{ this->retain( lines.m_y0.first( count ) ) };
+		const auto x1{ this->retain( lines.m_x1.first( count ) ) };
+		const auto y1{ this->retain( lines.m_y1.first( count ) ) };
+		const auto color{ this->retain( lines.m_color.first( std::min( lines.m_color.size( ), count ) ) ) };
+
+		this->emit_instances( nullptr, count, 8u, 18u, [ = ]( prim_writer& writer, std::size_t i )
+			{
+				detail::emit_line( writer, x0[ i ], y0[ i ], x1[ i ], y1[ i ], detail::instance_color( color, i ), thickness );
+				writer.m_idx += 18;
+			} );
+	}
+
+	void draw_list::add_text( float x, float y, std::string_view text, rgba color, const font* font )
+	{
+		if ( font == nullptr )
+		{
+			font = get_default_font( );
+		}
+
+		if ( font == nullptr || font->m_atlas == nullptr || font->m_atlas->m_texture_srv == nullptr ) [[unlikely]]
+		{
+			return;
+		}
 
-		constexpr auto aa_fringe{ 1.0f };
-		const auto inner_radius = radius - aa_fringe * 0.5f;
-		const auto outer_radius = radius + aa_fringe * 0.5f;
+		const auto quad_count{ detail::count_glyph_quads( *font, text ) };
+		if ( quad_count == 0u )
+		{
+			return;
+		}
 
-		auto transparent = color;
-		transparent.a = 0;
+		const auto retained{ this->retain( text ) };
 
-		this->push_vertex( x, y, 0.5f, 0.5f, color );
+		this->emit_prim( font->m_atlas->m_texture_srv.Get( ), quad_count * 4u, quad_count * 6u, [ = ]( prim_writer& writer )
+			{
+				auto current_x{ std::floor( x ) };
+				auto current_y{ std::floor( y + font->m_ascent ) };
 
-		for ( int i{ 0 }; i <= segments; ++i )
-		{
-			const auto angle{ start_angle + angle_increment * static_cast< float >( i ) };
-			const auto cos_a = std::cos( angle );
-			const auto sin_a = std::sin( angle );
+				for ( char c : retained )
+				{
+					if ( c == '\n' )
+					{
+						current_x = std::floor( x );
+						current_y += font->m_line_height;
+						continue;
+					}
 
-			this->push_vertex( x + cos_a * inner_radius, y + sin_a * inner_radius, 0.5f, 0.5f, color );
-			this->push_vertex( x + cos_a * outer_radius, y + sin_a * outer_radius, 0.5f, 0.5f, transparent );
-		}
+					if ( c < 32 || c > 126 )
+					{
+						continue;
+					}
 
-		const auto tri_count = segments * 3;
-		auto idx_data = this->m_indices.allocate( static_cast< std::size_t >( tri_count ) * 3u );
+					const auto& glyph{ font->get_glyph( c ) };
+					if ( !glyph.m_valid )
+					{
+						continue;
+					}
 
-		for ( int i{ 0 }; i < segments; ++i )
-		{
-			const auto curr_inner = vtx_base + 1 + static_cast< std::uint32_t >( i * 2 );
-			const auto curr_outer = vtx_base + 2 + static_cast< std::uint32_t >( i * 2 );
-			const auto next_inner = vtx_base + 1 + static_cast< std::uint32_t >( ( i + 1 ) * 2 );
-			const auto next_outer = vtx_base + 2 + static_cast< std::uint32_t >( ( i + 1 ) * 2 );
+					const auto char_x{ current_x + glyph.m_quad_x0 };
+					const auto char_y{ current_y + glyph.m_quad_y0 };
+					const auto char_w{ glyph.m_quad_x1 - glyph.m_quad_x0 };
+					const auto char_h{ glyph.m_quad_y1 - glyph.m_quad_y0 };
 
-			const auto base_idx = i * 9;
-			idx_data[ base_idx + 0 ] = vtx_base;
-			idx_data[ base_idx + 1 ] = curr_inner;
-			idx_data[ base_idx + 2 ] = next_inner;
-			idx_data[ base_idx + 3 ] = curr_inner;
-			idx_data[ base_idx + 4 ] = curr_outer;
-			idx_data[ base_idx + 5 ] = next_outer;
-			idx_data[ base_idx + 6 ] = curr_inner;
-			idx_data[ base_idx + 7 ] = next_outer;
-			idx_data[ base_idx + 8 ] = next_inner;
-		}
+					if ( char_w > 0.0f && char_h > 0.0f )
+					{
+						writer.push_vertex( char_x, char_y, glyph.m_uv_x0, glyph.m_uv_y0, color );
+						writer.push_vertex( char_x + char_w, char_y, glyph.m_uv_x1, glyph.m_uv_y0, color );
+						writer.push_vertex( char_x + char_w, char_y + char_h, glyph.m_uv_x1, glyph.m_uv_y1, color );
+						writer.push_vertex( char_x, char_y + char_h, glyph.m_uv_x0, glyph.m_uv_y1, color );
+						writer.push_quad_indices( );
+					}
 
-		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += static_cast< std::uint32_t >( tri_count ) * 3u;
+					current_x += glyph.m_advance_x;
+				}
+			} );
 	}
 
-	void draw_list::add_text( float x, float y, std::string_view text, rgba color, const font* font )
+	void draw_list::add_text_effect( float x, float y, std::string_view text, rgba color, rgba effect_color, float offset_x, float offset_y, float radius, const font* font )
 	{
 		if ( font == nullptr )
 		{
@@ -1540,7 +4427,32 @@ namespace zdraw {
 			return;
 		}
 
-		this->ensure_draw_cmd( font->m_atlas->m_texture_srv.Get( ) );
+		const auto quad_count{ detail::count_glyph_quads( *font, text ) };
+		if ( quad_count == 0u )
+		{
+			return;
+		}
+
+		this->ensure_draw_cmd( font->m_atlas->m_texture_srv.Get( ), draw_kind::glyph );
+
+		radius = std::clamp( radius, 0.0f, detail::k_max_glyph_effect_reach );
+		const auto reach{ detail::k_max_glyph_effect_reach - radius };
+		offset_x = std::clamp( offset_x, -reach, reach );
+		offset_y = std::clamp( offset_y, -reach, reach );
+
+		const auto inv_width{ 1.0f / static_cast< float >( font->m_atlas->m_width ) };
+		const auto inv_height{ 1.0f / static_cast< float >( font->m_atlas->m_height ) };
+		const auto fill{ premultiply( color, this->m_blend ) };
+		const auto effect{ premultiply( effect_color, this->m_blend ) };
+
+		const auto grow_x0{ std::max( radius - offset_x, 0.0f ) };
+		const auto grow_y0{ std::max( radius - offset_y, 0.0f ) };
+		const auto grow_x1{ std::max( radius + offset_x, 0.0f ) };
+		const auto grow_y1{ std::max( radius + offset_y, 0.0f ) };
+
+		auto vtx_index{ static_cast< std::uint32_t >( this->m_sdf_vertices.size( ) ) };
+		auto vtx{ this->m_sdf_vertices.allocate( quad_count * 4u ) };
+		auto idx{ this->m_indices.allocate( quad_count * 6u ) };
 
 		auto current_x{ std::floor( x ) };
 		auto current_y{ std::floor( y + font->m_ascent ) };
@@ -1565,29 +4477,59 @@ namespace zdraw {
 				continue;
 			}
 
-			const auto char_x{ current_x + glyph.m_quad_x0 };
-			const auto char_y{ current_y + glyph.m_quad_y0 };
-			const auto char_w{ glyph.m_quad_x1 - glyph.m_quad_x0 };
-			const auto char_h{ glyph.m_quad_y1 - glyph.m_quad_y0 };
-
-			if ( char_w > 0.0f && char_h > 0.0f )
+			if ( glyph.m_quad_x1 - glyph.m_quad_x0 > 0.0f && glyph.m_quad_y1 - glyph.m_quad_y0 > 0.0f )
 			{
-				const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+				const auto x0{ current_x + glyph.m_quad_x0 - grow_x0 };
+				const auto y0{ current_y + glyph.m_quad_y0 - grow_y0 };
+				const auto x1{ current_x + glyph.m_quad_x1 + grow_x1 };
+				const auto y1{ current_y + glyph.m_quad_y1 + grow_y1 };
+
+				const auto u0{ glyph.m_uv_x0 - grow_x0 * inv_width };
+				const auto v0{ glyph.m_uv_y0 - grow_y0 * inv_height };
+				const auto u1{ glyph.m_uv_x1 + grow_x1 * inv_width };
+				const auto v1{ glyph.m_uv_y1 + grow_y1 * inv_height };
 
-				this->push_vertex( char_x, char_y, glyph.m_uv_x0, glyph.m_uv_y0, color );
-				this->push_vertex( char_x + char_w, char_y, glyph.m_uv_x1, glyph.m_uv_y0, color );
-				this->push_vertex( char_x + char_w, char_y + char_h, glyph.m_uv_x1, glyph.m_uv_y1, color );
-				this->push_vertex( char_x, char_y + char_h, glyph.m_uv_x0, glyph.m_uv_y1, color );
+				const float corners[ 4 ][ 4 ]
+				{
+					{ x0, y0, u0, v0 },
+					{ x1, y0, u1, v0 },
+					{ x1, y1, u1, v1 },
+					{ x0, y1, u0, v1 },
+				};
 
-				auto idx{ this->m_indices.allocate( 6 ) };
-				idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-				idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+				for ( const auto& corner : corners )
+				{
+					*vtx++ = sdf_vertex
+					{
+						{ corner[ 0 ], corner[ 1 ] },
+						{ corner[ 2 ], corner[ 3 ] },
+						{ offset_x * inv_width, offset_y * inv_height, radius * inv_width, radius * inv_height },
+						0.0f,
+						fill,
+						effect
+					};
+				}
 
-				this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+				idx[ 0 ] = vtx_index; idx[ 1 ] = vtx_index + 1; idx[ 2 ] = vtx_index + 2;
+				idx[ 3 ] = vtx_index; idx[ 4 ] = vtx_index + 2; idx[ 5 ] = vtx_index + 3;
+				idx += 6;
+				vtx_index += 4u;
 			}
 
 			current_x += glyph.m_advance_x;
 		}
+
+		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += quad_count * 6u;
+	}
+
+	void draw_list::add_text_outlined( float x, float y, std::string_view text, rgba color, rgba outline_color, float thickness, const font* font )
+	{
+		this->add_text_effect( x, y, text, color, outline_color, 0.0f, 0.0f, thickness, font );
+	}
+
+	void draw_list::add_text_shadowed( float x, float y, std::string_view text, rgba color, rgba shadow_color, float offset_x, float offset_y, const font* font )
+	{
+		this->add_text_effect( x, y, text, color, shadow_color, offset_x, offset_y, 0.0f, font );
 	}
 
 	void draw_list::add_text_multi_color( float x, float y, std::string_view text, rgba color_tl, rgba color_tr, rgba color_br, rgba color_bl, const font* font )
@@ -1602,11 +4544,6 @@ namespace zdraw {
 			return;
 		}
 
-		this->ensure_draw_cmd( font->m_atlas->m_texture_srv.Get( ) );
-
-		auto current_x{ x };
-		auto current_y{ y + font->m_ascent };
-
 		auto text_width{ 0.0f };
 		auto text_height = font->m_line_height;
 
@@ -1643,124 +4580,264 @@ namespace zdraw {
 			return;
 		}
 
-		const auto min_x = x;
-		const auto max_x = x + text_width;
-		const auto min_y = y;
-		const auto max_y = y + text_height;
+		const auto quad_count{ detail::count_glyph_quads( *font, text ) };
+		if ( quad_count == 0u )
+		{
+			return;
+		}
+
+		const auto retained{ this->retain( text ) };
 
-		auto lerp_color = [ ]( const rgba& a, const rgba& b, float t ) -> rgba
+		this->emit_prim( font->m_atlas->m_texture_srv.Get( ), quad_count * 4u, quad_count * 6u, [ = ]( prim_writer& writer )
 			{
-				return rgba
+				auto current_x{ x };
+				auto current_y{ y + font->m_ascent };
+
+				const auto min_x = x;
+				const auto min_y = y;
+
+				auto lerp_color = [ ]( const rgba& a, const rgba& b, float t ) -> rgba
+					{
+						return rgba
+						{
+							static_cast< std::uint8_t >( a.r + ( b.r - a.r ) * t ),
+							static_cast< std::uint8_t >( a.g + ( b.g - a.g ) * t ),
+							static_cast< std::uint8_t >( a.b + ( b.b - a.b ) * t ),
+							static_cast< std::uint8_t >( a.a + ( b.a - a.a ) * t )
+						};
+					};
+
+				auto get_color_at = [ & ]( float px, float py ) -> rgba
+					{
+						const auto tx = ( px - min_x ) / text_width;
+						const auto ty = ( py - min_y ) / text_height;
+						const auto color_top = lerp_color( color_tl, color_tr, tx );
+						const auto color_bottom = lerp_color( color_bl, color_br, tx );
+						return lerp_color( color_top, color_bottom, ty );
+					};
+
+				for ( char c : retained )
 				{
-					static_cast< std::uint8_t >( a.r + ( b.r - a.r ) * t ),
-					static_cast< std::uint8_t >( a.g + ( b.g - a.g ) * t ),
-					static_cast< std::uint8_t >( a.b + ( b.b - a.b ) * t ),
-					static_cast< std::uint8_t >( a.a + ( b.a - a.a ) * t )
-				};
-			};
+					if ( c == '\n' )
+					{
+						current_x = x;
+						current_y += font->m_line_height;
+						continue;
+					}
+
+					if ( c < 32 || c > 126 )
+					{
+						continue;
+					}
+
+					const auto& glyph{ font->get_glyph( c ) };
+					if ( !glyph.m_valid )
+					{
+						continue;
+					}
+
+					const auto char_x{ current_x + glyph.m_quad_x0 };
+					const auto char_y{ current_y + glyph.m_quad_y0 };
+					const auto char_w{ glyph.m_quad_x1 - glyph.m_quad_x0 };
+					const auto char_h{ glyph.m_quad_y1 - glyph.m_quad_y0 };
+
+					if ( char_w > 0.0f && char_h > 0.0f )
+					{
+						const auto color_char_tl = get_color_at( char_x, char_y );
+						const auto color_char_tr = get_color_at( char_x + char_w, char_y );
+						const auto color_char_br = get_color_at( char_x + char_w, char_y + char_h );
+						const auto color_char_bl = get_color_at( char_x, char_y + char_h );
+
+						writer.push_vertex( char_x, char_y, glyph.m_uv_x0, glyph.m_uv_y0, color_char_tl );
+						writer.push_vertex( char_x + char_w, char_y, glyph.m_uv_x1, glyph.m_uv_y0, color_char_tr );
+						writer.push_vertex( char_x + char_w, char_y + char_h, glyph.m_uv_x1, glyph.m_uv_y1, color_char_br );
+						writer.push_vertex( char_x, char_y + char_h, glyph.m_uv_x0, glyph.m_uv_y1, color_char_bl );
+						writer.push_quad_indices( );
+					}
+
+					current_x += glyph.m_advance_x;
+				}
+			} );
+	}
+
+	void draw_list::add_sdf_shape( const sdf_shape& shape, rgba color )
+	{
+		if ( shape.m_half_width <= 0.0f || shape.m_half_height <= 0.0f ) [[unlikely]]
+		{
+			return;
+		}
+
+		this->ensure_draw_cmd( nullptr, draw_kind::sdf );
+
+		const auto radius{ std::clamp( shape.m_radius, 0.0f, std::min( shape.m_half_width, shape.m_half_height ) ) };
+		const auto margin{ std::max( shape.m_softness, 1.0f ) * 0.5f + 1.0f };
+		const auto extent_x{ shape.m_half_width + margin };
+		const auto extent_y{ shape.m_half_height + margin };
+
+		const float corners[ 4 ][ 2 ]
+		{
+			{ -extent_x, -extent_y },
+			{ extent_x, -extent_y },
+			{ extent_x, extent_y },
+			{ -extent_x, extent_y },
+		};
 
-		auto get_color_at = [ & ]( float px, float py ) -> rgba
+		const auto vtx_base{ static_cast< std::uint32_t >( this->m_sdf_vertices.size( ) ) };
+		const auto premultiplied{ premultiply( color, this->m_blend ) };
+		auto vtx{ this->m_sdf_vertices.allocate( 4 ) };
+
+		for ( int i{ 0 }; i < 4; ++i )
+		{
+			vtx[ i ] = sdf_vertex
 			{
-				const auto tx = ( px - min_x ) / text_width;
-				const auto ty = ( py - min_y ) / text_height;
-				const auto color_top = lerp_color( color_tl, color_tr, tx );
-				const auto color_bottom = lerp_color( color_bl, color_br, tx );
-				return lerp_color( color_top, color_bottom, ty );
+				{ shape.m_center_x + corners[ i ][ 0 ], shape.m_center_y + corners[ i ][ 1 ] },
+				{ corners[ i ][ 0 ], corners[ i ][ 1 ] },
+				{ shape.m_half_width, shape.m_half_height, radius, std::max( shape.m_thickness, 0.0f ) },
+				shape.m_softness,
+				premultiplied
 			};
+		}
 
-		for ( char c : text )
+		auto idx{ this->m_indices.allocate( 6 ) };
+		idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
+		idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+
+		this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+	}
+
+	void draw_list::add_rect_rounded( float x, float y, float w, float h, float radius, rgba color, float thickness )
+	{
+		if ( thickness <= 0.0f )
 		{
-			if ( c == '\n' )
-			{
-				current_x = x;
-				current_y += font->m_line_height;
-				continue;
-			}
+			return;
+		}
 
-			if ( c < 32 || c > 126 )
+		this->add_sdf_shape( { x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f, radius, thickness, 0.0f }, color );
+	}
+
+	void draw_list::add_rect_rounded_filled( float x, float y, float w, float h, float radius, rgba color )
+	{
+		this->add_sdf_shape( { x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f, radius, 0.0f, 0.0f }, color );
+	}
+
+	void draw_list::add_disc( float x, float y, float radius, rgba color )
+	{
+		this->add_sdf_shape( { x, y, radius, radius, radius, 0.0f, 0.0f }, color );
+	}
+
+	void draw_list::add_ring( float x, float y, float radius, rgba color, float thickness )
+	{
+		if ( thickness <= 0.0f )
+		{
+			return;
+		}
+
+		this->add_sdf_shape( { x, y, radius, radius, radius, thickness, 0.0f }, color );
+	}
+
+	void draw_list::add_pill( float x, float y, float w, float h, rgba color )
+	{
+		this->add_sdf_shape( { x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f, std::min( w, h ) * 0.5f, 0.0f, 0.0f }, color );
+	}
+
+	void draw_list::add_shadow( float x, float y, float w, float h, float radius, float blur, rgba color )
+	{
+		this->add_sdf_shape( { x + w * 0.5f, y + h * 0.5f, w * 0.5f, h * 0.5f, radius, 0.0f, std::max( blur, 0.0f ) }, color );
+	}
+
+	bool text_size_table::find( std::uint64_t key, std::size_t length, float& width, float& height ) const noexcept
+	{
+		for ( std::size_t probe{ 0 }; probe < k_max_probes; ++probe )
+		{
+			const auto& entry{ this->m_slots[ ( key + probe ) & ( k_slot_count - 1u ) ] };
+
+			const auto observed{ entry.m_key.load( std::memory_order_acquire ) };
+			if ( observed == k_empty_key )
 			{
-				continue;
+				return false;
 			}
 
-			const auto& glyph{ font->get_glyph( c ) };
-			if ( !glyph.m_valid )
+			if ( observed != key )
 			{
 				continue;
 			}
 
-			const auto char_x{ current_x + glyph.m_quad_x0 };
-			const auto char_y{ current_y + glyph.m_quad_y0 };
-			const auto char_w{ glyph.m_quad_x1 - glyph.m_quad_x0 };
-			const auto char_h{ glyph.m_quad_y1 - glyph.m_quad_y0 };
+			const auto size{ entry.m_size.load( std::memory_order_relaxed ) };
+			const auto stored_length{ entry.m_length.load( std::memory_order_relaxed ) };
+			std::atomic_thread_fence( std::memory_order_acquire );
 
-			if ( char_w > 0.0f && char_h > 0.0f )
+			if ( entry.m_key.load( std::memory_order_relaxed ) != key || stored_length != length )
 			{
-				const auto vtx_base{ static_cast< std::uint32_t >( this->m_vertices.size( ) ) };
+				return false;
+			}
+
+			width = std::bit_cast< float >( static_cast< std::uint32_t >( size ) );
+			height = std::bit_cast< float >( static_cast< std::uint32_t >( size >> 32 ) );
+			return true;
+		}
 
-				const auto color_char_tl = get_color_at( char_x, char_y );
-				const auto color_char_tr = get_color_at( char_x + char_w, char_y );
-				const auto color_char_br = get_color_at( char_x + char_w, char_y + char_h );
-				const auto color_char_bl = get_color_at( char_x, char_y + char_h );
+		return false;
+	}
 
-				this->push_vertex( char_x, char_y, glyph.m_uv_x0, glyph.m_uv_y0, color_char_tl );
-				this->push_vertex( char_x + char_w, char_y, glyph.m_uv_x1, glyph.m_uv_y0, color_char_tr );
-				this->push_vertex( char_x + char_w, char_y + char_h, glyph.m_uv_x1, glyph.m_uv_y1, color_char_br );
-				this->push_vertex( char_x, char_y + char_h, glyph.m_uv_x0, glyph.m_uv_y1, color_char_bl );
+	void text_size_table::publish( std::uint64_t key, std::size_t length, float width, float height ) noexcept
+	{
+		auto* target{ &this->m_slots[ key & ( k_slot_count - 1u ) ] };
 
-				auto idx{ this->m_indices.allocate( 6 ) };
-				idx[ 0 ] = vtx_base; idx[ 1 ] = vtx_base + 1; idx[ 2 ] = vtx_base + 2;
-				idx[ 3 ] = vtx_base; idx[ 4 ] = vtx_base + 2; idx[ 5 ] = vtx_base + 3;
+		for ( std::size_t probe{ 0 }; probe < k_max_probes; ++probe )
+		{
+			auto& entry{ this->m_slots[ ( key + probe ) & ( k_slot_count - 1u ) ] };
 
-				this->m_commands.data( )[ this->m_commands.size( ) - 1 ].m_idx_count += 6u;
+			const auto observed{ entry.m_key.load( std::memory_order_relaxed ) };
+			if ( observed == k_empty_key || observed == key )
+			{
+				target = &entry;
+				break;
 			}
+		}
 
-			current_x += glyph.m_advance_x;
+		auto observed{ target->m_key.load( std::memory_order_relaxed ) };
+		if ( observed == k_busy_key || !target->m_key.compare_exchange_strong( observed, k_busy_key, std::memory_order_relaxed ) )
+		{
+			return;
 		}
+
+		std::atomic_thread_fence( std::memory_order_release );
+		target->m_size.store( static_cast< std::uint64_t >( std::bit_cast< std::uint32_t >( width ) ) | static_cast< std::uint64_t >( std::bit_cast< std::uint32_t >( height ) ) << 32, std::memory_order_relaxed );
+		target->m_length.store( length, std::memory_order_relaxed );
+		target->m_key.store( key, std::memory_order_release );
 	}
 
-	const glyph_cache_entry& font::get_glyph( char c ) const
+	void text_size_table::clear( ) noexcept
 	{
-		const auto it{ this->m_glyph_cache.find( c ) };
-		if ( it != this->m_glyph_cache.end( ) )
+		for ( auto& entry : this->m_slots )
 		{
-			return it->second;
+			auto observed{ entry.m_key.load( std::memory_order_relaxed ) };
+			if ( observed != k_empty_key && observed != k_busy_key )
+			{
+				entry.m_key.compare_exchange_strong( observed, k_empty_key, std::memory_order_relaxed );
+			}
 		}
+	}
 
-		auto& entry{ this->m_glyph_cache[ c ] };
+	const baked_glyph& font::get_glyph( char c ) const noexcept
+	{
+		static constexpr baked_glyph k_missing{};
 
 		const auto char_index{ static_cast< int >( c ) - 32 };
-		if ( char_index < 0 || char_index >= 95 )
+		if ( char_index < 0 || char_index >= static_cast< int >( this->m_glyphs.size( ) ) )
 		{
-			entry.m_valid = false;
-			return entry;
+			return k_missing;
 		}
 
-		const auto& info{ this->m_glyph_info[ char_index ] };
-		const float inv_width{ 1.0f / static_cast< float >( this->m_atlas->m_width ) };
-		const float inv_height{ 1.0f / static_cast< float >( this->m_atlas->m_height ) };
-
-		entry.m_advance_x = info.m_advance_x;
-		entry.m_quad_x0 = info.m_bearing_x;
-		entry.m_quad_y0 = -info.m_bearing_y;
-		entry.m_quad_x1 = info.m_bearing_x + info.m_width;
-		entry.m_quad_y1 = -info.m_bearing_y + info.m_height;
-		entry.m_uv_x0 = info.m_atlas_x * inv_width;
-		entry.m_uv_y0 = info.m_atlas_y * inv_height;
-		entry.m_uv_x1 = ( info.m_atlas_x + info.m_width ) * inv_width;
-		entry.m_uv_y1 = ( info.m_atlas_y + info.m_height ) * inv_height;
-
-		entry.m_valid = true;
-
-		return entry;
+		return this->m_glyphs[ static_cast< std::size_t >( char_index ) ];
 	}
 
 	void font::calc_text_size( std::string_view text, float& width, float& height ) const
 	{
-		const auto it{ this->m_text_size_cache.find( text ) };
-		if ( it != this->m_text_size_cache.end( ) )
+		const auto key{ std::max( detail::hash_bytes( std::as_bytes( std::span{ text } ) ), text_size_table::k_busy_key + 1u ) };
+
+		if ( this->m_text_sizes.find( key, text.size( ), width, height ) )
 		{
-			width = it->second.first;
-			height = it->second.second;
 			return;
 		}
 
@@ -1806,13 +4883,12 @@ namespace zdraw {
 
 		width = std::floor( width + 0.99999f );
 
-		this->m_text_size_cache[ std::string( text ) ] = std::make_pair( width, height );
+		this->m_text_sizes.publish( key, text.size( ), width, height );
 	}
 
 	void font::clear_caches( ) const noexcept
 	{
-		this->m_glyph_cache.clear( );
-		this->m_text_size_cache.clear( );
+		this->m_text_sizes.clear( );
 	}
 
 	bool initialize( ID3D11Device* device, ID3D11DeviceContext* context )
@@ -1832,6 +4908,12 @@ namespace zdraw {
 			return false;
 		}
 
+		if ( !detail::create_sdf_shaders( ) )
+		{
+			std::printf( "failed to create sdf shaders\n" );
+			return false;
+		}
+
 		if ( !detail::create_render_states( ) )
 		{
 			std::printf( "failed to create render states\n" );
@@ -1857,423 +4939,628 @@ namespace zdraw {
 		}
 
 		{
-			for ( auto& dl : detail::g_render.m_draw_lists )
+			for ( auto& slot : detail::g_render.m_frames )
 			{
-				dl.reserve( 5000u, 10000u, 256u );
+				for ( auto& dl : slot.m_draw_lists )
+				{
+					dl.reserve( 5000u, 10000u, 256u );
+				}
 			}
 
-			detail::g_render.m_default_font = detail::create_font( { std::span( reinterpret_cast< const std::byte* >( fonts::inter ), sizeof( fonts::inter ) ) }, 15.0f, 512, 512 );
-			detail::g_render.m_font_stack.push_back( detail::g_render.m_default_font );
-		}
+			detail::g_render.m_default_font = detail::create_font( { std::span( reinterpret_cast< const std::byte* >( fonts::inter ), sizeof( fonts::inter ) ) }, 15.0f, 512, 512 );
+			detail::g_render.m_font_stack.push_back( detail::g_render.m_default_font );
+		}
+
+		{
+			QueryPerformanceFrequency( &detail::g_render.m_performance_frequency );
+			QueryPerformanceCounter( &detail::g_render.m_last_frame_time );
+			detail::g_render.m_delta_time = 0.0f;
+			detail::g_render.m_framerate = 0.0f;
+		}
+
+		detail::refresh_display_size( );
+
+		return true;
+	}
+
+	bool begin_frame_build( )
+	{
+		auto& d{ detail::g_render };
+
+		if ( !detail::acquire_build_slot( ) )
+		{
+			return false;
+		}
+
+		auto& slot{ d.m_frames[ d.m_build_slot ] };
+		detail::t_frame_arena = &slot.m_frame_arena;
+
+		LARGE_INTEGER current_time{};
+		QueryPerformanceCounter( &current_time );
+
+		const auto delta_ticks{ current_time.QuadPart - d.m_last_frame_time.QuadPart };
+		const auto delta_time{ std::min( static_cast< float >( delta_ticks ) / static_cast< float >( d.m_performance_frequency.QuadPart ), 0.1f ) };
+		d.m_delta_time.store( delta_time, std::memory_order_relaxed );
+		d.m_last_frame_time = current_time;
+
+		if ( delta_time > 0.0f )
+		{
+			const auto instantaneous_fps{ 1.0f / delta_time };
+			d.m_framerate.store( d.m_framerate.load( std::memory_order_relaxed ) * ( 1.0f - d.k_framerate_smoothing ) + instantaneous_fps * d.k_framerate_smoothing, std::memory_order_relaxed );
+		}
+
+		const auto [display_w, display_h] { get_display_size( ) };
+		const auto pos_scale{ vertex_traits<vertex>::select_pos_scale( static_cast< float >( std::max( display_w, display_h ) ) ) };
+
+		for ( auto& dl : slot.m_draw_lists )
+		{
+			dl.clear( );
+			dl.trim( );
+			dl.m_deferred = d.m_deferred_tessellation.load( std::memory_order_relaxed );
+			dl.m_cull_occluded = d.m_occlusion_culling.load( std::memory_order_relaxed );
+			dl.m_pos_scale = pos_scale;
+		}
+
+		slot.m_frame_arena.reset( );
+		slot.m_invalidated = false;
+
+		++d.m_frame_index;
+		d.m_active_region = detail::active_region{};
+		slot.m_retired_targets.clear( );
+		detail::evict_cached_regions( );
+
+		return true;
+	}
+
+	void end_frame_build( )
+	{
+		auto& d{ detail::g_render };
+
+		for ( auto& dl : d.m_frames[ d.m_build_slot ].m_draw_lists )
+		{
+			dl.merge( );
+			dl.flush_deferred( );
+		}
+
+		detail::publish_build_slot( );
+	}
+
+	frame_status submit_frame( )
+	{
+		auto slot{ detail::acquire_submit_slot( ) };
+		if ( slot == nullptr )
+		{
+			return frame_status::unchanged;
+		}
+
+		detail::prepare_submit( );
+
+		const auto status{ detail::submit_draw_lists( *slot ) };
+		detail::release_submit_slot( *slot );
+		return status;
+	}
+
+	void stop_frame_pipeline( ) noexcept
+	{
+		auto& d{ detail::g_render };
+
+		{
+			std::scoped_lock lock{ d.m_frame_mutex };
+			d.m_frames_stopped = true;
+		}
+
+		d.m_frame_cv.notify_all( );
+	}
+
+	void begin_frame( )
+	{
+		detail::prepare_submit( );
+		( void )begin_frame_build( );
+	}
+
+	frame_status end_frame( )
+	{
+		end_frame_build( );
+
+		auto slot{ detail::acquire_submit_slot( ) };
+		if ( slot == nullptr ) [[unlikely]]
+		{
+			return frame_status::unchanged;
+		}
+
+		const auto status{ detail::submit_draw_lists( *slot ) };
+		detail::release_submit_slot( *slot );
+		return status;
+	}
+
+	draw_list& get_draw_list( draw_layer layer ) noexcept
+	{
+		auto& d{ detail::g_render };
+		return d.m_frames[ d.m_build_slot ].m_draw_lists[ static_cast< int >( layer ) ];
+	}
+
+	void set_deferred_tessellation( bool enabled ) noexcept
+	{
+		detail::g_render.m_deferred_tessellation.store( enabled, std::memory_order_relaxed );
+	}
+
+	bool get_deferred_tessellation( ) noexcept
+	{
+		return detail::g_render.m_deferred_tessellation.load( std::memory_order_relaxed );
+	}
+
+	void set_skip_unchanged_frames( bool enabled ) noexcept
+	{
+		detail::g_render.m_skip_unchanged_frames.store( enabled, std::memory_order_relaxed );
+		detail::g_render.m_frame_hash_valid = false;
+	}
+
+	bool get_skip_unchanged_frames( ) noexcept
+	{
+		return detail::g_render.m_skip_unchanged_frames.load( std::memory_order_relaxed );
+	}
+
+	void invalidate_frame( ) noexcept
+	{
+		detail::g_render.m_frame_hash_valid = false;
+	}
 
+	void invalidate_texture( ID3D11ShaderResourceView* view )
+	{
+		if ( view )
 		{
-			QueryPerformanceFrequency( &detail::g_render.m_performance_frequency );
-			QueryPerformanceCounter( &detail::g_render.m_last_frame_time );
-			detail::g_render.m_delta_time = 0.0f;
-			detail::g_render.m_framerate = 0.0f;
+			detail::bump_texture_generation( view );
 		}
+	}
 
-		return true;
+	void set_occlusion_culling( bool enabled ) noexcept
+	{
+		detail::g_render.m_occlusion_culling.store( enabled, std::memory_order_relaxed );
 	}
 
-	void begin_frame( )
+	void set_deferred_contexts( bool enabled ) noexcept
 	{
-		auto& d{ detail::g_render };
+		detail::g_render.m_deferred_contexts.store( enabled, std::memory_order_relaxed );
+	}
 
-		LARGE_INTEGER current_time{};
-		QueryPerformanceCounter( &current_time );
+	bool get_deferred_contexts( ) noexcept
+	{
+		return detail::g_render.m_deferred_contexts.load( std::memory_order_relaxed );
+	}
 
-		const auto delta_ticks{ current_time.QuadPart - d.m_last_frame_time.QuadPart };
-		d.m_delta_time = static_cast< float >( delta_ticks ) / static_cast< float >( d.m_performance_frequency.QuadPart );
-		d.m_delta_time = std::min( d.m_delta_time, 0.1f );
-		d.m_last_frame_time = current_time;
+	bool get_occlusion_culling( ) noexcept
+	{
+		return detail::g_render.m_occlusion_culling.load( std::memory_order_relaxed );
+	}
 
-		if ( d.m_delta_time > 0.0f )
-		{
-			const auto instantaneous_fps{ 1.0f / d.m_delta_time };
-			d.m_framerate = d.m_framerate * ( 1.0f - d.k_framerate_smoothing ) + instantaneous_fps * d.k_framerate_smoothing;
-		}
+	occlusion_stats get_occlusion_stats( ) noexcept
+	{
+		std::scoped_lock lock{ detail::g_render.m_frame_mutex };
+		return detail::g_render.m_occlusion_stats;
+	}
 
-		for ( auto& dl : d.m_draw_lists )
+	void begin_cached_region( std::uint64_t id, float x, float y, float w, float h, draw_layer layer )
+	{
+		auto& region{ detail::g_render.m_active_region };
+		if ( region.m_list != nullptr )
 		{
-			dl.clear( );
+			++region.m_nested;
+			return;
 		}
 
-		d.m_state_cache.reset_frame( );
+		auto& dl{ get_draw_list( layer ) };
+
+		D3D11_RECT rect{};
+		rect.left = static_cast< LONG >( std::floor( x ) );
+		rect.top = static_cast< LONG >( std::floor( y ) );
+		rect.right = static_cast< LONG >( std::ceil( x + w ) );
+		rect.bottom = static_cast< LONG >( std::ceil( y + h ) );
 
-		d.m_vertex_buffer.reset_offsets( );
-		d.m_index_buffer.reset_offsets( );
+		region = detail::active_region
+		{
+			&dl,
+			id,
+			rect,
+			static_cast< std::uint32_t >( dl.m_vertices.size( ) ),
+			static_cast< std::uint32_t >( dl.m_sdf_vertices.size( ) ),
+			static_cast< std::uint32_t >( dl.m_indices.size( ) ),
+			static_cast< std::uint32_t >( dl.m_commands.size( ) ),
+			static_cast< std::uint32_t >( dl.m_occluders.size( ) )
+		};
 
-		d.m_frame_vertex_count = 0u;
-		d.m_frame_index_count = 0u;
+		dl.m_command_barrier = region.m_commands;
+		dl.push_clip_rect( static_cast< float >( rect.left ), static_cast< float >( rect.top ), static_cast< float >( rect.right ), static_cast< float >( rect.bottom ) );
 	}
 
-	void end_frame( )
+	void end_cached_region( )
 	{
 		auto& d{ detail::g_render };
+		auto& region{ d.m_active_region };
 
-		D3D11_VIEWPORT viewport{};
-		UINT num_viewports{ 1u };
-		d.m_context->RSGetViewports( &num_viewports, &viewport );
-		const float vp_w = num_viewports > 0 ? viewport.Width : static_cast< float >( GetSystemMetrics( SM_CXSCREEN ) );
-		const float vp_h = num_viewports > 0 ? viewport.Height : static_cast< float >( GetSystemMetrics( SM_CYSCREEN ) );
+		if ( region.m_nested > 0u )
+		{
+			--region.m_nested;
+			return;
+		}
 
-		D3D11_RECT viewport_rect{};
-		viewport_rect.left = 0;
-		viewport_rect.top = 0;
-		viewport_rect.right = static_cast< LONG >( std::ceil( vp_w ) );
-		viewport_rect.bottom = static_cast< LONG >( std::ceil( vp_h ) );
+		if ( region.m_list == nullptr ) [[unlikely]]
+		{
+			return;
+		}
 
-		d.m_frame_vertex_count = 0u;
-		d.m_frame_index_count = 0u;
+		auto& dl{ *region.m_list };
+		dl.pop_clip_rect( );
+		dl.flush_deferred( );
 
-		for ( auto& dl : d.m_draw_lists )
-		{
-			if ( dl.m_vertices.size( ) == 0 || dl.m_commands.size( ) == 0 )
-			{
-				continue;
-			}
+		const auto command_end{ static_cast< std::uint32_t >( dl.m_commands.size( ) ) };
+		const auto width{ region.m_rect.right - region.m_rect.left };
+		const auto height{ region.m_rect.bottom - region.m_rect.top };
 
-			detail::ensure_buffer_capacity( dl );
+		dl.m_command_barrier = command_end;
 
-			const auto vertex_data_size{ static_cast< std::uint32_t >( dl.m_vertices.size( ) ) * static_cast< std::uint32_t >( sizeof( vertex ) ) };
-			const auto index_data_size{ static_cast< std::uint32_t >( dl.m_indices.size( ) ) * static_cast< std::uint32_t >( sizeof( std::uint32_t ) ) };
+		if ( command_end == region.m_commands || width <= 0 || height <= 0 )
+		{
+			region = detail::active_region{};
+			return;
+		}
 
-			if ( !d.m_vertex_buffer.map_discard( d.m_context.Get( ) ) || !d.m_index_buffer.map_discard( d.m_context.Get( ) ) )
-			{
-				d.m_vertex_buffer.unmap( d.m_context.Get( ) );
-				d.m_index_buffer.unmap( d.m_context.Get( ) );
-				continue;
-			}
+		auto& entry{ d.m_cached_regions[ region.m_id ] };
+		entry.m_last_frame = d.m_frame_index;
 
-			auto vertex_dest{ d.m_vertex_buffer.allocate( vertex_data_size ) };
-			auto index_dest{ d.m_index_buffer.allocate( index_data_size ) };
+		const auto hash{ detail::hash_region( dl, region ) };
 
-			if ( vertex_dest != nullptr && index_dest != nullptr )
-			{
-				std::memcpy( vertex_dest, dl.m_vertices.data( ), vertex_data_size );
-				std::memcpy( index_dest, dl.m_indices.data( ), index_data_size );
-			}
-			else
+		if ( entry.m_valid && entry.m_hash == hash )
+		{
+			dl.m_vertices.truncate( region.m_vertices );
+			dl.m_sdf_vertices.truncate( region.m_sdf_vertices );
+			dl.m_indices.truncate( region.m_indices );
+			dl.m_commands.truncate( region.m_commands );
+			dl.m_occluders.truncate( region.m_occluders );
+			dl.m_command_barrier = region.m_commands;
+		}
+		else
+		{
+			if ( entry.m_target.m_width < static_cast< std::uint32_t >( width ) || entry.m_target.m_height < static_cast< std::uint32_t >( height ) )
 			{
-				d.m_vertex_buffer.unmap( d.m_context.Get( ) );
-				d.m_index_buffer.unmap( d.m_context.Get( ) );
-				continue;
+				detail::release_render_target( std::move( entry.m_target ) );
+				entry.m_target = detail::acquire_render_target( static_cast< std::uint32_t >( width ), static_cast< std::uint32_t >( height ) );
 			}
 
-			d.m_vertex_buffer.unmap( d.m_context.Get( ) );
-			d.m_index_buffer.unmap( d.m_context.Get( ) );
-
-			detail::setup_projection_matrix( vp_w, vp_h );
-			detail::setup_render_state( );
-
-			d.m_state_cache.reset_frame( );
-			d.m_context->RSSetScissorRects( 1, &viewport_rect );
-			d.m_state_cache.set_scissor( viewport_rect );
+			entry.m_hash = hash;
+			entry.m_valid = entry.m_target.m_rtv != nullptr;
 
-			auto& state_cache{ d.m_state_cache };
-			for ( std::size_t i{ 0 }; i < dl.m_commands.size( ); ++i )
+			if ( !entry.m_valid ) [[unlikely]]
 			{
-				const auto& cmd{ dl.m_commands.data( )[ i ] };
-				if ( cmd.m_idx_count == 0u )
-				{
-					continue;
-				}
-
-				D3D11_RECT scissor{ viewport_rect };
-				if ( cmd.m_has_clip )
-				{
-					scissor = detail::intersect_rect( scissor, cmd.m_clip_rect );
-					if ( scissor.right <= scissor.left || scissor.bottom <= scissor.top )
-					{
-						continue;
-					}
-				}
-
-				if ( state_cache.needs_scissor( scissor ) )
-				{
-					d.m_context->RSSetScissorRects( 1, &scissor );
-					state_cache.set_scissor( scissor );
-				}
-
-				if ( state_cache.needs_texture_bind( cmd.m_texture.Get( ) ) )
-				{
-					d.m_context->PSSetShaderResources( 0, 1, cmd.m_texture.GetAddressOf( ) );
-					state_cache.set_texture( cmd.m_texture.Get( ) );
-				}
-
-				d.m_context->DrawIndexed( cmd.m_idx_count, cmd.m_idx_offset, 0 );
+				region = detail::active_region{};
+				return;
 			}
 
-			d.m_frame_vertex_count += static_cast< std::uint32_t >( dl.m_vertices.size( ) );
-			d.m_frame_index_count += static_cast< std::uint32_t >( dl.m_indices.size( ) );
+			*dl.m_region_passes.allocate( 1 ) = region_pass{ entry.m_target.m_rtv.Get( ), region.m_rect, region.m_commands, command_end };
+			d.m_frames[ d.m_build_slot ].m_invalidated = true;
 		}
+
+		dl.push_blend( blend::normal );
+		dl.add_rect_textured( static_cast< float >( region.m_rect.left ), static_cast< float >( region.m_rect.top ), static_cast< float >( width ), static_cast< float >( height ), entry.m_target.m_srv.Get( ),
+			0.0f, 0.0f, static_cast< float >( width ) / static_cast< float >( entry.m_target.m_width ), static_cast< float >( height ) / static_cast< float >( entry.m_target.m_height ) );
+		dl.pop_blend( );
+
+		region = detail::active_region{};
 	}
 
-	draw_list& get_draw_list( draw_layer layer ) noexcept
+	void invalidate_cached_region( std::uint64_t id ) noexcept
 	{
-		return detail::g_render.m_draw_lists[ static_cast< int >( layer ) ];
+		if ( const auto it{ detail::g_render.m_cached_regions.find( id ) }; it != detail::g_render.m_cached_regions.end( ) )
+		{
+			it->second.m_valid = false;
+		}
 	}
 
-	std::pair<int, int> get_display_size( ) noexcept
+	void clear_cached_regions( )
 	{
 		auto& d{ detail::g_render };
-		D3D11_VIEWPORT viewport{};
-		UINT num_viewports{ 1u };
-
-		if ( d.m_context )
-		{
-			d.m_context->RSGetViewports( &num_viewports, &viewport );
-		}
 
-		if ( num_viewports > 0 && viewport.Width > 0.0f && viewport.Height > 0.0f )
+		auto& retired{ d.m_frames[ d.m_build_slot ].m_retired_targets };
+		for ( auto& [id, entry] : d.m_cached_regions )
 		{
-			return { static_cast< int >( std::lround( viewport.Width ) ), static_cast< int >( std::lround( viewport.Height ) ) };
+			retired.push_back( std::move( entry.m_target ) );
 		}
 
-		return { 0, 0 };
+		std::move( d.m_target_pool.begin( ), d.m_target_pool.end( ), std::back_inserter( retired ) );
+		d.m_cached_regions.clear( );
+		d.m_target_pool.clear( );
 	}
 
-	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_memory( std::span<const std::byte> data, int* out_width, int* out_height )
+	frame_arena& get_frame_arena( ) noexcept
 	{
-		static Microsoft::WRL::ComPtr<IWICImagingFactory> factory = [ ]
-			{
-				( void )CoInitializeEx( nullptr, COINIT_MULTITHREADED );
-				Microsoft::WRL::ComPtr<IWICImagingFactory> f;
-				( void )CoCreateInstance( CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS( &f ) );
-				return f;
-			}( );
-
-		if ( !factory ) [[unlikely]]
-		{
-			return nullptr;
-		}
+		auto& d{ detail::g_render };
+		return detail::t_frame_arena != nullptr ? *detail::t_frame_arena : d.m_frames[ d.m_build_slot ].m_frame_arena;
+	}
 
-		Microsoft::WRL::ComPtr<IWICStream> stream;
-		auto hr = factory->CreateStream( &stream );
-		if ( FAILED( hr ) ) [[unlikely]]
-		{
-			return nullptr;
-		}
+	draw_list_stats get_draw_list_stats( draw_layer layer ) noexcept
+	{
+		return get_draw_list( layer ).stats( );
+	}
 
-		hr = stream->InitializeFromMemory( reinterpret_cast< BYTE* >( const_cast< std::byte* >( data.data( ) ) ), static_cast< DWORD >( data.size( ) ) );
-		if ( FAILED( hr ) ) [[unlikely]]
-		{
-			return nullptr;
-		}
+	float evaluate_sdf_coverage( const sdf_shape& shape, float x, float y ) noexcept
+	{
+		const auto width{ std::max( shape.m_softness, 1.0f ) };
+		return std::clamp( 0.5f - detail::sdf_distance( shape, x, y ) / width, 0.0f, 1.0f );
+	}
 
-		Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
-		hr = factory->CreateDecoderFromStream( stream.Get( ), nullptr, WICDecodeMetadataCacheOnDemand, &decoder );
-		if ( FAILED( hr ) ) [[unlikely]]
-		{
-			return nullptr;
-		}
+	std::pair<int, int> get_display_size( ) noexcept
+	{
+		auto& d{ detail::g_render };
+		return { d.m_display_width.load( std::memory_order_relaxed ), d.m_display_height.load( std::memory_order_relaxed ) };
+	}
 
-		Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> frame;
-		hr = decoder->GetFrame( 0, &frame );
-		if ( FAILED( hr ) ) [[unlikely]]
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_memory( std::span<const std::byte> data, int* out_width, int* out_height )
+	{
+		zimage::image image{};
+		if ( !detail::decode_image( data, image ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		UINT width, height;
-		frame->GetSize( &width, &height );
+		if ( out_width != nullptr ) { *out_width = static_cast< int >( image.m_width ); }
+		if ( out_height != nullptr ) { *out_height = static_cast< int >( image.m_height ); }
 
-		Microsoft::WRL::ComPtr<IWICFormatConverter> converter;
-		hr = factory->CreateFormatConverter( &converter );
-		if ( FAILED( hr ) ) [[unlikely]]
-		{
-			return nullptr;
-		}
+		return detail::create_texture_from_image( image );
+	}
 
-		hr = converter->Initialize( frame.Get( ), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom );
-		if ( FAILED( hr ) ) [[unlikely]]
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_icon_from_memory( std::span<const std::byte> data, int* out_width, int* out_height )
+	{
+		zimage::image image{};
+		if ( !detail::decode_image( data, image ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		std::vector<BYTE> pixels( width * height * 4 );
-		hr = converter->CopyPixels( nullptr, width * 4, static_cast< UINT >( pixels.size( ) ), pixels.data( ) );
-		if ( FAILED( hr ) ) [[unlikely]]
-		{
-			return nullptr;
-		}
+		const auto width{ image.m_width };
+		const auto height{ image.m_height };
+		auto& pixels{ image.m_pixels };
 
 		if ( out_width != nullptr ) { *out_width = static_cast< int >( width ); }
 		if ( out_height != nullptr ) { *out_height = static_cast< int >( height ); }
 
+		zimage::luminance_to_alpha( pixels.data( ), static_cast< std::size_t >( width ) * height );
+		zimage::premultiply_alpha( pixels.data( ), static_cast< std::size_t >( width ) * height );
+
 		D3D11_TEXTURE2D_DESC tex_desc{};
 		tex_desc.Width = width;
 		tex_desc.Height = height;
-		tex_desc.MipLevels = 0;
+		tex_desc.MipLevels = 1;
 		tex_desc.ArraySize = 1;
 		tex_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 		tex_desc.SampleDesc.Count = 1;
-		tex_desc.Usage = D3D11_USAGE_DEFAULT;
-		tex_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-		tex_desc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+		tex_desc.Usage = D3D11_USAGE_IMMUTABLE;
+		tex_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		D3D11_SUBRESOURCE_DATA init_data{};
+		init_data.pSysMem = pixels.data( );
+		init_data.SysMemPitch = width * 4;
+		init_data.SysMemSlicePitch = 0;
 
 		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-		hr = detail::g_render.m_device->CreateTexture2D( &tex_desc, nullptr, &texture );
+		auto hr{ detail::g_render.m_device->CreateTexture2D( &tex_desc, &init_data, &texture ) };
 		if ( FAILED( hr ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		detail::g_render.m_context->UpdateSubresource( texture.Get( ), 0, nullptr, pixels.data( ), width * 4, 0 );
-
 		D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
 		srv_desc.Format = tex_desc.Format;
 		srv_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-		srv_desc.Texture2D.MipLevels = -1;
+		srv_desc.Texture2D.MipLevels = 1;
 
 		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture_srv;
 		hr = detail::g_render.m_device->CreateShaderResourceView( texture.Get( ), &srv_desc, &texture_srv );
-		if ( FAILED( hr ) ) [[unlikely]]
+
+		return FAILED( hr ) ? nullptr : texture_srv;
+	}
+
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_file( std::string_view filepath, int* out_width, int* out_height )
+	{
+		std::vector<std::byte> buffer{};
+		if ( !detail::read_file( filepath, buffer ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		detail::g_render.m_context->GenerateMips( texture_srv.Get( ) );
+		return load_texture_from_memory( buffer, out_width, out_height );
+	}
 
-		return texture_srv;
+	texture_handle load_texture_from_memory_async( std::span<const std::byte> data )
+	{
+		auto target{ std::make_shared<texture>( ) };
+		detail::queue_texture_decode( target, std::vector<std::byte>( data.begin( ), data.end( ) ), {} );
+		return target;
 	}
 
-	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_icon_from_memory( std::span<const std::byte> data, int* out_width, int* out_height )
+	texture_handle load_texture_from_file_async( std::string_view filepath )
 	{
-		static Microsoft::WRL::ComPtr<IWICImagingFactory> factory = [ ]
-			{
-				( void )CoInitializeEx( nullptr, COINIT_MULTITHREADED );
-				Microsoft::WRL::ComPtr<IWICImagingFactory> f;
-				( void )CoCreateInstance( CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS( &f ) );
-				return f;
-			}( );
+		auto target{ std::make_shared<texture>( ) };
+		detail::queue_texture_decode( target, {}, std::string( filepath ) );
+		return target;
+	}
 
-		if ( !factory ) [[unlikely]]
-		{
-			return nullptr;
-		}
+	void set_texture_upload_budget( std::uint32_t max_bytes_per_frame, float max_milliseconds_per_frame )
+	{
+		detail::g_render.m_texture_uploads.m_max_bytes_per_frame.store( std::max( max_bytes_per_frame, 1u ), std::memory_order_relaxed );
+		detail::g_render.m_texture_uploads.m_max_milliseconds_per_frame.store( std::max( max_milliseconds_per_frame, 0.0f ), std::memory_order_relaxed );
+	}
 
-		Microsoft::WRL::ComPtr<IWICStream> stream;
-		auto hr = factory->CreateStream( &stream );
-		if ( FAILED( hr ) ) [[unlikely]]
+	std::size_t get_pending_texture_count( ) noexcept
+	{
+		return detail::g_render.m_texture_uploads.m_in_flight.load( std::memory_order_relaxed );
+	}
+
+	texture_handle create_dynamic_texture( int width, int height, DXGI_FORMAT format, bool triple_buffered )
+	{
+		const auto bytes_per_pixel{ detail::dynamic_texture_bytes_per_pixel( format ) };
+		if ( width <= 0 || height <= 0 || bytes_per_pixel == 0u || !detail::g_render.m_device ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		hr = stream->InitializeFromMemory( reinterpret_cast< BYTE* >( const_cast< std::byte* >( data.data( ) ) ), static_cast< DWORD >( data.size( ) ) );
-		if ( FAILED( hr ) ) [[unlikely]]
+		detail::dynamic_texture dyn{};
+		dyn.m_bytes_per_pixel = bytes_per_pixel;
+		dyn.m_buffer_count = triple_buffered ? detail::dynamic_texture::k_max_buffers : 1u;
+		dyn.m_shadow.resize( static_cast< std::size_t >( width ) * height * bytes_per_pixel );
+
+		if ( !detail::create_dynamic_resources( dyn, static_cast< std::uint32_t >( width ), static_cast< std::uint32_t >( height ), format ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		Microsoft::WRL::ComPtr<IWICBitmapDecoder> decoder;
-		hr = factory->CreateDecoderFromStream( stream.Get( ), nullptr, WICDecodeMetadataCacheOnDemand, &decoder );
-		if ( FAILED( hr ) ) [[unlikely]]
+		auto target{ std::make_shared<texture>( ) };
+		target->m_width = width;
+		target->m_height = height;
+		target->m_bytes = dyn.m_shadow.size( ) * ( dyn.m_buffer_count + detail::dynamic_texture::k_staging_ring );
+		target->m_view.store( dyn.m_views[ 0 ].Get( ), std::memory_order_relaxed );
+		target->m_status.store( texture_status::ready, std::memory_order_release );
+		dyn.m_target = target;
+
+		auto& store{ detail::g_render.m_dynamic_textures };
+		std::scoped_lock lock{ store.m_mutex };
+		store.m_textures.emplace( target.get( ), std::move( dyn ) );
+
+		return target;
+	}
+
+	bool update_texture( const texture_handle& target, const D3D11_RECT& rect, const void* data, std::uint32_t pitch )
+	{
+		if ( !target || data == nullptr ) [[unlikely]]
 		{
-			return nullptr;
+			return false;
 		}
 
-		Microsoft::WRL::ComPtr<IWICBitmapFrameDecode> frame;
-		hr = decoder->GetFrame( 0, &frame );
-		if ( FAILED( hr ) ) [[unlikely]]
+		if ( rect.left < 0 || rect.top < 0 || rect.right > target->m_width || rect.bottom > target->m_height || detail::rect_empty( rect ) ) [[unlikely]]
 		{
-			return nullptr;
+			return false;
 		}
 
-		UINT width, height;
-		frame->GetSize( &width, &height );
+		auto& store{ detail::g_render.m_dynamic_textures };
+		std::scoped_lock lock{ store.m_mutex };
 
-		Microsoft::WRL::ComPtr<IWICFormatConverter> converter;
-		hr = factory->CreateFormatConverter( &converter );
-		if ( FAILED( hr ) ) [[unlikely]]
+		const auto it{ store.m_textures.find( target.get( ) ) };
+		if ( it == store.m_textures.end( ) ) [[unlikely]]
 		{
-			return nullptr;
+			return false;
 		}
 
-		hr = converter->Initialize( frame.Get( ), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom );
-		if ( FAILED( hr ) ) [[unlikely]]
+		auto& dyn{ it->second };
+		const auto width{ static_cast< std::size_t >( rect.right - rect.left ) };
+		const auto row_bytes{ width * dyn.m_bytes_per_pixel };
+		const auto source_pitch{ pitch != 0u ? static_cast< std::size_t >( pitch ) : row_bytes };
+
+		if ( source_pitch < row_bytes ) [[unlikely]]
 		{
-			return nullptr;
+			return false;
 		}
 
-		std::vector<BYTE> pixels( width * height * 4 );
-		hr = converter->CopyPixels( nullptr, width * 4, static_cast< UINT >( pixels.size( ) ), pixels.data( ) );
-		if ( FAILED( hr ) ) [[unlikely]]
+		const auto shadow_pitch{ static_cast< std::size_t >( target->m_width ) * dyn.m_bytes_per_pixel };
+		auto source{ static_cast< const std::uint8_t* >( data ) };
+
+		for ( auto y{ rect.top }; y < rect.bottom; ++y, source += source_pitch )
 		{
-			return nullptr;
+			auto row{ dyn.m_shadow.data( ) + static_cast< std::size_t >( y ) * shadow_pitch + static_cast< std::size_t >( rect.left ) * dyn.m_bytes_per_pixel };
+			std::memcpy( row, source, row_bytes );
+
+			if ( dyn.m_bytes_per_pixel == 4u )
+			{
+				zimage::premultiply_alpha( row, width );
+			}
 		}
 
-		if ( out_width != nullptr ) { *out_width = static_cast< int >( width ); }
-		if ( out_height != nullptr ) { *out_height = static_cast< int >( height ); }
+		detail::add_dirty_rect( dyn.m_dirty, rect );
+		return true;
+	}
 
-		const auto pixel_count{ width * height };
-		for ( UINT i{ 0 }; i < pixel_count; ++i )
-		{
-			const auto idx{ i * 4 };
-			const auto r{ pixels[ static_cast< std::size_t >( idx ) + 0 ] };
-			const auto g{ pixels[ static_cast< std::size_t >( idx ) + 1 ] };
-			const auto b{ pixels[ static_cast< std::size_t >( idx ) + 2 ] };
-			const auto a{ pixels[ static_cast< std::size_t >( idx ) + 3 ] };
+	texture_handle load_texture_cached_from_memory( std::span<const std::byte> data )
+	{
+		return detail::load_cached_texture( data, {} );
+	}
 
-			const auto luminance{ static_cast< std::uint8_t >( ( r * 0.299f + g * 0.587f + b * 0.114f ) ) };
-			const auto computed_alpha{ static_cast< std::uint8_t >( 255 - luminance ) };
-			const auto final_alpha{ a < 250 ? a : computed_alpha };
+	texture_handle load_texture_cached_from_file( std::string_view filepath )
+	{
+		auto& cache{ detail::g_render.m_texture_cache };
+		auto path{ std::filesystem::path( filepath ).lexically_normal( ).generic_string( ) };
 
-			pixels[ static_cast< std::size_t >( idx ) + 0 ] = 255;
-			pixels[ static_cast< std::size_t >( idx ) + 1 ] = 255;
-			pixels[ static_cast< std::size_t >( idx ) + 2 ] = 255;
-			pixels[ static_cast< std::size_t >( idx ) + 3 ] = final_alpha;
-		}
+		{
+			std::scoped_lock lock{ cache.m_mutex };
 
-		D3D11_TEXTURE2D_DESC tex_desc{};
-		tex_desc.Width = width;
-		tex_desc.Height = height;
-		tex_desc.MipLevels = 1;
-		tex_desc.ArraySize = 1;
-		tex_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-		tex_desc.SampleDesc.Count = 1;
-		tex_desc.Usage = D3D11_USAGE_IMMUTABLE;
-		tex_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			if ( auto it{ cache.m_paths.find( path ) }; it != cache.m_paths.end( ) )
+			{
+				if ( auto cached{ detail::find_cached_texture( it->second ) } )
+				{
+					return cached;
+				}
 
-		D3D11_SUBRESOURCE_DATA init_data{};
-		init_data.pSysMem = pixels.data( );
-		init_data.SysMemPitch = width * 4;
-		init_data.SysMemSlicePitch = 0;
+				cache.m_paths.erase( it );
+			}
+		}
 
-		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
-		hr = detail::g_render.m_device->CreateTexture2D( &tex_desc, &init_data, &texture );
-		if ( FAILED( hr ) ) [[unlikely]]
+		std::vector<std::byte> buffer{};
+		if ( !detail::read_file( path, buffer ) ) [[unlikely]]
 		{
 			return nullptr;
 		}
 
-		D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
-		srv_desc.Format = tex_desc.Format;
-		srv_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-		srv_desc.Texture2D.MipLevels = 1;
+		return detail::load_cached_texture( buffer, std::move( path ) );
+	}
 
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture_srv;
-		hr = detail::g_render.m_device->CreateShaderResourceView( texture.Get( ), &srv_desc, &texture_srv );
+	void purge_texture_cache( )
+	{
+		auto& cache{ detail::g_render.m_texture_cache };
+		std::scoped_lock lock{ cache.m_mutex };
 
-		return FAILED( hr ) ? nullptr : texture_srv;
+		cache.m_entries.clear( );
+		cache.m_paths.clear( );
+		cache.m_bytes = 0u;
 	}
 
-	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_file( std::string_view filepath, int* out_width, int* out_height )
+	std::size_t trim_texture_cache( std::size_t max_bytes )
 	{
-		std::ifstream file{ std::string( filepath ), std::ios::binary | std::ios::ate };
-		if ( !file.is_open( ) ) [[unlikely]]
+		auto& cache{ detail::g_render.m_texture_cache };
+		std::scoped_lock lock{ cache.m_mutex };
+
+		if ( cache.m_bytes <= max_bytes )
 		{
-			return nullptr;
+			return 0u;
 		}
 
-		const std::streamsize size{ file.tellg( ) };
-		file.seekg( 0, std::ios::beg );
+		std::vector<std::pair<std::uint64_t, std::uint64_t>> candidates{};
+		for ( const auto& [key, entry] : cache.m_entries )
+		{
+			if ( entry.m_texture.use_count( ) == 1 )
+			{
+				candidates.emplace_back( entry.m_last_used, key );
+			}
+		}
 
-		std::vector<std::byte> buffer( static_cast< std::size_t >( size ) );
-		file.read( reinterpret_cast< char* >( buffer.data( ) ), size );
+		std::sort( candidates.begin( ), candidates.end( ) );
 
-		return load_texture_from_memory( buffer, out_width, out_height );
+		const auto initial_bytes{ cache.m_bytes };
+		for ( const auto& [last_used, key] : candidates )
+		{
+			if ( cache.m_bytes <= max_bytes )
+			{
+				break;
+			}
+
+			detail::erase_cached_texture( key );
+		}
+
+		std::erase_if( cache.m_paths, [ &cache ]( const auto& path ) { return !cache.m_entries.contains( path.second.m_hash ); } );
+		return initial_bytes - cache.m_bytes;
+	}
+
+	texture_cache_stats get_texture_cache_stats( )
+	{
+		auto& cache{ detail::g_render.m_texture_cache };
+		std::scoped_lock lock{ cache.m_mutex };
+
+		return { cache.m_entries.size( ), cache.m_bytes, cache.m_hits, cache.m_misses };
 	}
 
 	font* add_font_from_memory( std::span<const std::byte> font_data, float size_pixels, int atlas_width, int atlas_height )
@@ -2318,12 +5605,12 @@ namespace zdraw {
 
 	float get_delta_time( ) noexcept
 	{
-		return detail::g_render.m_delta_time;
+		return detail::g_render.m_delta_time.load( std::memory_order_relaxed );
 	}
 
 	float get_framerate( ) noexcept
 	{
-		return detail::g_render.m_framerate;
+		return detail::g_render.m_framerate.load( std::memory_order_relaxed );
 	}
 
 	void push_font( font* font )
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
@@ -11,10 +11,18 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <vector>
 #include <span>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "external/unordered_dense.hpp"
 
@@ -60,59 +68,507 @@ namespace zdraw {
 		}
 	};
 
-	struct vertex
+	struct vertex_f32
 	{
 		float m_pos[ 2 ];
 		float m_uv[ 2 ];
 		rgba m_col;
 	};
 
+	struct vertex_q16
+	{
+		std::int16_t m_pos[ 2 ];
+		std::uint16_t m_uv[ 2 ];
+		rgba m_col;
+	};
+
+	static_assert( sizeof( vertex_f32 ) == 20u );
+	static_assert( sizeof( vertex_q16 ) == 12u );
+
+	template<typename V>
+	struct vertex_traits;
+
+	template<>
+	struct vertex_traits<vertex_f32>
+	{
+		static constexpr DXGI_FORMAT k_pos_format{ DXGI_FORMAT_R32G32_FLOAT };
+		static constexpr DXGI_FORMAT k_uv_format{ DXGI_FORMAT_R32G32_FLOAT };
+		static constexpr const char* k_shader_define{ nullptr };
+		static constexpr float k_pos_scale{ 1.0f };
+
+		[[nodiscard]] static constexpr float select_pos_scale( float ) noexcept
+		{
+			return k_pos_scale;
+		}
+
+		static void store( vertex_f32& vtx, float x, float y, float u, float v, rgba color, float ) noexcept
+		{
+			vtx.m_pos[ 0 ] = x;
+			vtx.m_pos[ 1 ] = y;
+			vtx.m_uv[ 0 ] = u;
+			vtx.m_uv[ 1 ] = v;
+			vtx.m_col = color;
+		}
+
+		[[nodiscard]] static std::array<float, 2> position( const vertex_f32& vtx, float ) noexcept
+		{
+			return { vtx.m_pos[ 0 ], vtx.m_pos[ 1 ] };
+		}
+
+		[[nodiscard]] static std::array<float, 2> uv( const vertex_f32& vtx ) noexcept
+		{
+			return { vtx.m_uv[ 0 ], vtx.m_uv[ 1 ] };
+		}
+	};
+
+	template<>
+	struct vertex_traits<vertex_q16>
+	{
+		static constexpr DXGI_FORMAT k_pos_format{ DXGI_FORMAT_R16G16_SINT };
+		static constexpr DXGI_FORMAT k_uv_format{ DXGI_FORMAT_R16G16_UNORM };
+		static constexpr const char* k_shader_define{ "ZDRAW_COMPACT_VERTEX" };
+
+		static constexpr int k_pos_frac_bits{ 3 };
+		static constexpr float k_pos_scale{ static_cast< float >( 1 << k_pos_frac_bits ) };
+		static constexpr float k_pos_limit{ 32767.0f };
+		static constexpr float k_uv_scale{ 65535.0f };
+
+		// drops fractional bits until twice the extent fits, so large and offscreen targets trade subpixel precision for range
+		[[nodiscard]] static constexpr float select_pos_scale( float extent ) noexcept
+		{
+			auto frac_bits{ k_pos_frac_bits };
+			while ( frac_bits > 0 && extent * 2.0f * static_cast< float >( 1 << frac_bits ) > k_pos_limit )
+			{
+				--frac_bits;
+			}
+
+			return static_cast< float >( 1 << frac_bits );
+		}
+
+		[[nodiscard]] static std::int16_t quantize_pos( float value, float pos_scale ) noexcept
+		{
+			const auto scaled{ std::clamp( value * pos_scale, -32768.0f, k_pos_limit ) };
+			return static_cast< std::int16_t >( scaled + ( scaled >= 0.0f ? 0.5f : -0.5f ) );
+		}
+
+		[[nodiscard]] static std::uint16_t quantize_uv( float value ) noexcept
+		{
+			return static_cast< std::uint16_t >( std::clamp( value, 0.0f, 1.0f ) * k_uv_scale + 0.5f );
+		}
+
+		static void store( vertex_q16& vtx, float x, float y, float u, float v, rgba color, float pos_scale ) noexcept
+		{
+			vtx.m_pos[ 0 ] = quantize_pos( x, pos_scale );
+			vtx.m_pos[ 1 ] = quantize_pos( y, pos_scale );
+			vtx.m_uv[ 0 ] = quantize_uv( u );
+			vtx.m_uv[ 1 ] = quantize_uv( v );
+			vtx.m_col = color;
+		}
+
+		[[nodiscard]] static std::array<float, 2> position( const vertex_q16& vtx, float pos_scale ) noexcept
+		{
+			return { static_cast< float >( vtx.m_pos[ 0 ] ) / pos_scale, static_cast< float >( vtx.m_pos[ 1 ] ) / pos_scale };
+		}
+
+		[[nodiscard]] static std::array<float, 2> uv( const vertex_q16& vtx ) noexcept
+		{
+			return { static_cast< float >( vtx.m_uv[ 0 ] ) / k_uv_scale, static_cast< float >( vtx.m_uv[ 1 ] ) / k_uv_scale };
+		}
+	};
+
+#if defined( ZDRAW_COMPACT_VERTEX )
+	using vertex = vertex_q16;
+#else
+	using vertex = vertex_f32;
+#endif
+
+	struct sdf_vertex
+	{
+		float m_pos[ 2 ];
+		float m_local[ 2 ];
+		float m_shape[ 4 ];
+		float m_softness;
+		rgba m_col;
+		rgba m_effect_col;
+	};
+
+	struct sdf_shape
+	{
+		float m_center_x{ 0.0f };
+		float m_center_y{ 0.0f };
+		float m_half_width{ 0.0f };
+		float m_half_height{ 0.0f };
+		float m_radius{ 0.0f };
+		float m_thickness{ 0.0f };
+		float m_softness{ 0.0f };
+	};
+
+	struct rect_instance
+	{
+		float m_x{ 0.0f };
+		float m_y{ 0.0f };
+		float m_w{ 0.0f };
+		float m_h{ 0.0f };
+		rgba m_color{};
+	};
+
+	struct circle_instance
+	{
+		float m_x{ 0.0f };
+		float m_y{ 0.0f };
+		float m_radius{ 0.0f };
+		rgba m_color{};
+	};
+
+	struct line_instance
+	{
+		float m_x0{ 0.0f };
+		float m_y0{ 0.0f };
+		float m_x1{ 0.0f };
+		float m_y1{ 0.0f };
+		rgba m_color{};
+	};
+
+	struct rect_instances_soa
+	{
+		std::span<const float> m_x{};
+		std::span<const float> m_y{};
+		std::span<const float> m_w{};
+		std::span<const float> m_h{};
+		std::span<const rgba> m_color{};
+	};
+
+	struct circle_instances_soa
+	{
+		std::span<const float> m_x{};
+		std::span<const float> m_y{};
+		std::span<const float> m_radius{};
+		std::span<const rgba> m_color{};
+	};
+
+	struct line_instances_soa
+	{
+		std::span<const float> m_x0{};
+		std::span<const float> m_y0{};
+		std::span<const float> m_x1{};
+		std::span<const float> m_y1{};
+		std::span<const rgba> m_color{};
+	};
+
+	enum class draw_kind : std::uint8_t { geometry, sdf, glyph };
+	enum class blend : std::uint8_t { normal, additive };
+
+	[[nodiscard]] constexpr rgba premultiply( rgba color, blend mode ) noexcept
+	{
+		const auto scale{ [ alpha = static_cast< std::uint32_t >( color.a ) ]( std::uint8_t channel )
+			{
+				const auto value{ channel * alpha + 128u };
+				return static_cast< std::uint8_t >( ( value + ( value >> 8 ) ) >> 8 );
+			} };
+
+		return rgba{ scale( color.r ), scale( color.g ), scale( color.b ), mode == blend::additive ? std::uint8_t{ 0 } : color.a };
+	}
+
+	struct mat2x3
+	{
+		float m_xx{ 1.0f };
+		float m_xy{ 0.0f };
+		float m_tx{ 0.0f };
+		float m_yx{ 0.0f };
+		float m_yy{ 1.0f };
+		float m_ty{ 0.0f };
+
+		[[nodiscard]] static constexpr mat2x3 translation( float x, float y ) noexcept
+		{
+			return mat2x3{ 1.0f, 0.0f, x, 0.0f, 1.0f, y };
+		}
+
+		[[nodiscard]] static constexpr mat2x3 scaling( float sx, float sy, float cx = 0.0f, float cy = 0.0f ) noexcept
+		{
+			return mat2x3{ sx, 0.0f, cx - cx * sx, 0.0f, sy, cy - cy * sy };
+		}
+
+		[[nodiscard]] static mat2x3 rotation( float radians, float cx = 0.0f, float cy = 0.0f ) noexcept;
+
+		[[nodiscard]] constexpr mat2x3 operator*( const mat2x3& o ) const noexcept
+		{
+			return mat2x3
+			{
+				this->m_xx * o.m_xx + this->m_xy * o.m_yx, this->m_xx * o.m_xy + this->m_xy * o.m_yy, this->m_xx * o.m_tx + this->m_xy * o.m_ty + this->m_tx,
+				this->m_yx * o.m_xx + this->m_yy * o.m_yx, this->m_yx * o.m_xy + this->m_yy * o.m_yy, this->m_yx * o.m_tx + this->m_yy * o.m_ty + this->m_ty
+			};
+		}
+	};
+
 	struct draw_cmd
 	{
+		static constexpr std::uint32_t k_no_clip{ 0xffffffffu };
+
 		std::uint32_t m_idx_offset{ 0 };
 		std::uint32_t m_idx_count{ 0 };
-		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_texture;
+		std::uint32_t m_texture{ 0 };
+		std::uint32_t m_clip{ k_no_clip };
+		draw_kind m_kind{ draw_kind::geometry };
+
+		[[nodiscard]] bool has_clip( ) const noexcept
+		{
+			return this->m_clip != k_no_clip;
+		}
+	};
+
+	static_assert( std::is_trivially_copyable_v<draw_cmd> && sizeof( draw_cmd ) <= 24u );
+
+	struct clip_rect_hash
+	{
+		using is_avalanching = void;
 
-		bool m_has_clip{ false };
-		D3D11_RECT m_clip_rect{};
+		[[nodiscard]] std::uint64_t operator()( const D3D11_RECT& r ) const noexcept
+		{
+			return ankerl::unordered_dense::detail::wyhash::hash( &r, sizeof( r ) );
+		}
+	};
+
+	struct clip_rect_equal
+	{
+		[[nodiscard]] bool operator()( const D3D11_RECT& a, const D3D11_RECT& b ) const noexcept
+		{
+			return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+		}
+	};
 
-		draw_cmd( ) = default;
-		draw_cmd( std::uint32_t idx_off, std::uint32_t count, ID3D11ShaderResourceView* tex ) : m_idx_offset{ idx_off }, m_idx_count{ count }, m_texture{ tex } {}
+	struct nvec_stats
+	{
+		std::size_t m_size{ 0 };
+		std::size_t m_peak{ 0 };
+		std::size_t m_committed_bytes{ 0 };
+		std::size_t m_reserved_bytes{ 0 };
 	};
 
 	template<typename T>
 	class nvec
 	{
 	private:
-		std::vector<T> m_data{};
+		static constexpr bool k_trivial{ std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> };
+		static constexpr std::size_t k_commit_granularity{ 64u * 1024u };
+		static constexpr std::size_t k_reserve_bytes{ sizeof( void* ) == 8u ? std::size_t{ 1 } << 30 : std::size_t{ 1 } << 24 };
+		static constexpr std::uint32_t k_decay_frames{ 120u };
+
+		T* m_data{ nullptr };
 		std::size_t m_size{ 0 };
+		std::size_t m_constructed{ 0 };
+		std::size_t m_committed_bytes{ 0 };
+		std::size_t m_reserved_bytes{ 0 };
+		std::size_t m_floor_bytes{ 0 };
+		std::size_t m_peak{ 0 };
+		std::size_t m_window_peak{ 0 };
+		std::uint32_t m_window_frames{ 0 };
+
+		[[nodiscard]] static std::size_t round_to_granularity( std::size_t bytes ) noexcept
+		{
+			return ( bytes + k_commit_granularity - 1u ) & ~( k_commit_granularity - 1u );
+		}
+
+		[[nodiscard]] bool relocate( std::size_t required_bytes )
+		{
+			const auto reserve_bytes{ std::max( { k_reserve_bytes, this->m_reserved_bytes * 2u, required_bytes } ) };
+
+			auto base{ static_cast< T* >( VirtualAlloc( nullptr, reserve_bytes, MEM_RESERVE, PAGE_NOACCESS ) ) };
+			if ( base == nullptr ) [[unlikely]]
+			{
+				return false;
+			}
+
+			if ( this->m_data != nullptr )
+			{
+				if ( this->m_committed_bytes != 0u && VirtualAlloc( base, this->m_committed_bytes, MEM_COMMIT, PAGE_READWRITE ) == nullptr ) [[unlikely]]
+				{
+					VirtualFree( base, 0, MEM_RELEASE );
+					return false;
+				}
+
+				if constexpr ( k_trivial )
+				{
+					std::memcpy( base, this->m_data, this->m_size * sizeof( T ) );
+				}
+				else
+				{
+					std::uninitialized_move_n( this->m_data, this->m_constructed, base );
+					std::destroy_n( this->m_data, this->m_constructed );
+				}
+
+				VirtualFree( this->m_data, 0, MEM_RELEASE );
+			}
+
+			this->m_data = base;
+			this->m_reserved_bytes = reserve_bytes;
+			return true;
+		}
+
+		[[nodiscard]] bool commit( std::size_t capacity )
+		{
+			const auto required_bytes{ round_to_granularity( capacity * sizeof( T ) ) };
+			if ( required_bytes <= this->m_committed_bytes )
+			{
+				return true;
+			}
+
+			if ( required_bytes > this->m_reserved_bytes && !this->relocate( required_bytes ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto base{ reinterpret_cast< std::byte* >( this->m_data ) };
+			if ( VirtualAlloc( base + this->m_committed_bytes, required_bytes - this->m_committed_bytes, MEM_COMMIT, PAGE_READWRITE ) == nullptr ) [[unlikely]]
+			{
+				return false;
+			}
+
+			this->m_committed_bytes = required_bytes;
+			return true;
+		}
+
+		void release( ) noexcept
+		{
+			if ( this->m_data == nullptr )
+			{
+				return;
+			}
+
+			if constexpr ( !k_trivial )
+			{
+				std::destroy_n( this->m_data, this->m_constructed );
+			}
+
+			VirtualFree( this->m_data, 0, MEM_RELEASE );
+
+			this->m_data = nullptr;
+			this->m_size = 0u;
+			this->m_constructed = 0u;
+			this->m_committed_bytes = 0u;
+			this->m_reserved_bytes = 0u;
+		}
 
 	public:
+		nvec( ) = default;
+		nvec( const nvec& ) = delete;
+		nvec& operator=( const nvec& ) = delete;
+
+		nvec( nvec&& other ) noexcept
+		{
+			*this = std::move( other );
+		}
+
+		nvec& operator=( nvec&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				this->release( );
+
+				this->m_data = std::exchange( other.m_data, nullptr );
+				this->m_size = std::exchange( other.m_size, 0u );
+				this->m_constructed = std::exchange( other.m_constructed, 0u );
+				this->m_committed_bytes = std::exchange( other.m_committed_bytes, 0u );
+				this->m_reserved_bytes = std::exchange( other.m_reserved_bytes, 0u );
+				this->m_floor_bytes = std::exchange( other.m_floor_bytes, 0u );
+				this->m_peak = std::exchange( other.m_peak, 0u );
+				this->m_window_peak = std::exchange( other.m_window_peak, 0u );
+				this->m_window_frames = std::exchange( other.m_window_frames, 0u );
+			}
+
+			return *this;
+		}
+
+		~nvec( )
+		{
+			this->release( );
+		}
+
 		void clear( ) noexcept
 		{
+			this->m_window_peak = std::max( this->m_window_peak, this->m_size );
 			this->m_size = 0;
 		}
 
+		void truncate( std::size_t size ) noexcept
+		{
+			this->m_size = std::min( this->m_size, size );
+		}
+
 		void reserve( std::size_t capacity )
 		{
-			if ( capacity > this->m_data.size( ) )
+			if ( !this->commit( capacity ) ) [[unlikely]]
 			{
-				this->m_data.resize( capacity );
+				std::abort( );
 			}
+
+			this->m_floor_bytes = std::max( this->m_floor_bytes, round_to_granularity( capacity * sizeof( T ) ) );
 		}
 
 		[[nodiscard]] T* allocate( std::size_t count )
 		{
-			if ( this->m_size + count > this->m_data.size( ) )
+			const auto new_size{ this->m_size + count };
+
+			if ( new_size * sizeof( T ) > this->m_committed_bytes ) [[unlikely]]
+			{
+				if ( !this->commit( new_size + new_size / 2u ) ) [[unlikely]]
+				{
+					std::abort( );
+				}
+			}
+
+			if constexpr ( !k_trivial )
 			{
-				this->m_data.resize( ( this->m_size + count ) * 2 );
+				if ( new_size > this->m_constructed )
+				{
+					std::uninitialized_value_construct_n( this->m_data + this->m_constructed, new_size - this->m_constructed );
+					this->m_constructed = new_size;
+				}
 			}
 
-			T* result{ &this->m_data[ this->m_size ] };
-			this->m_size += count;
+			T* result{ this->m_data + this->m_size };
+			this->m_size = new_size;
+			this->m_peak = std::max( this->m_peak, new_size );
 			return result;
 		}
 
+		void trim( ) noexcept
+		{
+			this->m_window_peak = std::max( this->m_window_peak, this->m_size );
+
+			if ( ++this->m_window_frames < k_decay_frames )
+			{
+				return;
+			}
+
+			const auto keep_bytes{ std::max( this->m_floor_bytes, round_to_granularity( ( this->m_window_peak + this->m_window_peak / 4u ) * sizeof( T ) ) ) };
+
+			this->m_window_frames = 0u;
+			this->m_window_peak = this->m_size;
+
+			if ( keep_bytes * 2u > this->m_committed_bytes )
+			{
+				return;
+			}
+
+			if constexpr ( !k_trivial )
+			{
+				const auto keep_count{ keep_bytes / sizeof( T ) };
+				if ( this->m_constructed > keep_count )
+				{
+					std::destroy_n( this->m_data + keep_count, this->m_constructed - keep_count );
+					this->m_constructed = keep_count;
+				}
+			}
+
+			VirtualFree( reinterpret_cast< std::byte* >( this->m_data ) + keep_bytes, this->m_committed_bytes - keep_bytes, MEM_DECOMMIT );
+			this->m_committed_bytes = keep_bytes;
+		}
+
+		[[nodiscard]] nvec_stats stats( ) const noexcept
+		{
+			return { this->m_size, this->m_peak, this->m_committed_bytes, this->m_reserved_bytes };
+		}
+
 		[[nodiscard]] std::size_t size( ) const noexcept
 		{
 			return this->m_size;
@@ -120,39 +576,312 @@ namespace zdraw {
 
 		[[nodiscard]] const T* data( ) const noexcept
 		{
-			return this->m_data.data( );
+			return this->m_data;
 		}
 
 		[[nodiscard]] T* data( ) noexcept
 		{
-			return this->m_data.data( );
+			return this->m_data;
 		}
 
 		[[nodiscard]] std::span<const T> span( ) const noexcept
 		{
-			return std::span{ this->m_data.data( ), this->m_size };
+			return std::span{ this->m_data, this->m_size };
+		}
+	};
+
+	class frame_arena
+	{
+	public:
+		[[nodiscard]] void* allocate( std::size_t size, std::size_t alignment = alignof( std::max_align_t ) );
+		[[nodiscard]] void* reallocate( void* block, std::size_t old_size, std::size_t new_size, std::size_t alignment = alignof( std::max_align_t ) );
+		[[nodiscard]] std::string_view copy( std::string_view text );
+
+		template<typename T>
+		[[nodiscard]] std::span<T> allocate_array( std::size_t count )
+		{
+			static_assert( std::is_trivially_destructible_v<T>, "frame_arena never runs destructors" );
+
+			auto storage{ static_cast< T* >( this->allocate( count * sizeof( T ), alignof( T ) ) ) };
+			std::uninitialized_default_construct_n( storage, count );
+			return { storage, count };
+		}
+
+		void reset( ) noexcept;
+
+		[[nodiscard]] nvec_stats stats( ) const noexcept
+		{
+			return this->m_buffer.stats( );
+		}
+
+	private:
+		nvec<std::byte> m_buffer{};
+	};
+
+	[[nodiscard]] frame_arena& get_frame_arena( ) noexcept;
+
+	class frame_string
+	{
+	public:
+		frame_string( ) = default;
+		explicit frame_string( std::string_view text ) { this->append( text ); }
+
+		frame_string& append( std::string_view text );
+		frame_string& append( char c ) { return this->append( std::string_view{ &c, 1 } ); }
+
+		frame_string& operator+=( std::string_view text ) { return this->append( text ); }
+		frame_string& operator+=( char c ) { return this->append( c ); }
+
+		void clear( ) noexcept { this->m_size = 0; }
+
+		[[nodiscard]] bool empty( ) const noexcept { return this->m_size == 0; }
+		[[nodiscard]] std::size_t size( ) const noexcept { return this->m_size; }
+		[[nodiscard]] std::string_view view( ) const noexcept { return { this->m_data, this->m_size }; }
+
+		operator std::string_view( ) const noexcept { return this->view( ); }
+
+	private:
+		char* m_data{ nullptr };
+		std::size_t m_size{ 0 };
+		std::size_t m_capacity{ 0 };
+	};
+
+	template<typename T>
+	class frame_vector
+	{
+		static_assert( std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "frame_vector stores trivially copyable types only" );
+
+	public:
+		void push_back( const T& value )
+		{
+			if ( this->m_size == this->m_capacity )
+			{
+				this->reserve( std::max<std::size_t>( 8u, this->m_capacity * 2u ) );
+			}
+
+			this->m_data[ this->m_size++ ] = value;
+		}
+
+		void reserve( std::size_t capacity )
+		{
+			if ( capacity <= this->m_capacity )
+			{
+				return;
+			}
+
+			this->m_data = static_cast< T* >( get_frame_arena( ).reallocate( this->m_data, this->m_capacity * sizeof( T ), capacity * sizeof( T ), alignof( T ) ) );
+			this->m_capacity = capacity;
+		}
+
+		void clear( ) noexcept { this->m_size = 0; }
+
+		[[nodiscard]] bool empty( ) const noexcept { return this->m_size == 0; }
+		[[nodiscard]] std::size_t size( ) const noexcept { return this->m_size; }
+		[[nodiscard]] T* data( ) noexcept { return this->m_data; }
+		[[nodiscard]] const T* data( ) const noexcept { return this->m_data; }
+		[[nodiscard]] T* begin( ) noexcept { return this->m_data; }
+		[[nodiscard]] T* end( ) noexcept { return this->m_data + this->m_size; }
+		[[nodiscard]] const T* begin( ) const noexcept { return this->m_data; }
+		[[nodiscard]] const T* end( ) const noexcept { return this->m_data + this->m_size; }
+		[[nodiscard]] T& operator[]( std::size_t index ) noexcept { return this->m_data[ index ]; }
+		[[nodiscard]] const T& operator[]( std::size_t index ) const noexcept { return this->m_data[ index ]; }
+		[[nodiscard]] std::span<const T> span( ) const noexcept { return { this->m_data, this->m_size }; }
+
+	private:
+		T* m_data{ nullptr };
+		std::size_t m_size{ 0 };
+		std::size_t m_capacity{ 0 };
+	};
+
+	struct draw_list_stats
+	{
+		nvec_stats m_vertices{};
+		nvec_stats m_sdf_vertices{};
+		nvec_stats m_indices{};
+		nvec_stats m_commands{};
+		std::size_t m_scratch_committed_bytes{ 0 };
+	};
+
+	struct occluder
+	{
+		D3D11_RECT m_rect{};
+		std::uint32_t m_command{ 0 };
+	};
+
+	struct occlusion_stats
+	{
+		std::uint32_t m_culled_commands{ 0 };
+		std::uint32_t m_split_commands{ 0 };
+		std::uint64_t m_pixels_saved{ 0 };
+	};
+
+	struct prim_writer
+	{
+		vertex* m_vtx{ nullptr };
+		std::uint32_t* m_idx{ nullptr };
+		std::uint32_t m_vtx_index{ 0 };
+		blend m_blend{ blend::normal };
+		rgba m_color{};
+		rgba m_premultiplied{};
+		float m_pos_scale{ vertex_traits<vertex>::k_pos_scale };
+
+		void push_vertex( float x, float y, float u, float v, rgba color ) noexcept
+		{
+			if ( color.val != this->m_color.val )
+			{
+				this->m_color = color;
+				this->m_premultiplied = premultiply( color, this->m_blend );
+			}
+
+			vertex_traits<vertex>::store( *this->m_vtx++, x, y, u, v, this->m_premultiplied, this->m_pos_scale );
+			++this->m_vtx_index;
+		}
+
+		void push_index( std::uint32_t index ) noexcept
+		{
+			*this->m_idx++ = index;
+		}
+
+		void push_triangle( std::uint32_t a, std::uint32_t b, std::uint32_t c ) noexcept
+		{
+			this->m_idx[ 0 ] = a; this->m_idx[ 1 ] = b; this->m_idx[ 2 ] = c;
+			this->m_idx += 3;
+		}
+
+		void push_quad_indices( ) noexcept
+		{
+			const auto base{ this->m_vtx_index - 4u };
+			this->m_idx[ 0 ] = base; this->m_idx[ 1 ] = base + 1; this->m_idx[ 2 ] = base + 2;
+			this->m_idx[ 3 ] = base; this->m_idx[ 4 ] = base + 2; this->m_idx[ 5 ] = base + 3;
+			this->m_idx += 6;
+		}
+	};
+
+	struct deferred_prim
+	{
+		void( *m_emit )( const void* closure, prim_writer& writer ){ nullptr };
+		const void* m_closure{ nullptr };
+		std::uint32_t m_vtx_offset{ 0 };
+		std::uint32_t m_idx_offset{ 0 };
+		std::uint32_t m_vtx_count{ 0 };
+		blend m_blend{ blend::normal };
+	};
+
+	struct vertex_mark
+	{
+		std::uint32_t m_vertex{ 0 };
+		std::uint32_t m_sdf_vertex{ 0 };
+		std::uint32_t m_command{ 0 };
+	};
+
+	struct pending_transform
+	{
+		vertex_mark m_begin{};
+		mat2x3 m_transform{};
+	};
+
+	struct region_pass
+	{
+		ID3D11RenderTargetView* m_target{ nullptr };
+		D3D11_RECT m_rect{};
+		std::uint32_t m_first_command{ 0 };
+		std::uint32_t m_end_command{ 0 };
+	};
+
+	struct draw_channel
+	{
+		nvec<std::uint32_t> m_indices{};
+		nvec<draw_cmd> m_commands{};
+		nvec<deferred_prim> m_deferred_prims{};
+		nvec<occluder> m_occluders{};
+		nvec<region_pass> m_region_passes{};
+		std::uint32_t m_command_barrier{ 0 };
+
+		void clear( ) noexcept
+		{
+			this->m_indices.clear( );
+			this->m_commands.clear( );
+			this->m_deferred_prims.clear( );
+			this->m_occluders.clear( );
+			this->m_region_passes.clear( );
+			this->m_command_barrier = 0u;
+		}
+
+		void trim( ) noexcept
+		{
+			this->m_indices.trim( );
+			this->m_commands.trim( );
+			this->m_deferred_prims.trim( );
+			this->m_occluders.trim( );
+			this->m_region_passes.trim( );
+		}
+
+		[[nodiscard]] std::size_t committed_bytes( ) const noexcept
+		{
+			return this->m_indices.stats( ).m_committed_bytes + this->m_commands.stats( ).m_committed_bytes + this->m_deferred_prims.stats( ).m_committed_bytes +
+				this->m_occluders.stats( ).m_committed_bytes + this->m_region_passes.stats( ).m_committed_bytes;
 		}
 	};
 
 	struct draw_list
 	{
 		nvec<vertex> m_vertices{};
+		nvec<sdf_vertex> m_sdf_vertices{};
 		nvec<std::uint32_t> m_indices{};
 		nvec<draw_cmd> m_commands{};
-		std::vector<D3D11_RECT> m_clip_stack{};
+		std::vector<std::uint32_t> m_clip_stack{};
+		float m_pos_scale{ vertex_traits<vertex>::k_pos_scale };
+
+		std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures{};
+		ankerl::unordered_dense::map<ID3D11ShaderResourceView*, std::uint32_t> m_texture_lookup{};
+		nvec<D3D11_RECT> m_clip_rects{};
+		ankerl::unordered_dense::map<D3D11_RECT, std::uint32_t, clip_rect_hash, clip_rect_equal> m_clip_lookup{};
+
+		nvec<deferred_prim> m_deferred_prims{};
+		bool m_deferred{ false };
+
+		nvec<occluder> m_occluders{};
+		bool m_cull_occluded{ false };
+
+		nvec<region_pass> m_region_passes{};
+		std::uint32_t m_command_barrier{ 0 };
+
+		std::vector<blend> m_blend_stack{};
+		blend m_blend{ blend::normal };
+
+		std::vector<pending_transform> m_transform_stack{};
+
+		std::vector<draw_channel> m_channels{};
+		std::uint32_t m_channel_count{ 0 };
+		std::uint32_t m_current_channel{ 0 };
 
-		nvec<float> m_scratch_normals_x{};
-		nvec<float> m_scratch_normals_y{};
 		nvec<float> m_scratch_points{};
 		nvec<float> m_scratch_core_points{};
 		nvec<float> m_scratch_aa_points{};
+		nvec<float> m_scratch_path{};
+		nvec<std::uint32_t> m_scratch_indices{};
+		nvec<std::uint32_t> m_scratch_triangles{};
 
 		void clear( ) noexcept
 		{
 			this->m_vertices.clear( );
+			this->m_sdf_vertices.clear( );
 			this->m_indices.clear( );
 			this->m_commands.clear( );
 			this->m_clip_stack.clear( );
+			this->m_textures.clear( );
+			this->m_texture_lookup.clear( );
+			this->m_clip_rects.clear( );
+			this->m_clip_lookup.clear( );
+			this->m_deferred_prims.clear( );
+			this->m_occluders.clear( );
+			this->m_region_passes.clear( );
+			this->m_command_barrier = 0u;
+			this->m_blend_stack.clear( );
+			this->m_blend = blend::normal;
+			this->m_transform_stack.clear( );
+			this->m_channel_count = 0u;
+			this->m_current_channel = 0u;
 		}
 
 		void reserve( std::uint32_t vtx_count, std::uint32_t idx_count, std::uint32_t cmd_count = 0 )
@@ -162,26 +891,112 @@ namespace zdraw {
 			if ( cmd_count > 0 ) { this->m_commands.reserve( cmd_count ); }
 		}
 
-		void push_vertex( float x, float y, float u, float v, rgba color )
+		void trim( ) noexcept
+		{
+			this->m_vertices.trim( );
+			this->m_sdf_vertices.trim( );
+			this->m_indices.trim( );
+			this->m_commands.trim( );
+			this->m_clip_rects.trim( );
+			this->m_deferred_prims.trim( );
+			this->m_occluders.trim( );
+			this->m_region_passes.trim( );
+			this->m_scratch_points.trim( );
+			this->m_scratch_core_points.trim( );
+			this->m_scratch_aa_points.trim( );
+			this->m_scratch_path.trim( );
+			this->m_scratch_indices.trim( );
+			this->m_scratch_triangles.trim( );
+
+			for ( auto& channel : this->m_channels )
+			{
+				channel.trim( );
+			}
+		}
+
+		[[nodiscard]] draw_list_stats stats( ) const noexcept
 		{
-			vertex* vtx{ this->m_vertices.allocate( 1 ) };
-			vtx->m_pos[ 0 ] = x;
-			vtx->m_pos[ 1 ] = y;
-			vtx->m_uv[ 0 ] = u;
-			vtx->m_uv[ 1 ] = v;
-			vtx->m_col = color;
+			std::size_t channel_bytes{ 0 };
+			for ( const auto& channel : this->m_channels )
+			{
+				channel_bytes += channel.committed_bytes( );
+			}
+
+			return
+			{
+				this->m_vertices.stats( ),
+				this->m_sdf_vertices.stats( ),
+				this->m_indices.stats( ),
+				this->m_commands.stats( ),
+				this->m_deferred_prims.stats( ).m_committed_bytes + this->m_occluders.stats( ).m_committed_bytes + this->m_region_passes.stats( ).m_committed_bytes +
+					this->m_scratch_points.stats( ).m_committed_bytes + this->m_scratch_core_points.stats( ).m_committed_bytes + this->m_scratch_aa_points.stats( ).m_committed_bytes +
+					this->m_scratch_path.stats( ).m_committed_bytes + this->m_scratch_indices.stats( ).m_committed_bytes + this->m_scratch_triangles.stats( ).m_committed_bytes + channel_bytes
+			};
 		}
 
 		void push_clip_rect( float x0, float y0, float x1, float y1 );
 		void pop_clip_rect( );
 
-		void ensure_draw_cmd( ID3D11ShaderResourceView* texture );
+		void push_blend( blend mode );
+		void pop_blend( );
+
+		void push_transform( const mat2x3& transform );
+		void pop_transform( );
+
+		[[nodiscard]] vertex_mark mark( ) const noexcept
+		{
+			return { static_cast< std::uint32_t >( this->m_vertices.size( ) ), static_cast< std::uint32_t >( this->m_sdf_vertices.size( ) ), static_cast< std::uint32_t >( this->m_commands.size( ) ) };
+		}
+
+		void transform_range( const vertex_mark& begin, const vertex_mark& end, const mat2x3& transform );
+		void modulate_range( const vertex_mark& begin, const vertex_mark& end, rgba color );
+
+		[[nodiscard]] std::uint32_t intern_texture( ID3D11ShaderResourceView* texture );
+		[[nodiscard]] std::uint32_t intern_clip_rect( const D3D11_RECT& rect );
+
+		[[nodiscard]] ID3D11ShaderResourceView* texture_of( const draw_cmd& cmd ) const noexcept
+		{
+			return this->m_textures[ cmd.m_texture ].Get( );
+		}
+
+		[[nodiscard]] const D3D11_RECT& clip_rect_of( const draw_cmd& cmd ) const noexcept
+		{
+			return this->m_clip_rects.data( )[ cmd.m_clip ];
+		}
+
+		void ensure_draw_cmd( ID3D11ShaderResourceView* texture, draw_kind kind = draw_kind::geometry );
+		void flush_deferred( );
+
+		void split( std::uint32_t count );
+		void set_channel( std::uint32_t index );
+		void merge( );
+
+		[[nodiscard]] prim_writer prim_reserve( std::uint32_t vtx_count, std::uint32_t idx_count, ID3D11ShaderResourceView* texture = nullptr );
+
+		// single-vertex convenience kept from the original api; prefer prim_reserve when writing more than a few vertices
+		void push_vertex( float x, float y, float u, float v, rgba color )
+		{
+			this->prim_reserve( 1u, 0u ).push_vertex( x, y, u, v, color );
+		}
+
+		void add_occluder( float x, float y, float w, float h );
+
+		template<typename F>
+		void emit_prim( ID3D11ShaderResourceView* texture, std::uint32_t vtx_count, std::uint32_t idx_count, const F& emit );
+
+		template<typename F>
+		void emit_instances( ID3D11ShaderResourceView* texture, std::size_t count, std::uint32_t vtx_per_instance, std::uint32_t idx_per_instance, const F& emit );
+
+		template<typename T>
+		[[nodiscard]] std::span<const T> retain( std::span<const T> data );
+		[[nodiscard]] std::string_view retain( std::string_view text );
 
 		void add_line( float x0, float y0, float x1, float y1, rgba color, float thickness = 1.0f );
 		void add_rect( float x, float y, float w, float h, rgba color, float thickness = 1.0f );
 		void add_rect_cornered( float x, float y, float w, float h, rgba color, float corner_length, float thickness );
 		void add_rect_filled( float x, float y, float w, float h, rgba color );
 		void add_rect_filled_multi_color( float x, float y, float w, float h, rgba color_tl, rgba color_tr, rgba color_br, rgba color_bl );
+		// tex is blended as premultiplied alpha; textures loaded through zdraw already are, caller-created views must match
 		void add_rect_textured( float x, float y, float w, float h, ID3D11ShaderResourceView* tex, float u0 = 0.0f, float v0 = 0.0f, float u1 = 1.0f, float v1 = 1.0f, rgba color = rgba{ 255, 255, 255, 255 } );
 		void add_convex_poly_filled( std::span<const float> points, rgba color );
 		void add_polyline( std::span<const float> points, rgba color, bool closed = false, float thickness = 1.0f );
@@ -189,12 +1004,42 @@ namespace zdraw {
 		void add_triangle( float x0, float y0, float x1, float y1, float x2, float y2, rgba color, float thickness = 1.0f );
 		void add_triangle_filled( float x0, float y0, float x1, float y1, float x2, float y2, rgba color );
 		void add_triangle_filled_multi_color( float x0, float y0, float x1, float y1, float x2, float y2, rgba color0, rgba color1, rgba color2 );
+		void add_bezier_quadratic( float x0, float y0, float x1, float y1, float x2, float y2, rgba color, float thickness = 1.0f, float tolerance = 0.25f );
+		void add_bezier_cubic( float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3, rgba color, float thickness = 1.0f, float tolerance = 0.25f );
+		void add_catmull_rom( std::span<const float> points, rgba color, bool closed = false, float thickness = 1.0f, float tolerance = 0.25f );
+		void add_concave_poly_filled( std::span<const float> points, rgba color );
 		void add_circle( float x, float y, float radius, rgba color, int segments = 32, float thickness = 1.0f );
 		void add_circle_filled( float x, float y, float radius, rgba color, int segments = 32 );
 		void add_arc( float x, float y, float radius, float start_angle, float end_angle, rgba color, int segments = 32, float thickness = 1.0f );
 		void add_arc_filled( float x, float y, float radius, float start_angle, float end_angle, rgba color, int segments = 32 );
+		void add_rects_filled( std::span<const rect_instance> rects );
+		void add_rects_filled( const rect_instances_soa& rects );
+		void add_circles_filled( std::span<const circle_instance> circles, int segments = 32 );
+		void add_circles_filled( const circle_instances_soa& circles, int segments = 32 );
+		void add_lines( std::span<const line_instance> lines, float thickness = 1.0f );
+		void add_lines( const line_instances_soa& lines, float thickness = 1.0f );
 		void add_text( float x, float y, std::string_view text, rgba color, const font* font = nullptr );
 		void add_text_multi_color( float x, float y, std::string_view text, rgba color_tl, rgba color_tr, rgba color_br, rgba color_bl, const font* font = nullptr );
+		void add_text_effect( float x, float y, std::string_view text, rgba color, rgba effect_color, float offset_x, float offset_y, float radius, const font* font = nullptr );
+		void add_text_outlined( float x, float y, std::string_view text, rgba color, rgba outline_color, float thickness = 1.0f, const font* font = nullptr );
+		void add_text_shadowed( float x, float y, std::string_view text, rgba color, rgba shadow_color, float offset_x = 1.0f, float offset_y = 1.0f, const font* font = nullptr );
+
+		void path_clear( ) noexcept { this->m_scratch_path.clear( ); }
+		void path_move_to( float x, float y );
+		void path_line_to( float x, float y );
+		void path_arc_to( float x, float y, float radius, float start_angle, float end_angle, int segments = 32 );
+		void path_bezier_quadratic_to( float x1, float y1, float x2, float y2, float tolerance = 0.25f );
+		void path_bezier_to( float x1, float y1, float x2, float y2, float x3, float y3, float tolerance = 0.25f );
+		void path_fill( rgba color );
+		void path_stroke( rgba color, bool closed = false, float thickness = 1.0f );
+
+		void add_sdf_shape( const sdf_shape& shape, rgba color );
+		void add_rect_rounded( float x, float y, float w, float h, float radius, rgba color, float thickness = 1.0f );
+		void add_rect_rounded_filled( float x, float y, float w, float h, float radius, rgba color );
+		void add_disc( float x, float y, float radius, rgba color );
+		void add_ring( float x, float y, float radius, rgba color, float thickness = 1.0f );
+		void add_pill( float x, float y, float w, float h, rgba color );
+		void add_shadow( float x, float y, float w, float h, float radius, float blur, rgba color );
 	};
 
 	struct font_atlas
@@ -205,7 +1050,7 @@ namespace zdraw {
 		int m_height{ 0 };
 	};
 
-	struct glyph_cache_entry
+	struct baked_glyph
 	{
 		float m_advance_x{ 0.0f };
 		float m_quad_x0{ 0.0f };
@@ -219,6 +1064,27 @@ namespace zdraw {
 		bool m_valid{ false };
 	};
 
+	struct text_size_table
+	{
+		static constexpr std::size_t k_slot_count{ 4096u };
+		static constexpr std::size_t k_max_probes{ 8u };
+		static constexpr std::uint64_t k_empty_key{ 0u };
+		static constexpr std::uint64_t k_busy_key{ 1u };
+
+		struct slot
+		{
+			std::atomic<std::uint64_t> m_key{ k_empty_key };
+			std::atomic<std::uint64_t> m_size{ 0u };
+			std::atomic<std::uint64_t> m_length{ 0u };
+		};
+
+		std::array<slot, k_slot_count> m_slots{};
+
+		[[nodiscard]] bool find( std::uint64_t key, std::size_t length, float& width, float& height ) const noexcept;
+		void publish( std::uint64_t key, std::size_t length, float width, float height ) noexcept;
+		void clear( ) noexcept;
+	};
+
 	struct font
 	{
 		std::shared_ptr<font_atlas> m_atlas{};
@@ -228,48 +1094,112 @@ namespace zdraw {
 		float m_line_gap{ 0.0f };
 		float m_line_height{ 0.0f };
 
-		struct freetype_glyph_info
+		std::array<baked_glyph, 95> m_glyphs{};
+		mutable text_size_table m_text_sizes{};
+
+		[[nodiscard]] const baked_glyph& get_glyph( char c ) const noexcept;
+		void calc_text_size( std::string_view text, float& width, float& height ) const;
+		void clear_caches( ) const noexcept;
+	};
+
+	enum class texture_status { pending, ready, failed };
+
+	struct texture
+	{
+		Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_srv{};
+		int m_width{ 0 };
+		int m_height{ 0 };
+		std::size_t m_bytes{ 0 };
+		std::atomic<texture_status> m_status{ texture_status::pending };
+		std::atomic<ID3D11ShaderResourceView*> m_view{ nullptr };
+
+		[[nodiscard]] texture_status status( ) const noexcept
 		{
-			float m_advance_x{ 0.0f };
-			float m_bearing_x{ 0.0f };
-			float m_bearing_y{ 0.0f };
-			float m_width{ 0.0f };
-			float m_height{ 0.0f };
-			float m_atlas_x{ 0.0f };
-			float m_atlas_y{ 0.0f };
-		};
+			return this->m_status.load( std::memory_order_acquire );
+		}
 
-		std::array<freetype_glyph_info, 95> m_glyph_info{};
+		[[nodiscard]] bool ready( ) const noexcept
+		{
+			return this->status( ) == texture_status::ready;
+		}
 
-		struct string_hash
+		[[nodiscard]] ID3D11ShaderResourceView* get( ) const noexcept
 		{
-			using is_transparent = void;
-			using hash_type = std::hash<std::string_view>;
+			if ( !this->ready( ) )
+			{
+				return nullptr;
+			}
 
-			[[nodiscard]] std::size_t operator()( std::string_view sv ) const noexcept { return hash_type{}( sv ); }
-			[[nodiscard]] std::size_t operator()( const std::string& s ) const noexcept { return hash_type{}( s ); }
-		};
+			const auto view{ this->m_view.load( std::memory_order_acquire ) };
+			return view ? view : this->m_srv.Get( );
+		}
+	};
 
-		mutable ankerl::unordered_dense::map<char, glyph_cache_entry> m_glyph_cache{};
-		mutable ankerl::unordered_dense::map<std::string, std::pair<float, float>, string_hash, std::equal_to<>> m_text_size_cache{};
+	using texture_handle = std::shared_ptr<texture>;
 
-		[[nodiscard]] const glyph_cache_entry& get_glyph( char c ) const;
-		void calc_text_size( std::string_view text, float& width, float& height ) const;
-		void clear_caches( ) const noexcept;
+	struct texture_cache_stats
+	{
+		std::size_t m_entries{ 0 };
+		std::size_t m_bytes{ 0 };
+		std::size_t m_hits{ 0 };
+		std::size_t m_misses{ 0 };
 	};
 
 	[[nodiscard]] bool initialize( ID3D11Device* device, ID3D11DeviceContext* context );
 
+	enum class frame_status { rendered, unchanged };
+
 	void begin_frame( );
-	void end_frame( );
+	frame_status end_frame( );
+
+	[[nodiscard]] bool begin_frame_build( );
+	void end_frame_build( );
+	[[nodiscard]] frame_status submit_frame( );
+	void stop_frame_pipeline( ) noexcept;
+
+	void set_deferred_tessellation( bool enabled ) noexcept;
+	[[nodiscard]] bool get_deferred_tessellation( ) noexcept;
+
+	void set_skip_unchanged_frames( bool enabled ) noexcept;
+	[[nodiscard]] bool get_skip_unchanged_frames( ) noexcept;
+	void invalidate_frame( ) noexcept;
+	void invalidate_texture( ID3D11ShaderResourceView* view );
+
+	void set_deferred_contexts( bool enabled ) noexcept;
+	[[nodiscard]] bool get_deferred_contexts( ) noexcept;
+
+	void set_occlusion_culling( bool enabled ) noexcept;
+	[[nodiscard]] bool get_occlusion_culling( ) noexcept;
+	[[nodiscard]] occlusion_stats get_occlusion_stats( ) noexcept;
+
+	void begin_cached_region( std::uint64_t id, float x, float y, float w, float h, draw_layer layer = draw_layer::window );
+	void end_cached_region( );
+	void invalidate_cached_region( std::uint64_t id ) noexcept;
+	void clear_cached_regions( );
 
 	[[nodiscard]] draw_list& get_draw_list( draw_layer layer = draw_layer::window ) noexcept;
 	[[nodiscard]] std::pair<int, int> get_display_size( ) noexcept;
+	[[nodiscard]] draw_list_stats get_draw_list_stats( draw_layer layer = draw_layer::window ) noexcept;
+	[[nodiscard]] float evaluate_sdf_coverage( const sdf_shape& shape, float x, float y ) noexcept;
 
 	[[nodiscard]] Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_memory( std::span<const std::byte> data, int* out_width = nullptr, int* out_height = nullptr );
 	[[nodiscard]] Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_icon_from_memory( std::span<const std::byte> data, int* out_width = nullptr, int* out_height = nullptr );
 	[[nodiscard]] Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_file( std::string_view filepath, int* out_width = nullptr, int* out_height = nullptr );
 
+	[[nodiscard]] texture_handle load_texture_from_memory_async( std::span<const std::byte> data );
+	[[nodiscard]] texture_handle load_texture_from_file_async( std::string_view filepath );
+	void set_texture_upload_budget( std::uint32_t max_bytes_per_frame, float max_milliseconds_per_frame );
+	[[nodiscard]] std::size_t get_pending_texture_count( ) noexcept;
+
+	[[nodiscard]] texture_handle create_dynamic_texture( int width, int height, DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM, bool triple_buffered = false );
+	bool update_texture( const texture_handle& target, const D3D11_RECT& rect, const void* data, std::uint32_t pitch = 0u );
+
+	[[nodiscard]] texture_handle load_texture_cached_from_memory( std::span<const std::byte> data );
+	[[nodiscard]] texture_handle load_texture_cached_from_file( std::string_view filepath );
+	void purge_texture_cache( );
+	std::size_t trim_texture_cache( std::size_t max_bytes );
+	[[nodiscard]] texture_cache_stats get_texture_cache_stats( );
+
 	[[nodiscard]] font* add_font_from_memory( std::span<const std::byte> font_data, float size_pixels, int atlas_width = 512, int atlas_height = 512 );
 	[[nodiscard]] font* add_font_from_file( std::string_view filepath, float size_pixels, int atlas_width = 512, int atlas_height = 512 );
 	[[nodiscard]] font* get_font( ) noexcept;
@@ -0,0 +1,263 @@
+#include "zhash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined( __AVX2__ )
+#define ZHASH_AVX2
+#include <immintrin.h>
+#elif defined( _M_X64 ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define ZHASH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined( _MSC_VER ) && defined( _M_X64 )
+#include <intrin.h>
+#endif
+
+namespace zhash {
+
+	namespace detail {
+
+		static constexpr std::uint64_t k_prime32_1{ 0x9e3779b1u };
+		static constexpr std::uint64_t k_prime32_2{ 0x85ebca77u };
+		static constexpr std::uint64_t k_prime32_3{ 0xc2b2ae3du };
+		static constexpr std::uint64_t k_prime64_1{ 0x9e3779b185ebca87u };
+		static constexpr std::uint64_t k_prime64_2{ 0xc2b2ae3d27d4eb4fu };
+		static constexpr std::uint64_t k_prime64_3{ 0x165667b19e3779f9u };
+		static constexpr std::uint64_t k_prime64_4{ 0x85ebca77c2b2ae63u };
+		static constexpr std::uint64_t k_prime64_5{ 0x27d4eb2f165667c5u };
+
+		static constexpr std::size_t k_secret_words{ 24u };
+		static constexpr std::size_t k_scramble_offset{ 16u };
+
+		static constexpr std::array<std::uint64_t, k_secret_words> k_secret = [ ]
+			{
+				std::array<std::uint64_t, k_secret_words> secret{};
+				auto state{ k_prime64_1 };
+
+				for ( auto& word : secret )
+				{
+					state += 0x9e3779b97f4a7c15u;
+					auto z{ state };
+					z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9u;
+					z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebu;
+					word = z ^ ( z >> 31 );
+				}
+
+				return secret;
+			}( );
+
+		[[nodiscard]] static std::uint64_t mul128_fold64( std::uint64_t a, std::uint64_t b ) noexcept
+		{
+#if defined( _MSC_VER ) && defined( _M_X64 )
+			std::uint64_t high{};
+			const auto low{ _umul128( a, b, &high ) };
+			return low ^ high;
+#elif defined( __SIZEOF_INT128__ )
+			const auto product{ static_cast< unsigned __int128 >( a ) * b };
+			return static_cast< std::uint64_t >( product ) ^ static_cast< std::uint64_t >( product >> 64 );
+#else
+			const auto lo_lo{ ( a & 0xffffffffu ) * ( b & 0xffffffffu ) };
+			const auto hi_lo{ ( a >> 32 ) * ( b & 0xffffffffu ) };
+			const auto lo_hi{ ( a & 0xffffffffu ) * ( b >> 32 ) };
+			const auto hi_hi{ ( a >> 32 ) * ( b >> 32 ) };
+			const auto cross{ ( lo_lo >> 32 ) + ( hi_lo & 0xffffffffu ) + lo_hi };
+			const auto high{ ( hi_lo >> 32 ) + ( cross >> 32 ) + hi_hi };
+			const auto low{ ( cross << 32 ) | ( lo_lo & 0xffffffffu ) };
+			return low ^ high;
+#endif
+		}
+
+		[[nodiscard]] static std::uint64_t avalanche( std::uint64_t h ) noexcept
+		{
+			h ^= h >> 37;
+			h *= 0x165667919e3779f9u;
+			h ^= h >> 32;
+			return h;
+		}
+
+#if defined( ZHASH_AVX2 )
+		static void accumulate( std::uint64_t* acc, const std::byte* input, const std::uint64_t* secret, std::size_t stripes ) noexcept
+		{
+			auto acc0{ _mm256_load_si256( reinterpret_cast< const __m256i* >( acc ) ) };
+			auto acc1{ _mm256_load_si256( reinterpret_cast< const __m256i* >( acc ) + 1 ) };
+
+			for ( std::size_t s{ 0 }; s < stripes; ++s, input += 64, ++secret )
+			{
+				const auto data0{ _mm256_loadu_si256( reinterpret_cast< const __m256i* >( input ) ) };
+				const auto data1{ _mm256_loadu_si256( reinterpret_cast< const __m256i* >( input ) + 1 ) };
+				const auto key0{ _mm256_xor_si256( data0, _mm256_loadu_si256( reinterpret_cast< const __m256i* >( secret ) ) ) };
+				const auto key1{ _mm256_xor_si256( data1, _mm256_loadu_si256( reinterpret_cast< const __m256i* >( secret ) + 1 ) ) };
+
+				acc0 = _mm256_add_epi64( acc0, _mm256_add_epi64( _mm256_mul_epu32( key0, _mm256_shuffle_epi32( key0, _MM_SHUFFLE( 0, 3, 0, 1 ) ) ), _mm256_shuffle_epi32( data0, _MM_SHUFFLE( 1, 0, 3, 2 ) ) ) );
+				acc1 = _mm256_add_epi64( acc1, _mm256_add_epi64( _mm256_mul_epu32( key1, _mm256_shuffle_epi32( key1, _MM_SHUFFLE( 0, 3, 0, 1 ) ) ), _mm256_shuffle_epi32( data1, _MM_SHUFFLE( 1, 0, 3, 2 ) ) ) );
+			}
+
+			_mm256_store_si256( reinterpret_cast< __m256i* >( acc ), acc0 );
+			_mm256_store_si256( reinterpret_cast< __m256i* >( acc ) + 1, acc1 );
+		}
+#elif defined( ZHASH_SSE2 )
+		static void accumulate( std::uint64_t* acc, const std::byte* input, const std::uint64_t* secret, std::size_t stripes ) noexcept
+		{
+			__m128i lanes[ 4 ]{};
+			for ( int i{ 0 }; i < 4; ++i )
+			{
+				lanes[ i ] = _mm_load_si128( reinterpret_cast< const __m128i* >( acc ) + i );
+			}
+
+			for ( std::size_t s{ 0 }; s < stripes; ++s, input += 64, ++secret )
+			{
+				for ( int i{ 0 }; i < 4; ++i )
+				{
+					const auto data{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( input ) + i ) };
+					const auto key{ _mm_xor_si128( data, _mm_loadu_si128( reinterpret_cast< const __m128i* >( secret ) + i ) ) };
+					const auto product{ _mm_mul_epu32( key, _mm_shuffle_epi32( key, _MM_SHUFFLE( 0, 3, 0, 1 ) ) ) };
+					lanes[ i ] = _mm_add_epi64( lanes[ i ], _mm_add_epi64( product, _mm_shuffle_epi32( data, _MM_SHUFFLE( 1, 0, 3, 2 ) ) ) );
+				}
+			}
+
+			for ( int i{ 0 }; i < 4; ++i )
+			{
+				_mm_store_si128( reinterpret_cast< __m128i* >( acc ) + i, lanes[ i ] );
+			}
+		}
+#else
+		[[nodiscard]] static std::uint64_t read64( const std::byte* p ) noexcept
+		{
+			std::uint64_t value{};
+			std::memcpy( &value, p, sizeof( value ) );
+			return value;
+		}
+
+		static void accumulate( std::uint64_t* acc, const std::byte* input, const std::uint64_t* secret, std::size_t stripes ) noexcept
+		{
+			for ( std::size_t s{ 0 }; s < stripes; ++s, input += 64, ++secret )
+			{
+				for ( std::size_t i{ 0 }; i < 8u; ++i )
+				{
+					const auto data{ read64( input + i * 8u ) };
+					const auto key{ data ^ secret[ i ] };
+					acc[ i ^ 1u ] += data;
+					acc[ i ] += ( key & 0xffffffffu ) * ( key >> 32 );
+				}
+			}
+		}
+#endif
+
+		static void scramble( std::uint64_t* acc ) noexcept
+		{
+			for ( std::size_t i{ 0 }; i < 8u; ++i )
+			{
+				auto lane{ acc[ i ] };
+				lane ^= lane >> 47;
+				lane ^= k_secret[ k_scramble_offset + i ];
+				acc[ i ] = lane * k_prime32_1;
+			}
+		}
+
+	} // namespace detail
+
+	hasher::hasher( std::uint64_t seed ) noexcept
+		: m_acc{ detail::k_prime32_3, detail::k_prime64_1, detail::k_prime64_2, detail::k_prime64_3, detail::k_prime64_4, detail::k_prime32_2, detail::k_prime64_5, detail::k_prime32_1 }, m_seed{ seed }
+	{
+		for ( std::size_t i{ 0 }; i < 8u; i += 2u )
+		{
+			this->m_acc[ i ] += seed;
+			this->m_acc[ i + 1u ] -= seed;
+		}
+	}
+
+	void hasher::consume( const std::byte* input, std::size_t stripes ) noexcept
+	{
+		while ( stripes > 0u )
+		{
+			const auto count{ std::min( stripes, k_stripes_per_block - this->m_stripe_index ) };
+			detail::accumulate( this->m_acc, input, detail::k_secret.data( ) + this->m_stripe_index, count );
+
+			input += count * k_stripe_bytes;
+			stripes -= count;
+			this->m_stripe_index += count;
+
+			if ( this->m_stripe_index == k_stripes_per_block )
+			{
+				detail::scramble( this->m_acc );
+				this->m_stripe_index = 0u;
+			}
+		}
+	}
+
+	void hasher::update( std::span<const std::byte> data ) noexcept
+	{
+		if ( data.empty( ) )
+		{
+			return;
+		}
+
+		auto input{ data.data( ) };
+		auto remaining{ data.size( ) };
+		this->m_total += remaining;
+
+		if ( this->m_buffered > 0u )
+		{
+			const auto take{ std::min( remaining, k_stripe_bytes - this->m_buffered ) };
+			std::memcpy( this->m_buffer + this->m_buffered, input, take );
+
+			this->m_buffered += take;
+			input += take;
+			remaining -= take;
+
+			if ( this->m_buffered < k_stripe_bytes )
+			{
+				return;
+			}
+
+			this->consume( this->m_buffer, 1u );
+			this->m_buffered = 0u;
+		}
+
+		const auto stripes{ remaining / k_stripe_bytes };
+		if ( stripes > 0u )
+		{
+			this->consume( input, stripes );
+			input += stripes * k_stripe_bytes;
+			remaining -= stripes * k_stripe_bytes;
+		}
+
+		if ( remaining > 0u )
+		{
+			std::memcpy( this->m_buffer, input, remaining );
+			this->m_buffered = remaining;
+		}
+	}
+
+	std::uint64_t hasher::digest( ) const noexcept
+	{
+		alignas( 32 ) std::uint64_t acc[ 8 ]{};
+		std::memcpy( acc, this->m_acc, sizeof( acc ) );
+
+		if ( this->m_buffered > 0u )
+		{
+			std::byte tail[ k_stripe_bytes ]{};
+			std::memcpy( tail, this->m_buffer, this->m_buffered );
+			detail::accumulate( acc, tail, detail::k_secret.data( ) + this->m_stripe_index, 1u );
+		}
+
+		auto result{ this->m_total * detail::k_prime64_1 + this->m_seed };
+		for ( std::size_t i{ 0 }; i < 4u; ++i )
+		{
+			result += detail::mul128_fold64( acc[ i * 2u ] ^ detail::k_secret[ i * 2u + 1u ], acc[ i * 2u + 1u ] ^ detail::k_secret[ i * 2u + 2u ] );
+		}
+
+		return detail::avalanche( result );
+	}
+
+	std::uint64_t hash( std::span<const std::byte> data, std::uint64_t seed ) noexcept
+	{
+		hasher h{ seed };
+		h.update( data );
+		return h.digest( );
+	}
+
+} // namespace zhash
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace zhash {
+
+	class hasher
+	{
+	public:
+		explicit hasher( std::uint64_t seed = 0 ) noexcept;
+
+		void update( std::span<const std::byte> data ) noexcept;
+
+		template<typename T, std::size_t N>
+		void update_values( std::span<const T, N> values ) noexcept
+		{
+			this->update( std::as_bytes( values ) );
+		}
+
+		[[nodiscard]] std::uint64_t digest( ) const noexcept;
+
+	private:
+		static constexpr std::size_t k_stripe_bytes{ 64u };
+		static constexpr std::size_t k_stripes_per_block{ 16u };
+
+		void consume( const std::byte* input, std::size_t stripes ) noexcept;
+
+		alignas( 32 ) std::uint64_t m_acc[ 8 ]{};
+		alignas( 32 ) std::byte m_buffer[ k_stripe_bytes ]{};
+		std::size_t m_buffered{ 0 };
+		std::size_t m_stripe_index{ 0 };
+		std::uint64_t m_total{ 0 };
+		std::uint64_t m_seed{ 0 };
+	};
+
+	[[nodiscard]] std::uint64_t hash( std::span<const std::byte> data, std::uint64_t seed = 0 ) noexcept;
+
+} // namespace zhash
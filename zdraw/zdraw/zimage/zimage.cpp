@@ -0,0 +1,3012 @@
+#include "zimage.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define ZIMAGE_X86
+#include <immintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#define ZIMAGE_TARGET( x )
+#else
+#define ZIMAGE_TARGET( x ) __attribute__( ( target( x ) ) )
+#endif
+#endif
+
+namespace zimage {
+
+	namespace detail {
+
+		struct cpu_features
+		{
+			bool m_ssse3{ false };
+			bool m_avx2{ false };
+		};
+
+		[[nodiscard]] static const cpu_features& get_cpu_features( ) noexcept
+		{
+			static const cpu_features features = [ ]
+				{
+					cpu_features f{};
+
+#if defined( ZIMAGE_X86 ) && defined( _MSC_VER )
+					int regs[ 4 ]{};
+					__cpuid( regs, 0 );
+					const auto max_leaf{ regs[ 0 ] };
+
+					__cpuid( regs, 1 );
+					f.m_ssse3 = ( regs[ 2 ] & ( 1 << 9 ) ) != 0;
+
+					const auto has_osxsave{ ( regs[ 2 ] & ( 1 << 27 ) ) != 0 };
+					const auto has_avx{ ( regs[ 2 ] & ( 1 << 28 ) ) != 0 };
+
+					if ( max_leaf >= 7 && has_osxsave && has_avx && ( _xgetbv( 0 ) & 0x6 ) == 0x6 )
+					{
+						__cpuidex( regs, 7, 0 );
+						f.m_avx2 = ( regs[ 1 ] & ( 1 << 5 ) ) != 0;
+					}
+#elif defined( ZIMAGE_X86 )
+					__builtin_cpu_init( );
+					f.m_ssse3 = __builtin_cpu_supports( "ssse3" );
+					f.m_avx2 = __builtin_cpu_supports( "avx2" );
+#endif
+
+					return f;
+				}( );
+
+			return features;
+		}
+
+		[[nodiscard]] static constexpr std::uint8_t luminance_alpha( std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a ) noexcept
+		{
+			const auto luminance{ static_cast< std::uint8_t >( r * 0.299f + g * 0.587f + b * 0.114f ) };
+			return a < 250u ? a : static_cast< std::uint8_t >( 255u - luminance );
+		}
+
+		[[nodiscard]] static constexpr std::uint8_t mul_div_255( std::uint32_t a, std::uint32_t b ) noexcept
+		{
+			const auto t{ a * b + 128u };
+			return static_cast< std::uint8_t >( ( t + ( t >> 8 ) ) >> 8 );
+		}
+
+#if defined( ZIMAGE_X86 )
+
+		ZIMAGE_TARGET( "ssse3" ) static std::size_t shuffle3_ssse3( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count, __m128i mask ) noexcept
+		{
+			const auto alpha{ _mm_set1_epi32( static_cast< int >( 0xFF000000u ) ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 6 <= pixel_count; i += 4 )
+			{
+				const auto in{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( src + i * 3 ) ) };
+				_mm_storeu_si128( reinterpret_cast< __m128i* >( dst + i * 4 ), _mm_or_si128( _mm_shuffle_epi8( in, mask ), alpha ) );
+			}
+
+			return i;
+		}
+
+		ZIMAGE_TARGET( "ssse3" ) static std::size_t bgra_to_rgba_ssse3( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+		{
+			const auto mask{ _mm_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 4 <= pixel_count; i += 4 )
+			{
+				const auto in{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( src + i * 4 ) ) };
+				_mm_storeu_si128( reinterpret_cast< __m128i* >( dst + i * 4 ), _mm_shuffle_epi8( in, mask ) );
+			}
+
+			return i;
+		}
+
+		ZIMAGE_TARGET( "avx2" ) static std::size_t bgra_to_rgba_avx2( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+		{
+			const auto mask{ _mm256_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 8 <= pixel_count; i += 8 )
+			{
+				const auto in{ _mm256_loadu_si256( reinterpret_cast< const __m256i* >( src + i * 4 ) ) };
+				_mm256_storeu_si256( reinterpret_cast< __m256i* >( dst + i * 4 ), _mm256_shuffle_epi8( in, mask ) );
+			}
+
+			return i;
+		}
+
+		ZIMAGE_TARGET( "ssse3" ) static std::size_t gray_to_rgba_ssse3( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+		{
+			const auto alpha{ _mm_set1_epi32( static_cast< int >( 0xFF000000u ) ) };
+			const auto mask0{ _mm_setr_epi8( 0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1 ) };
+			const auto mask1{ _mm_setr_epi8( 4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1 ) };
+			const auto mask2{ _mm_setr_epi8( 8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1 ) };
+			const auto mask3{ _mm_setr_epi8( 12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1 ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 16 <= pixel_count; i += 16 )
+			{
+				const auto in{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( src + i ) ) };
+				auto out{ reinterpret_cast< __m128i* >( dst + i * 4 ) };
+				_mm_storeu_si128( out + 0, _mm_or_si128( _mm_shuffle_epi8( in, mask0 ), alpha ) );
+				_mm_storeu_si128( out + 1, _mm_or_si128( _mm_shuffle_epi8( in, mask1 ), alpha ) );
+				_mm_storeu_si128( out + 2, _mm_or_si128( _mm_shuffle_epi8( in, mask2 ), alpha ) );
+				_mm_storeu_si128( out + 3, _mm_or_si128( _mm_shuffle_epi8( in, mask3 ), alpha ) );
+			}
+
+			return i;
+		}
+
+		static std::size_t premultiply_sse2( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+		{
+			const auto zero{ _mm_setzero_si128( ) };
+			const auto bias{ _mm_set1_epi16( 128 ) };
+			const auto alpha_mask{ _mm_set1_epi32( static_cast< int >( 0xFF000000u ) ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 4 <= pixel_count; i += 4 )
+			{
+				auto ptr{ reinterpret_cast< __m128i* >( pixels + i * 4 ) };
+				const auto in{ _mm_loadu_si128( ptr ) };
+
+				auto lo{ _mm_unpacklo_epi8( in, zero ) };
+				auto hi{ _mm_unpackhi_epi8( in, zero ) };
+
+				const auto alpha_lo{ _mm_shufflehi_epi16( _mm_shufflelo_epi16( lo, 0xFF ), 0xFF ) };
+				const auto alpha_hi{ _mm_shufflehi_epi16( _mm_shufflelo_epi16( hi, 0xFF ), 0xFF ) };
+
+				lo = _mm_add_epi16( _mm_mullo_epi16( lo, alpha_lo ), bias );
+				hi = _mm_add_epi16( _mm_mullo_epi16( hi, alpha_hi ), bias );
+				lo = _mm_srli_epi16( _mm_add_epi16( lo, _mm_srli_epi16( lo, 8 ) ), 8 );
+				hi = _mm_srli_epi16( _mm_add_epi16( hi, _mm_srli_epi16( hi, 8 ) ), 8 );
+
+				const auto color{ _mm_andnot_si128( alpha_mask, _mm_packus_epi16( lo, hi ) ) };
+				_mm_storeu_si128( ptr, _mm_or_si128( color, _mm_and_si128( in, alpha_mask ) ) );
+			}
+
+			return i;
+		}
+
+		ZIMAGE_TARGET( "avx2" ) static std::size_t premultiply_avx2( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+		{
+			const auto zero{ _mm256_setzero_si256( ) };
+			const auto bias{ _mm256_set1_epi16( 128 ) };
+			const auto alpha_mask{ _mm256_set1_epi32( static_cast< int >( 0xFF000000u ) ) };
+			const auto alpha_shuffle{ _mm256_setr_epi8( 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15, 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15 ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 8 <= pixel_count; i += 8 )
+			{
+				auto ptr{ reinterpret_cast< __m256i* >( pixels + i * 4 ) };
+				const auto in{ _mm256_loadu_si256( ptr ) };
+
+				auto lo{ _mm256_unpacklo_epi8( in, zero ) };
+				auto hi{ _mm256_unpackhi_epi8( in, zero ) };
+
+				lo = _mm256_add_epi16( _mm256_mullo_epi16( lo, _mm256_shuffle_epi8( lo, alpha_shuffle ) ), bias );
+				hi = _mm256_add_epi16( _mm256_mullo_epi16( hi, _mm256_shuffle_epi8( hi, alpha_shuffle ) ), bias );
+				lo = _mm256_srli_epi16( _mm256_add_epi16( lo, _mm256_srli_epi16( lo, 8 ) ), 8 );
+				hi = _mm256_srli_epi16( _mm256_add_epi16( hi, _mm256_srli_epi16( hi, 8 ) ), 8 );
+
+				const auto color{ _mm256_andnot_si256( alpha_mask, _mm256_packus_epi16( lo, hi ) ) };
+				_mm256_storeu_si256( ptr, _mm256_or_si256( color, _mm256_and_si256( in, alpha_mask ) ) );
+			}
+
+			return i;
+		}
+
+		static std::size_t luminance_to_alpha_sse2( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+		{
+			const auto byte_mask{ _mm_set1_epi32( 0xFF ) };
+			const auto threshold{ _mm_set1_epi32( 250 ) };
+			const auto max_value{ _mm_set1_epi32( 255 ) };
+			const auto white{ _mm_set1_epi32( 0x00FFFFFF ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 4 <= pixel_count; i += 4 )
+			{
+				auto ptr{ reinterpret_cast< __m128i* >( pixels + i * 4 ) };
+				const auto in{ _mm_loadu_si128( ptr ) };
+
+				const auto r{ _mm_cvtepi32_ps( _mm_and_si128( in, byte_mask ) ) };
+				const auto g{ _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( in, 8 ), byte_mask ) ) };
+				const auto b{ _mm_cvtepi32_ps( _mm_and_si128( _mm_srli_epi32( in, 16 ), byte_mask ) ) };
+
+				const auto rg{ _mm_add_ps( _mm_mul_ps( r, _mm_set1_ps( 0.299f ) ), _mm_mul_ps( g, _mm_set1_ps( 0.587f ) ) ) };
+				const auto luminance{ _mm_cvttps_epi32( _mm_add_ps( rg, _mm_mul_ps( b, _mm_set1_ps( 0.114f ) ) ) ) };
+
+				const auto computed{ _mm_sub_epi32( max_value, luminance ) };
+				const auto alpha{ _mm_srli_epi32( in, 24 ) };
+				const auto keep{ _mm_cmplt_epi32( alpha, threshold ) };
+				const auto result{ _mm_or_si128( _mm_and_si128( keep, alpha ), _mm_andnot_si128( keep, computed ) ) };
+
+				_mm_storeu_si128( ptr, _mm_or_si128( _mm_slli_epi32( result, 24 ), white ) );
+			}
+
+			return i;
+		}
+
+		ZIMAGE_TARGET( "avx2" ) static std::size_t luminance_to_alpha_avx2( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+		{
+			const auto byte_mask{ _mm256_set1_epi32( 0xFF ) };
+			const auto threshold{ _mm256_set1_epi32( 250 ) };
+			const auto max_value{ _mm256_set1_epi32( 255 ) };
+			const auto white{ _mm256_set1_epi32( 0x00FFFFFF ) };
+
+			std::size_t i{ 0 };
+			for ( ; i + 8 <= pixel_count; i += 8 )
+			{
+				auto ptr{ reinterpret_cast< __m256i* >( pixels + i * 4 ) };
+				const auto in{ _mm256_loadu_si256( ptr ) };
+
+				const auto r{ _mm256_and_si256( in, byte_mask ) };
+				const auto g{ _mm256_and_si256( _mm256_srli_epi32( in, 8 ), byte_mask ) };
+				const auto b{ _mm256_and_si256( _mm256_srli_epi32( in, 16 ), byte_mask ) };
+
+				const auto rg{ _mm256_add_ps( _mm256_mul_ps( _mm256_cvtepi32_ps( r ), _mm256_set1_ps( 0.299f ) ), _mm256_mul_ps( _mm256_cvtepi32_ps( g ), _mm256_set1_ps( 0.587f ) ) ) };
+				const auto luminance{ _mm256_cvttps_epi32( _mm256_add_ps( rg, _mm256_mul_ps( _mm256_cvtepi32_ps( b ), _mm256_set1_ps( 0.114f ) ) ) ) };
+
+				const auto computed{ _mm256_sub_epi32( max_value, luminance ) };
+				const auto alpha{ _mm256_srli_epi32( in, 24 ) };
+				const auto keep{ _mm256_cmpgt_epi32( threshold, alpha ) };
+				const auto result{ _mm256_blendv_epi8( computed, alpha, keep ) };
+
+				_mm256_storeu_si256( ptr, _mm256_or_si256( _mm256_slli_epi32( result, 24 ), white ) );
+			}
+
+			return i;
+		}
+
+		static std::size_t downsample_row_sse2( const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* dst, std::size_t dst_width ) noexcept
+		{
+			const auto zero{ _mm_setzero_si128( ) };
+			const auto bias{ _mm_set1_epi16( 2 ) };
+
+			std::size_t x{ 0 };
+			for ( ; x + 2 <= dst_width; x += 2 )
+			{
+				const auto a{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( row0 + x * 8 ) ) };
+				const auto b{ _mm_loadu_si128( reinterpret_cast< const __m128i* >( row1 + x * 8 ) ) };
+
+				const auto lo{ _mm_add_epi16( _mm_unpacklo_epi8( a, zero ), _mm_unpacklo_epi8( b, zero ) ) };
+				const auto hi{ _mm_add_epi16( _mm_unpackhi_epi8( a, zero ), _mm_unpackhi_epi8( b, zero ) ) };
+
+				const auto pair_lo{ _mm_add_epi16( lo, _mm_srli_si128( lo, 8 ) ) };
+				const auto pair_hi{ _mm_add_epi16( hi, _mm_srli_si128( hi, 8 ) ) };
+				const auto sums{ _mm_srli_epi16( _mm_add_epi16( _mm_unpacklo_epi64( pair_lo, pair_hi ), bias ), 2 ) };
+
+				_mm_storel_epi64( reinterpret_cast< __m128i* >( dst + x * 4 ), _mm_packus_epi16( sums, sums ) );
+			}
+
+			return x;
+		}
+
+#endif
+
+	} // namespace detail
+
+	void rgb_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		if ( detail::get_cpu_features( ).m_ssse3 )
+		{
+			i = detail::shuffle3_ssse3( src, dst, pixel_count, _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 ) );
+		}
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			dst[ i * 4 + 0 ] = src[ i * 3 + 0 ];
+			dst[ i * 4 + 1 ] = src[ i * 3 + 1 ];
+			dst[ i * 4 + 2 ] = src[ i * 3 + 2 ];
+			dst[ i * 4 + 3 ] = 255u;
+		}
+	}
+
+	void bgr_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		if ( detail::get_cpu_features( ).m_ssse3 )
+		{
+			i = detail::shuffle3_ssse3( src, dst, pixel_count, _mm_setr_epi8( 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1 ) );
+		}
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			dst[ i * 4 + 0 ] = src[ i * 3 + 2 ];
+			dst[ i * 4 + 1 ] = src[ i * 3 + 1 ];
+			dst[ i * 4 + 2 ] = src[ i * 3 + 0 ];
+			dst[ i * 4 + 3 ] = 255u;
+		}
+	}
+
+	void bgra_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		const auto& features{ detail::get_cpu_features( ) };
+		if ( features.m_avx2 )
+		{
+			i = detail::bgra_to_rgba_avx2( src, dst, pixel_count );
+		}
+
+		if ( features.m_ssse3 )
+		{
+			i += detail::bgra_to_rgba_ssse3( src + i * 4, dst + i * 4, pixel_count - i );
+		}
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			const auto b{ src[ i * 4 + 0 ] };
+			dst[ i * 4 + 0 ] = src[ i * 4 + 2 ];
+			dst[ i * 4 + 1 ] = src[ i * 4 + 1 ];
+			dst[ i * 4 + 2 ] = b;
+			dst[ i * 4 + 3 ] = src[ i * 4 + 3 ];
+		}
+	}
+
+	void gray_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		if ( detail::get_cpu_features( ).m_ssse3 )
+		{
+			i = detail::gray_to_rgba_ssse3( src, dst, pixel_count );
+		}
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			dst[ i * 4 + 0 ] = src[ i ];
+			dst[ i * 4 + 1 ] = src[ i ];
+			dst[ i * 4 + 2 ] = src[ i ];
+			dst[ i * 4 + 3 ] = 255u;
+		}
+	}
+
+	void premultiply_alpha( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		if ( detail::get_cpu_features( ).m_avx2 )
+		{
+			i = detail::premultiply_avx2( pixels, pixel_count );
+		}
+
+		i += detail::premultiply_sse2( pixels + i * 4, pixel_count - i );
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			const auto a{ pixels[ i * 4 + 3 ] };
+			pixels[ i * 4 + 0 ] = detail::mul_div_255( pixels[ i * 4 + 0 ], a );
+			pixels[ i * 4 + 1 ] = detail::mul_div_255( pixels[ i * 4 + 1 ], a );
+			pixels[ i * 4 + 2 ] = detail::mul_div_255( pixels[ i * 4 + 2 ], a );
+		}
+	}
+
+	void luminance_to_alpha( std::uint8_t* pixels, std::size_t pixel_count ) noexcept
+	{
+		std::size_t i{ 0 };
+
+#if defined( ZIMAGE_X86 )
+		if ( detail::get_cpu_features( ).m_avx2 )
+		{
+			i = detail::luminance_to_alpha_avx2( pixels, pixel_count );
+		}
+
+		i += detail::luminance_to_alpha_sse2( pixels + i * 4, pixel_count - i );
+#endif
+
+		for ( ; i < pixel_count; ++i )
+		{
+			auto px{ pixels + i * 4 };
+			px[ 3 ] = detail::luminance_alpha( px[ 0 ], px[ 1 ], px[ 2 ], px[ 3 ] );
+			px[ 0 ] = 255u;
+			px[ 1 ] = 255u;
+			px[ 2 ] = 255u;
+		}
+	}
+
+	namespace detail {
+
+		[[nodiscard]] static std::uint16_t read_u16_be( const std::uint8_t* p ) noexcept
+		{
+			return static_cast< std::uint16_t >( ( p[ 0 ] << 8 ) | p[ 1 ] );
+		}
+
+		[[nodiscard]] static std::uint32_t read_u32_be( const std::uint8_t* p ) noexcept
+		{
+			return ( static_cast< std::uint32_t >( p[ 0 ] ) << 24 ) | ( static_cast< std::uint32_t >( p[ 1 ] ) << 16 ) | ( static_cast< std::uint32_t >( p[ 2 ] ) << 8 ) | p[ 3 ];
+		}
+
+		[[nodiscard]] static std::uint16_t read_u16_le( const std::uint8_t* p ) noexcept
+		{
+			return static_cast< std::uint16_t >( p[ 0 ] | ( p[ 1 ] << 8 ) );
+		}
+
+		[[nodiscard]] static std::uint32_t read_u32_le( const std::uint8_t* p ) noexcept
+		{
+			return p[ 0 ] | ( static_cast< std::uint32_t >( p[ 1 ] ) << 8 ) | ( static_cast< std::uint32_t >( p[ 2 ] ) << 16 ) | ( static_cast< std::uint32_t >( p[ 3 ] ) << 24 );
+		}
+
+		[[nodiscard]] static bool allocate_image( image& out, std::uint32_t width, std::uint32_t height )
+		{
+			if ( width == 0u || height == 0u || width > k_max_dimension || height > k_max_dimension ) [[unlikely]]
+			{
+				return false;
+			}
+
+			out.m_width = width;
+			out.m_height = height;
+			out.m_pixels.resize( static_cast< std::size_t >( width ) * height * 4u );
+			return true;
+		}
+
+		class inflater
+		{
+		public:
+			inflater( std::span<const std::uint8_t> data ) : m_data{ data } {}
+
+			[[nodiscard]] bool inflate_zlib( std::vector<std::uint8_t>& out, std::size_t limit )
+			{
+				if ( this->m_data.size( ) < 2u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				const auto cmf{ this->m_data[ 0 ] };
+				const auto flg{ this->m_data[ 1 ] };
+
+				if ( ( cmf & 0x0F ) != 8 || ( ( cmf << 8 ) | flg ) % 31 != 0 || ( flg & 0x20 ) != 0 ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_position = 2u;
+				this->m_limit = limit;
+				return this->inflate( out );
+			}
+
+		private:
+			struct huffman
+			{
+				std::array<std::uint16_t, 512> m_fast{};
+				std::array<std::uint16_t, 16> m_first_code{};
+				std::array<std::uint16_t, 16> m_first_symbol{};
+				std::array<std::uint32_t, 17> m_max_code{};
+				std::array<std::uint16_t, 288> m_symbols{};
+				std::array<std::uint8_t, 288> m_lengths{};
+
+				[[nodiscard]] bool build( const std::uint8_t* lengths, int count )
+				{
+					std::array<int, 17> sizes{};
+					for ( int i{ 0 }; i < count; ++i )
+					{
+						++sizes[ lengths[ i ] ];
+					}
+
+					sizes[ 0 ] = 0;
+					for ( int i{ 1 }; i < 16; ++i )
+					{
+						if ( sizes[ i ] > ( 1 << i ) ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+
+					std::array<int, 16> next_code{};
+					int code{ 0 };
+					int symbol{ 0 };
+
+					for ( int i{ 1 }; i < 16; ++i )
+					{
+						next_code[ i ] = code;
+						this->m_first_code[ i ] = static_cast< std::uint16_t >( code );
+						this->m_first_symbol[ i ] = static_cast< std::uint16_t >( symbol );
+						code += sizes[ i ];
+
+						if ( sizes[ i ] != 0 && code - 1 >= ( 1 << i ) ) [[unlikely]]
+						{
+							return false;
+						}
+
+						this->m_max_code[ i ] = static_cast< std::uint32_t >( code ) << ( 16 - i );
+						code <<= 1;
+						symbol += sizes[ i ];
+					}
+
+					this->m_max_code[ 16 ] = 0x10000u;
+					this->m_fast.fill( 0 );
+
+					for ( int i{ 0 }; i < count; ++i )
+					{
+						const auto length{ lengths[ i ] };
+						if ( length == 0 )
+						{
+							continue;
+						}
+
+						const auto slot{ next_code[ length ] - this->m_first_code[ length ] + this->m_first_symbol[ length ] };
+						this->m_lengths[ slot ] = length;
+						this->m_symbols[ slot ] = static_cast< std::uint16_t >( i );
+
+						if ( length <= 9 )
+						{
+							const auto entry{ static_cast< std::uint16_t >( ( length << 9 ) | i ) };
+							for ( auto j{ reverse_bits( next_code[ length ], length ) }; j < 512; j += 1 << length )
+							{
+								this->m_fast[ j ] = entry;
+							}
+						}
+
+						++next_code[ length ];
+					}
+
+					return true;
+				}
+			};
+
+			[[nodiscard]] static int reverse_bits( int value, int bits ) noexcept
+			{
+				int result{ 0 };
+				for ( int i{ 0 }; i < bits; ++i )
+				{
+					result = ( result << 1 ) | ( value & 1 );
+					value >>= 1;
+				}
+
+				return result;
+			}
+
+			void refill( ) noexcept
+			{
+				while ( this->m_bit_count <= 56 )
+				{
+					std::uint64_t byte{ 0 };
+					if ( this->m_position < this->m_data.size( ) )
+					{
+						byte = this->m_data[ this->m_position ];
+					}
+					else
+					{
+						++this->m_overrun;
+					}
+
+					++this->m_position;
+					this->m_bits |= byte << this->m_bit_count;
+					this->m_bit_count += 8;
+				}
+			}
+
+			[[nodiscard]] std::uint32_t read_bits( int count ) noexcept
+			{
+				if ( this->m_bit_count < count )
+				{
+					this->refill( );
+				}
+
+				const auto value{ static_cast< std::uint32_t >( this->m_bits & ( ( 1ull << count ) - 1u ) ) };
+				this->m_bits >>= count;
+				this->m_bit_count -= count;
+				return value;
+			}
+
+			[[nodiscard]] int decode( const huffman& table ) noexcept
+			{
+				if ( this->m_bit_count < 16 )
+				{
+					this->refill( );
+				}
+
+				const auto fast{ table.m_fast[ this->m_bits & 511u ] };
+				if ( fast != 0 )
+				{
+					const auto length{ fast >> 9 };
+					this->m_bits >>= length;
+					this->m_bit_count -= length;
+					return fast & 511;
+				}
+
+				const auto code{ static_cast< std::uint32_t >( reverse_bits( static_cast< int >( this->m_bits & 0xFFFFu ), 16 ) ) };
+
+				int length{ 10 };
+				while ( length < 16 && code >= table.m_max_code[ length ] )
+				{
+					++length;
+				}
+
+				if ( length >= 16 ) [[unlikely]]
+				{
+					return -1;
+				}
+
+				const auto slot{ ( code >> ( 16 - length ) ) - table.m_first_code[ length ] + table.m_first_symbol[ length ] };
+				if ( slot >= 288u || table.m_lengths[ slot ] != length ) [[unlikely]]
+				{
+					return -1;
+				}
+
+				this->m_bits >>= length;
+				this->m_bit_count -= length;
+				return table.m_symbols[ slot ];
+			}
+
+			[[nodiscard]] bool inflate_stored( std::vector<std::uint8_t>& out )
+			{
+				const auto discard{ this->m_bit_count & 7 };
+				this->m_bits >>= discard;
+				this->m_bit_count -= discard;
+
+				auto length{ this->read_bits( 16 ) };
+				const auto inverse{ this->read_bits( 16 ) };
+
+				if ( ( length ^ 0xFFFFu ) != inverse || length > this->m_limit - out.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				while ( length > 0u && this->m_bit_count > 0 )
+				{
+					out.push_back( static_cast< std::uint8_t >( this->read_bits( 8 ) ) );
+					--length;
+				}
+
+				if ( length == 0u )
+				{
+					return true;
+				}
+
+				if ( this->m_position + length > this->m_data.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				const auto begin{ this->m_data.begin( ) + static_cast< std::ptrdiff_t >( this->m_position ) };
+				out.insert( out.end( ), begin, begin + length );
+				this->m_position += length;
+				return true;
+			}
+
+			[[nodiscard]] bool read_dynamic_tables( huffman& literals, huffman& distances )
+			{
+				static constexpr std::uint8_t k_length_order[ 19 ]{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+				const auto literal_count{ static_cast< int >( this->read_bits( 5 ) ) + 257 };
+				const auto distance_count{ static_cast< int >( this->read_bits( 5 ) ) + 1 };
+				const auto code_length_count{ static_cast< int >( this->read_bits( 4 ) ) + 4 };
+
+				std::array<std::uint8_t, 19> code_length_sizes{};
+				for ( int i{ 0 }; i < code_length_count; ++i )
+				{
+					code_length_sizes[ k_length_order[ i ] ] = static_cast< std::uint8_t >( this->read_bits( 3 ) );
+				}
+
+				huffman code_lengths{};
+				if ( !code_lengths.build( code_length_sizes.data( ), 19 ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				std::array<std::uint8_t, 286 + 32> lengths{};
+				const auto total{ literal_count + distance_count };
+
+				for ( int n{ 0 }; n < total; )
+				{
+					const auto symbol{ this->decode( code_lengths ) };
+					if ( symbol < 0 || symbol >= 19 ) [[unlikely]]
+					{
+						return false;
+					}
+
+					if ( symbol < 16 )
+					{
+						lengths[ n++ ] = static_cast< std::uint8_t >( symbol );
+						continue;
+					}
+
+					std::uint8_t fill{ 0 };
+					int repeat{ 0 };
+
+					if ( symbol == 16 )
+					{
+						if ( n == 0 ) [[unlikely]]
+						{
+							return false;
+						}
+
+						fill = lengths[ n - 1 ];
+						repeat = static_cast< int >( this->read_bits( 2 ) ) + 3;
+					}
+					else if ( symbol == 17 )
+					{
+						repeat = static_cast< int >( this->read_bits( 3 ) ) + 3;
+					}
+					else
+					{
+						repeat = static_cast< int >( this->read_bits( 7 ) ) + 11;
+					}
+
+					if ( n + repeat > total ) [[unlikely]]
+					{
+						return false;
+					}
+
+					std::fill_n( lengths.begin( ) + n, repeat, fill );
+					n += repeat;
+				}
+
+				return literals.build( lengths.data( ), literal_count ) && distances.build( lengths.data( ) + literal_count, distance_count );
+			}
+
+			[[nodiscard]] bool inflate_block( std::vector<std::uint8_t>& out, const huffman& literals, const huffman& distances )
+			{
+				static constexpr std::uint16_t k_length_base[ 29 ]{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+				static constexpr std::uint8_t k_length_extra[ 29 ]{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+				static constexpr std::uint16_t k_distance_base[ 30 ]{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+				static constexpr std::uint8_t k_distance_extra[ 30 ]{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+				for ( ;; )
+				{
+					const auto symbol{ this->decode( literals ) };
+
+					if ( symbol < 256 )
+					{
+						if ( symbol < 0 || this->m_overrun > 8u || out.size( ) >= this->m_limit ) [[unlikely]]
+						{
+							return false;
+						}
+
+						out.push_back( static_cast< std::uint8_t >( symbol ) );
+						continue;
+					}
+
+					if ( symbol == 256 )
+					{
+						return this->m_overrun <= 8u;
+					}
+
+					if ( symbol > 285 || this->m_overrun > 8u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto length_index{ symbol - 257 };
+					const auto length{ static_cast< std::size_t >( k_length_base[ length_index ] + this->read_bits( k_length_extra[ length_index ] ) ) };
+
+					const auto distance_symbol{ this->decode( distances ) };
+					if ( distance_symbol < 0 || distance_symbol >= 30 ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto distance{ static_cast< std::size_t >( k_distance_base[ distance_symbol ] + this->read_bits( k_distance_extra[ distance_symbol ] ) ) };
+					if ( distance > out.size( ) || length > this->m_limit - out.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto start{ out.size( ) };
+					out.resize( start + length );
+
+					auto dst{ out.data( ) + start };
+					const auto* src{ dst - distance };
+
+					if ( distance >= length )
+					{
+						std::memcpy( dst, src, length );
+					}
+					else
+					{
+						for ( std::size_t i{ 0 }; i < length; ++i )
+						{
+							dst[ i ] = src[ i ];
+						}
+					}
+				}
+			}
+
+			[[nodiscard]] bool inflate( std::vector<std::uint8_t>& out )
+			{
+				static const auto fixed_tables = [ ]
+					{
+						std::array<std::uint8_t, 288> literal_lengths{};
+						std::fill_n( literal_lengths.begin( ), 144, std::uint8_t{ 8 } );
+						std::fill_n( literal_lengths.begin( ) + 144, 112, std::uint8_t{ 9 } );
+						std::fill_n( literal_lengths.begin( ) + 256, 24, std::uint8_t{ 7 } );
+						std::fill_n( literal_lengths.begin( ) + 280, 8, std::uint8_t{ 8 } );
+
+						std::array<std::uint8_t, 30> distance_lengths{};
+						distance_lengths.fill( 5 );
+
+						std::pair<huffman, huffman> tables{};
+						( void )tables.first.build( literal_lengths.data( ), 288 );
+						( void )tables.second.build( distance_lengths.data( ), 30 );
+						return tables;
+					}( );
+
+				for ( bool final_block{ false }; !final_block; )
+				{
+					final_block = this->read_bits( 1 ) != 0u;
+					const auto type{ this->read_bits( 2 ) };
+
+					if ( type == 0u )
+					{
+						if ( !this->inflate_stored( out ) ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+					else if ( type == 1u )
+					{
+						if ( !this->inflate_block( out, fixed_tables.first, fixed_tables.second ) ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+					else if ( type == 2u )
+					{
+						huffman literals{};
+						huffman distances{};
+
+						if ( !this->read_dynamic_tables( literals, distances ) || !this->inflate_block( out, literals, distances ) ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+					else [[unlikely]]
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			std::span<const std::uint8_t> m_data{};
+			std::size_t m_position{ 0 };
+			std::uint64_t m_bits{ 0 };
+			int m_bit_count{ 0 };
+			std::size_t m_overrun{ 0 };
+			std::size_t m_limit{ 0 };
+		};
+
+		class png_decoder
+		{
+		public:
+			png_decoder( std::span<const std::uint8_t> data ) : m_data{ data } {}
+
+			[[nodiscard]] bool decode( image& out )
+			{
+				if ( !this->read_chunks( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				std::vector<std::uint8_t> filtered{};
+				filtered.reserve( this->raw_size( ) );
+
+				if ( !inflater{ this->m_compressed }.inflate_zlib( filtered, this->raw_size( ) ) || filtered.size( ) < this->raw_size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				if ( !allocate_image( out, this->m_width, this->m_height ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				if ( this->m_interlace == 0u )
+				{
+					return this->decode_pass( filtered.data( ), this->m_width, this->m_height, out, 0u, 0u, 1u, 1u );
+				}
+
+				auto pass_data{ filtered.data( ) };
+				for ( const auto& pass : k_adam7 )
+				{
+					if ( this->m_width <= pass[ 0 ] || this->m_height <= pass[ 1 ] )
+					{
+						continue;
+					}
+
+					const auto pass_width{ ( this->m_width - pass[ 0 ] + pass[ 2 ] - 1u ) / pass[ 2 ] };
+					const auto pass_height{ ( this->m_height - pass[ 1 ] + pass[ 3 ] - 1u ) / pass[ 3 ] };
+
+					if ( !this->decode_pass( pass_data, pass_width, pass_height, out, pass[ 0 ], pass[ 1 ], pass[ 2 ], pass[ 3 ] ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					pass_data += ( this->row_bytes( pass_width ) + 1u ) * pass_height;
+				}
+
+				return true;
+			}
+
+		private:
+			static constexpr std::uint32_t k_adam7[ 7 ][ 4 ]
+			{
+				{ 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 },
+			};
+
+			[[nodiscard]] bool read_chunks( )
+			{
+				static constexpr std::uint8_t k_signature[ 8 ]{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+				if ( this->m_data.size( ) < 8u || std::memcmp( this->m_data.data( ), k_signature, 8u ) != 0 ) [[unlikely]]
+				{
+					return false;
+				}
+
+				bool has_header{ false };
+				std::size_t position{ 8u };
+
+				while ( position + 12u <= this->m_data.size( ) )
+				{
+					const auto length{ read_u32_be( this->m_data.data( ) + position ) };
+					const auto type{ this->m_data.data( ) + position + 4u };
+					const auto chunk{ this->m_data.data( ) + position + 8u };
+
+					if ( length > this->m_data.size( ) - position - 12u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					if ( std::memcmp( type, "IHDR", 4u ) == 0 )
+					{
+						if ( length < 13u ) [[unlikely]]
+						{
+							return false;
+						}
+
+						this->m_width = read_u32_be( chunk );
+						this->m_height = read_u32_be( chunk + 4u );
+						this->m_depth = chunk[ 8 ];
+						this->m_color_type = chunk[ 9 ];
+						this->m_interlace = chunk[ 12 ];
+						has_header = true;
+
+						if ( chunk[ 10 ] != 0u || chunk[ 11 ] != 0u || this->m_interlace > 1u ) [[unlikely]]
+						{
+							return false;
+						}
+
+						if ( this->m_width == 0u || this->m_height == 0u || this->m_width > k_max_dimension || this->m_height > k_max_dimension ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+					else if ( std::memcmp( type, "PLTE", 4u ) == 0 )
+					{
+						const auto entries{ std::min<std::uint32_t>( length / 3u, 256u ) };
+						for ( std::uint32_t i{ 0 }; i < entries; ++i )
+						{
+							this->m_palette[ i ] = { chunk[ i * 3u + 0u ], chunk[ i * 3u + 1u ], chunk[ i * 3u + 2u ], 255u };
+						}
+					}
+					else if ( std::memcmp( type, "tRNS", 4u ) == 0 )
+					{
+						this->m_has_transparency = true;
+
+						if ( this->m_color_type == 3u )
+						{
+							const auto entries{ std::min<std::uint32_t>( length, 256u ) };
+							for ( std::uint32_t i{ 0 }; i < entries; ++i )
+							{
+								this->m_palette[ i ][ 3 ] = chunk[ i ];
+							}
+						}
+						else if ( this->m_color_type == 0u && length >= 2u )
+						{
+							this->m_transparent_key = { read_u16_be( chunk ), read_u16_be( chunk ), read_u16_be( chunk ) };
+						}
+						else if ( this->m_color_type == 2u && length >= 6u )
+						{
+							this->m_transparent_key = { read_u16_be( chunk ), read_u16_be( chunk + 2u ), read_u16_be( chunk + 4u ) };
+						}
+					}
+					else if ( std::memcmp( type, "IDAT", 4u ) == 0 )
+					{
+						if ( this->m_compressed.empty( ) )
+						{
+							this->m_compressed.reserve( this->m_data.size( ) - position );
+						}
+
+						this->m_compressed.insert( this->m_compressed.end( ), chunk, chunk + length );
+					}
+					else if ( std::memcmp( type, "IEND", 4u ) == 0 )
+					{
+						break;
+					}
+
+					position += length + 12u;
+				}
+
+				if ( !has_header || this->m_compressed.empty( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				switch ( this->m_color_type )
+				{
+				case 0: this->m_channels = 1u; break;
+				case 2: this->m_channels = 3u; break;
+				case 3: this->m_channels = 1u; break;
+				case 4: this->m_channels = 2u; break;
+				case 6: this->m_channels = 4u; break;
+				default: return false;
+				}
+
+				const auto valid_depth{ this->m_color_type == 0u ? ( this->m_depth == 1u || this->m_depth == 2u || this->m_depth == 4u || this->m_depth == 8u || this->m_depth == 16u ) :
+					this->m_color_type == 3u ? ( this->m_depth == 1u || this->m_depth == 2u || this->m_depth == 4u || this->m_depth == 8u ) : ( this->m_depth == 8u || this->m_depth == 16u ) };
+
+				return valid_depth && this->m_width != 0u && this->m_height != 0u && this->m_width <= ( 1u << 15 ) && this->m_height <= ( 1u << 15 );
+			}
+
+			[[nodiscard]] std::size_t row_bytes( std::uint32_t width ) const noexcept
+			{
+				return ( static_cast< std::size_t >( width ) * this->m_channels * this->m_depth + 7u ) / 8u;
+			}
+
+			[[nodiscard]] std::size_t raw_size( ) const noexcept
+			{
+				if ( this->m_interlace == 0u )
+				{
+					return ( this->row_bytes( this->m_width ) + 1u ) * this->m_height;
+				}
+
+				std::size_t total{ 0 };
+				for ( const auto& pass : k_adam7 )
+				{
+					if ( this->m_width <= pass[ 0 ] || this->m_height <= pass[ 1 ] )
+					{
+						continue;
+					}
+
+					const auto pass_width{ ( this->m_width - pass[ 0 ] + pass[ 2 ] - 1u ) / pass[ 2 ] };
+					const auto pass_height{ ( this->m_height - pass[ 1 ] + pass[ 3 ] - 1u ) / pass[ 3 ] };
+					total += ( this->row_bytes( pass_width ) + 1u ) * pass_height;
+				}
+
+				return total;
+			}
+
+			[[nodiscard]] static std::uint8_t paeth( int a, int b, int c ) noexcept
+			{
+				const auto p{ a + b - c };
+				const auto pa{ std::abs( p - a ) };
+				const auto pb{ std::abs( p - b ) };
+				const auto pc{ std::abs( p - c ) };
+
+				if ( pa <= pb && pa <= pc )
+				{
+					return static_cast< std::uint8_t >( a );
+				}
+
+				return static_cast< std::uint8_t >( pb <= pc ? b : c );
+			}
+
+			[[nodiscard]] bool unfilter_row( std::uint8_t filter, std::uint8_t* row, const std::uint8_t* prior, std::size_t length ) const noexcept
+			{
+				const auto bpp{ std::max<std::size_t>( 1u, this->m_channels * this->m_depth / 8u ) };
+
+				switch ( filter )
+				{
+				case 0:
+					break;
+				case 1:
+					for ( std::size_t i{ bpp }; i < length; ++i )
+					{
+						row[ i ] = static_cast< std::uint8_t >( row[ i ] + row[ i - bpp ] );
+					}
+					break;
+				case 2:
+					for ( std::size_t i{ 0 }; i < length; ++i )
+					{
+						row[ i ] = static_cast< std::uint8_t >( row[ i ] + prior[ i ] );
+					}
+					break;
+				case 3:
+					for ( std::size_t i{ 0 }; i < length; ++i )
+					{
+						const auto left{ i >= bpp ? row[ i - bpp ] : 0u };
+						row[ i ] = static_cast< std::uint8_t >( row[ i ] + ( ( left + prior[ i ] ) >> 1 ) );
+					}
+					break;
+				case 4:
+					for ( std::size_t i{ 0 }; i < length; ++i )
+					{
+						const auto left{ i >= bpp ? row[ i - bpp ] : 0 };
+						const auto upper_left{ i >= bpp ? prior[ i - bpp ] : 0 };
+						row[ i ] = static_cast< std::uint8_t >( row[ i ] + paeth( left, prior[ i ], upper_left ) );
+					}
+					break;
+				default:
+					return false;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] std::uint32_t sample( const std::uint8_t* row, std::uint32_t index ) const noexcept
+			{
+				switch ( this->m_depth )
+				{
+				case 16: return read_u16_be( row + index * 2u );
+				case 8: return row[ index ];
+				default:
+				{
+					const auto bit{ index * this->m_depth };
+					const auto shift{ 8u - this->m_depth - ( bit & 7u ) };
+					return ( row[ bit >> 3 ] >> shift ) & ( ( 1u << this->m_depth ) - 1u );
+				}
+				}
+			}
+
+			void convert_row( const std::uint8_t* row, std::uint32_t width, std::uint8_t* dst, std::size_t dst_stride ) const noexcept
+			{
+				if ( this->m_depth == 8u && dst_stride == 4u && !this->m_has_transparency )
+				{
+					switch ( this->m_color_type )
+					{
+					case 0: gray_to_rgba( row, dst, width ); return;
+					case 2: rgb_to_rgba( row, dst, width ); return;
+					case 6: std::memcpy( dst, row, static_cast< std::size_t >( width ) * 4u ); return;
+					default: break;
+					}
+				}
+
+				const auto max_value{ ( 1u << this->m_depth ) - 1u };
+				const auto to_byte = [ & ]( std::uint32_t value ) -> std::uint8_t
+					{
+						if ( this->m_depth == 16u )
+						{
+							return static_cast< std::uint8_t >( value >> 8 );
+						}
+
+						return static_cast< std::uint8_t >( value * 255u / max_value );
+					};
+
+				for ( std::uint32_t x{ 0 }; x < width; ++x )
+				{
+					auto px{ dst + x * dst_stride };
+
+					switch ( this->m_color_type )
+					{
+					case 0:
+					{
+						const auto value{ this->sample( row, x ) };
+						const auto gray{ to_byte( value ) };
+						px[ 0 ] = gray;
+						px[ 1 ] = gray;
+						px[ 2 ] = gray;
+						px[ 3 ] = this->m_has_transparency && value == this->m_transparent_key[ 0 ] ? 0u : 255u;
+						break;
+					}
+					case 2:
+					{
+						const auto r{ this->sample( row, x * 3u + 0u ) };
+						const auto g{ this->sample( row, x * 3u + 1u ) };
+						const auto b{ this->sample( row, x * 3u + 2u ) };
+						px[ 0 ] = to_byte( r );
+						px[ 1 ] = to_byte( g );
+						px[ 2 ] = to_byte( b );
+						px[ 3 ] = this->m_has_transparency && r == this->m_transparent_key[ 0 ] && g == this->m_transparent_key[ 1 ] && b == this->m_transparent_key[ 2 ] ? 0u : 255u;
+						break;
+					}
+					case 3:
+					{
+						const auto& entry{ this->m_palette[ this->sample( row, x ) ] };
+						std::memcpy( px, entry.data( ), 4u );
+						break;
+					}
+					case 4:
+					{
+						const auto gray{ to_byte( this->sample( row, x * 2u + 0u ) ) };
+						px[ 0 ] = gray;
+						px[ 1 ] = gray;
+						px[ 2 ] = gray;
+						px[ 3 ] = to_byte( this->sample( row, x * 2u + 1u ) );
+						break;
+					}
+					default:
+					{
+						px[ 0 ] = to_byte( this->sample( row, x * 4u + 0u ) );
+						px[ 1 ] = to_byte( this->sample( row, x * 4u + 1u ) );
+						px[ 2 ] = to_byte( this->sample( row, x * 4u + 2u ) );
+						px[ 3 ] = to_byte( this->sample( row, x * 4u + 3u ) );
+						break;
+					}
+					}
+				}
+			}
+
+			[[nodiscard]] bool decode_pass( std::uint8_t* data, std::uint32_t width, std::uint32_t height, image& out, std::uint32_t start_x, std::uint32_t start_y, std::uint32_t step_x, std::uint32_t step_y ) const
+			{
+				const auto length{ this->row_bytes( width ) };
+				const std::vector<std::uint8_t> zero_row( length, 0u );
+				const std::uint8_t* prior{ zero_row.data( ) };
+
+				const auto out_stride{ static_cast< std::size_t >( out.m_width ) * 4u };
+
+				for ( std::uint32_t y{ 0 }; y < height; ++y )
+				{
+					auto row{ data + y * ( length + 1u ) };
+					if ( !this->unfilter_row( row[ 0 ], row + 1, prior, length ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					auto dst{ out.m_pixels.data( ) + ( start_y + y * step_y ) * out_stride + start_x * 4u };
+					this->convert_row( row + 1, width, dst, step_x * 4u );
+					prior = row + 1;
+				}
+
+				return true;
+			}
+
+			std::span<const std::uint8_t> m_data{};
+			std::vector<std::uint8_t> m_compressed{};
+			std::array<std::array<std::uint8_t, 4>, 256> m_palette{};
+			std::array<std::uint32_t, 3> m_transparent_key{};
+			bool m_has_transparency{ false };
+
+			std::uint32_t m_width{ 0 };
+			std::uint32_t m_height{ 0 };
+			std::uint32_t m_depth{ 0 };
+			std::uint32_t m_color_type{ 0 };
+			std::uint32_t m_interlace{ 0 };
+			std::uint32_t m_channels{ 0 };
+		};
+
+		class jpeg_decoder
+		{
+		public:
+			jpeg_decoder( std::span<const std::uint8_t> data ) : m_data{ data } {}
+
+			[[nodiscard]] bool decode( image& out )
+			{
+				if ( this->m_data.size( ) < 4u || this->m_data[ 0 ] != 0xFFu || this->m_data[ 1 ] != 0xD8u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_position = 2u;
+				bool has_scan{ false };
+
+				for ( ;; )
+				{
+					const auto marker{ this->next_marker( ) };
+					if ( marker < 0 ) [[unlikely]]
+					{
+						break;
+					}
+
+					if ( marker == 0xD9 )
+					{
+						break;
+					}
+
+					if ( marker == 0xD8 || ( marker >= 0xD0 && marker <= 0xD7 ) || marker == 0x01 )
+					{
+						continue;
+					}
+
+					if ( this->m_position + 2u > this->m_data.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto length{ read_u16_be( this->m_data.data( ) + this->m_position ) };
+					if ( length < 2u || this->m_position + length > this->m_data.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const std::span<const std::uint8_t> segment{ this->m_data.data( ) + this->m_position + 2u, static_cast< std::size_t >( length - 2u ) };
+					this->m_position += length;
+
+					switch ( marker )
+					{
+					case 0xC0:
+					case 0xC1:
+					case 0xC2:
+						if ( !this->read_frame( segment, marker == 0xC2 ) ) [[unlikely]]
+						{
+							return false;
+						}
+						break;
+					case 0xC4:
+						if ( !this->read_huffman_tables( segment ) ) [[unlikely]]
+						{
+							return false;
+						}
+						break;
+					case 0xDB:
+						if ( !this->read_quant_tables( segment ) ) [[unlikely]]
+						{
+							return false;
+						}
+						break;
+					case 0xDD:
+						if ( segment.size( ) < 2u ) [[unlikely]]
+						{
+							return false;
+						}
+
+						this->m_restart_interval = read_u16_be( segment.data( ) );
+						break;
+					case 0xEE:
+						if ( segment.size( ) >= 12u && std::memcmp( segment.data( ), "Adobe", 5u ) == 0 )
+						{
+							this->m_adobe_transform = segment[ 11 ];
+						}
+						break;
+					case 0xDA:
+						if ( !this->m_has_frame || !this->read_scan_header( segment ) || !this->decode_scan( ) ) [[unlikely]]
+						{
+							return false;
+						}
+
+						has_scan = true;
+						break;
+					default:
+						if ( ( marker >= 0xC3 && marker <= 0xCF ) ) [[unlikely]]
+						{
+							return false;
+						}
+						break;
+					}
+				}
+
+				if ( !has_scan || !allocate_image( out, this->m_width, this->m_height ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				for ( auto& component : this->m_components )
+				{
+					this->reconstruct( component );
+				}
+
+				this->convert( out );
+				return true;
+			}
+
+		private:
+			static constexpr std::uint8_t k_zigzag[ 64 + 16 ]
+			{
+				0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5, 12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+				35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+				63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+			};
+
+			struct huffman
+			{
+				std::array<std::uint8_t, 512> m_fast_length{};
+				std::array<std::uint8_t, 512> m_fast_symbol{};
+				std::array<std::uint8_t, 256> m_symbols{};
+				std::array<std::int32_t, 18> m_max_code{};
+				std::array<std::int32_t, 17> m_value_offset{};
+			};
+
+			struct component
+			{
+				std::uint8_t m_id{ 0 };
+				std::uint32_t m_h{ 1 };
+				std::uint32_t m_v{ 1 };
+				std::uint32_t m_quant_table{ 0 };
+				std::uint32_t m_dc_table{ 0 };
+				std::uint32_t m_ac_table{ 0 };
+				std::int32_t m_dc_pred{ 0 };
+
+				std::uint32_t m_width{ 0 };
+				std::uint32_t m_height{ 0 };
+				std::uint32_t m_blocks_w{ 0 };
+				std::uint32_t m_blocks_h{ 0 };
+
+				std::vector<std::int16_t> m_coefs{};
+				std::vector<std::uint8_t> m_plane{};
+			};
+
+			[[nodiscard]] int next_marker( ) noexcept
+			{
+				while ( this->m_position + 1u < this->m_data.size( ) )
+				{
+					if ( this->m_data[ this->m_position ] != 0xFFu )
+					{
+						++this->m_position;
+						continue;
+					}
+
+					const auto marker{ this->m_data[ this->m_position + 1u ] };
+					if ( marker == 0xFFu || marker == 0x00u )
+					{
+						++this->m_position;
+						continue;
+					}
+
+					this->m_position += 2u;
+					return marker;
+				}
+
+				return -1;
+			}
+
+			[[nodiscard]] bool read_frame( std::span<const std::uint8_t> segment, bool progressive )
+			{
+				if ( this->m_has_frame || segment.size( ) < 6u || segment[ 0 ] != 8u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_progressive = progressive;
+				this->m_height = read_u16_be( segment.data( ) + 1u );
+				this->m_width = read_u16_be( segment.data( ) + 3u );
+
+				const auto count{ segment[ 5 ] };
+				if ( ( count != 1u && count != 3u ) || segment.size( ) < 6u + count * 3u || this->m_width == 0u || this->m_height == 0u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_components.resize( count );
+				for ( std::uint32_t i{ 0 }; i < count; ++i )
+				{
+					auto& c{ this->m_components[ i ] };
+					c.m_id = segment[ 6u + i * 3u ];
+					c.m_h = segment[ 7u + i * 3u ] >> 4;
+					c.m_v = segment[ 7u + i * 3u ] & 15u;
+					c.m_quant_table = segment[ 8u + i * 3u ];
+
+					if ( c.m_h < 1u || c.m_h > 4u || c.m_v < 1u || c.m_v > 4u || c.m_quant_table > 3u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					this->m_max_h = std::max( this->m_max_h, c.m_h );
+					this->m_max_v = std::max( this->m_max_v, c.m_v );
+				}
+
+				this->m_mcus_x = ( this->m_width + this->m_max_h * 8u - 1u ) / ( this->m_max_h * 8u );
+				this->m_mcus_y = ( this->m_height + this->m_max_v * 8u - 1u ) / ( this->m_max_v * 8u );
+
+				for ( auto& c : this->m_components )
+				{
+					c.m_width = ( this->m_width * c.m_h + this->m_max_h - 1u ) / this->m_max_h;
+					c.m_height = ( this->m_height * c.m_v + this->m_max_v - 1u ) / this->m_max_v;
+					c.m_blocks_w = this->m_mcus_x * c.m_h;
+					c.m_blocks_h = this->m_mcus_y * c.m_v;
+					c.m_coefs.assign( static_cast< std::size_t >( c.m_blocks_w ) * c.m_blocks_h * 64u, 0 );
+				}
+
+				this->m_has_frame = true;
+				return true;
+			}
+
+			[[nodiscard]] bool read_huffman_tables( std::span<const std::uint8_t> segment )
+			{
+				std::size_t position{ 0 };
+
+				while ( position + 17u <= segment.size( ) )
+				{
+					const auto table_class{ static_cast< std::uint32_t >( segment[ position ] >> 4 ) };
+					const auto table_index{ segment[ position ] & 15u };
+					if ( table_class > 1u || table_index > 3u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					std::array<std::uint8_t, 16> counts{};
+					std::uint32_t total{ 0 };
+					for ( std::size_t i{ 0 }; i < 16u; ++i )
+					{
+						counts[ i ] = segment[ position + 1u + i ];
+						total += counts[ i ];
+					}
+
+					position += 17u;
+					if ( total > 256u || position + total > segment.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					auto& table{ table_class == 0u ? this->m_dc_tables[ table_index ] : this->m_ac_tables[ table_index ] };
+					table = huffman{};
+					std::memcpy( table.m_symbols.data( ), segment.data( ) + position, total );
+					position += total;
+
+					std::int32_t code{ 0 };
+					std::int32_t symbol{ 0 };
+
+					for ( int length{ 1 }; length <= 16; ++length )
+					{
+						table.m_value_offset[ length ] = symbol - code;
+
+						for ( std::uint32_t i{ 0 }; i < counts[ length - 1 ]; ++i, ++code, ++symbol )
+						{
+							if ( code >= ( 1 << length ) ) [[unlikely]]
+							{
+								return false;
+							}
+
+							if ( length <= 9 )
+							{
+								const auto shift{ 9 - length };
+								for ( int fill{ 0 }; fill < ( 1 << shift ); ++fill )
+								{
+									const auto slot{ static_cast< std::size_t >( ( code << shift ) | fill ) };
+									if ( slot >= table.m_fast_length.size( ) ) [[unlikely]]
+									{
+										return false;
+									}
+
+									table.m_fast_length[ slot ] = static_cast< std::uint8_t >( length );
+									table.m_fast_symbol[ slot ] = table.m_symbols[ symbol ];
+								}
+							}
+						}
+
+						table.m_max_code[ length ] = counts[ length - 1 ] != 0u ? code - 1 : -1;
+						code <<= 1;
+					}
+
+					table.m_max_code[ 17 ] = 0x7FFFFFFF;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] bool read_quant_tables( std::span<const std::uint8_t> segment )
+			{
+				std::size_t position{ 0 };
+
+				while ( position < segment.size( ) )
+				{
+					const auto precision{ static_cast< std::uint32_t >( segment[ position ] >> 4 ) };
+					const auto index{ segment[ position ] & 15u };
+					const auto size{ precision == 0u ? 64u : 128u };
+
+					if ( index > 3u || precision > 1u || position + 1u + size > segment.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					for ( std::size_t i{ 0 }; i < 64u; ++i )
+					{
+						const auto value{ precision == 0u ? segment[ position + 1u + i ] : read_u16_be( segment.data( ) + position + 1u + i * 2u ) };
+						this->m_quant[ index ][ k_zigzag[ i ] ] = value;
+					}
+
+					position += 1u + size;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] bool read_scan_header( std::span<const std::uint8_t> segment )
+			{
+				if ( segment.empty( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				const auto count{ segment[ 0 ] };
+				if ( count < 1u || count > this->m_components.size( ) || segment.size( ) < 4u + count * 2u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_scan_count = count;
+				for ( std::uint32_t i{ 0 }; i < count; ++i )
+				{
+					const auto id{ segment[ 1u + i * 2u ] };
+					const auto tables{ segment[ 2u + i * 2u ] };
+
+					auto it{ std::find_if( this->m_components.begin( ), this->m_components.end( ), [ id ]( const component& c ) { return c.m_id == id; } ) };
+					if ( it == this->m_components.end( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					it->m_dc_table = tables >> 4;
+					it->m_ac_table = tables & 15u;
+
+					if ( it->m_dc_table > 3u || it->m_ac_table > 3u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					this->m_scan_components[ i ] = static_cast< std::uint32_t >( it - this->m_components.begin( ) );
+				}
+
+				const auto tail{ segment.data( ) + 1u + count * 2u };
+				this->m_spectral_start = tail[ 0 ];
+				this->m_spectral_end = tail[ 1 ];
+				this->m_approx_high = tail[ 2 ] >> 4;
+				this->m_approx_low = tail[ 2 ] & 15u;
+
+				if ( this->m_progressive )
+				{
+					if ( this->m_spectral_start > 63u || this->m_spectral_end > 63u || this->m_spectral_start > this->m_spectral_end || this->m_approx_low > 13u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					if ( this->m_spectral_start == 0u && this->m_spectral_end != 0u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					if ( this->m_spectral_start != 0u && count != 1u ) [[unlikely]]
+					{
+						return false;
+					}
+				}
+				else
+				{
+					this->m_spectral_start = 0u;
+					this->m_spectral_end = 63u;
+				}
+
+				return true;
+			}
+
+			void reset_bits( ) noexcept
+			{
+				this->m_bits = 0u;
+				this->m_bit_count = 0;
+				this->m_hit_marker = false;
+				this->m_eob_run = 0u;
+
+				for ( auto& c : this->m_components )
+				{
+					c.m_dc_pred = 0;
+				}
+			}
+
+			void fill_bits( ) noexcept
+			{
+				while ( this->m_bit_count <= 24 )
+				{
+					std::uint32_t byte{ 0 };
+
+					if ( !this->m_hit_marker && this->m_position < this->m_data.size( ) )
+					{
+						byte = this->m_data[ this->m_position ];
+
+						if ( byte == 0xFFu )
+						{
+							const auto next{ this->m_position + 1u < this->m_data.size( ) ? this->m_data[ this->m_position + 1u ] : 0xD9u };
+							if ( next == 0x00u )
+							{
+								this->m_position += 2u;
+							}
+							else
+							{
+								this->m_hit_marker = true;
+								byte = 0u;
+							}
+						}
+						else
+						{
+							++this->m_position;
+						}
+					}
+
+					this->m_bits |= byte << ( 24 - this->m_bit_count );
+					this->m_bit_count += 8;
+				}
+			}
+
+			[[nodiscard]] std::uint32_t read_bits( int count ) noexcept
+			{
+				if ( count == 0 )
+				{
+					return 0u;
+				}
+
+				if ( this->m_bit_count < count )
+				{
+					this->fill_bits( );
+				}
+
+				const auto value{ this->m_bits >> ( 32 - count ) };
+				this->m_bits <<= count;
+				this->m_bit_count -= count;
+				return value;
+			}
+
+			[[nodiscard]] std::int32_t read_extended( int count ) noexcept
+			{
+				if ( count == 0 )
+				{
+					return 0;
+				}
+
+				const auto value{ static_cast< std::int32_t >( this->read_bits( count ) ) };
+				return value < ( 1 << ( count - 1 ) ) ? value - ( 1 << count ) + 1 : value;
+			}
+
+			[[nodiscard]] int decode_symbol( const huffman& table ) noexcept
+			{
+				if ( this->m_bit_count < 16 )
+				{
+					this->fill_bits( );
+				}
+
+				const auto fast_index{ this->m_bits >> 23 };
+				const auto fast_length{ table.m_fast_length[ fast_index ] };
+
+				if ( fast_length != 0u )
+				{
+					this->m_bits <<= fast_length;
+					this->m_bit_count -= fast_length;
+					return table.m_fast_symbol[ fast_index ];
+				}
+
+				for ( int length{ 10 }; length <= 16; ++length )
+				{
+					const auto code{ static_cast< std::int32_t >( this->m_bits >> ( 32 - length ) ) };
+					if ( code <= table.m_max_code[ length ] )
+					{
+						this->m_bits <<= length;
+						this->m_bit_count -= length;
+						return table.m_symbols[ static_cast< std::uint8_t >( code + table.m_value_offset[ length ] ) ];
+					}
+				}
+
+				return -1;
+			}
+
+			[[nodiscard]] bool decode_block_baseline( component& c, std::int16_t* block ) noexcept
+			{
+				const auto dc_size{ this->decode_symbol( this->m_dc_tables[ c.m_dc_table ] ) };
+				if ( dc_size < 0 || dc_size > 11 ) [[unlikely]]
+				{
+					return false;
+				}
+
+				c.m_dc_pred += this->read_extended( dc_size );
+				block[ 0 ] = static_cast< std::int16_t >( c.m_dc_pred );
+
+				const auto& ac_table{ this->m_ac_tables[ c.m_ac_table ] };
+				for ( std::uint32_t k{ 1 }; k < 64u; )
+				{
+					const auto rs{ this->decode_symbol( ac_table ) };
+					if ( rs < 0 ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto run{ static_cast< std::uint32_t >( rs >> 4 ) };
+					const auto size{ rs & 15 };
+
+					if ( size == 0 )
+					{
+						if ( run != 15u )
+						{
+							break;
+						}
+
+						k += 16u;
+						continue;
+					}
+
+					k += run;
+					if ( k > 63u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					block[ k_zigzag[ k ] ] = static_cast< std::int16_t >( this->read_extended( size ) );
+					++k;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] bool decode_block_dc( component& c, std::int16_t* block ) noexcept
+			{
+				if ( this->m_approx_high == 0u )
+				{
+					const auto dc_size{ this->decode_symbol( this->m_dc_tables[ c.m_dc_table ] ) };
+					if ( dc_size < 0 || dc_size > 11 ) [[unlikely]]
+					{
+						return false;
+					}
+
+					c.m_dc_pred += this->read_extended( dc_size );
+					block[ 0 ] = static_cast< std::int16_t >( c.m_dc_pred * ( 1 << this->m_approx_low ) );
+				}
+				else if ( this->read_bits( 1 ) != 0u )
+				{
+					block[ 0 ] = static_cast< std::int16_t >( block[ 0 ] | ( 1 << this->m_approx_low ) );
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] bool decode_block_ac_first( component& c, std::int16_t* block ) noexcept
+			{
+				if ( this->m_eob_run > 0u )
+				{
+					--this->m_eob_run;
+					return true;
+				}
+
+				const auto& ac_table{ this->m_ac_tables[ c.m_ac_table ] };
+				for ( auto k{ this->m_spectral_start }; k <= this->m_spectral_end; )
+				{
+					const auto rs{ this->decode_symbol( ac_table ) };
+					if ( rs < 0 ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto run{ static_cast< std::uint32_t >( rs >> 4 ) };
+					const auto size{ rs & 15 };
+
+					if ( size == 0 )
+					{
+						if ( run < 15u )
+						{
+							this->m_eob_run = ( 1u << run ) - 1u;
+							if ( run != 0u )
+							{
+								this->m_eob_run += this->read_bits( static_cast< int >( run ) );
+							}
+
+							break;
+						}
+
+						k += 16u;
+						continue;
+					}
+
+					k += run;
+					if ( k > 63u ) [[unlikely]]
+					{
+						return false;
+					}
+
+					block[ k_zigzag[ k ] ] = static_cast< std::int16_t >( this->read_extended( size ) * ( 1 << this->m_approx_low ) );
+					++k;
+				}
+
+				return true;
+			}
+
+			void refine_coefficient( std::int16_t& coef, std::int32_t bit ) noexcept
+			{
+				if ( this->read_bits( 1 ) != 0u && ( coef & bit ) == 0 )
+				{
+					coef = static_cast< std::int16_t >( coef >= 0 ? coef + bit : coef - bit );
+				}
+			}
+
+			[[nodiscard]] bool decode_block_ac_refine( component& c, std::int16_t* block ) noexcept
+			{
+				const auto bit{ 1 << this->m_approx_low };
+				auto k{ this->m_spectral_start };
+
+				if ( this->m_eob_run == 0u )
+				{
+					const auto& ac_table{ this->m_ac_tables[ c.m_ac_table ] };
+
+					for ( ; k <= this->m_spectral_end; ++k )
+					{
+						const auto rs{ this->decode_symbol( ac_table ) };
+						if ( rs < 0 ) [[unlikely]]
+						{
+							return false;
+						}
+
+						auto run{ rs >> 4 };
+						auto size{ rs & 15 };
+						std::int32_t value{ 0 };
+
+						if ( size != 0 )
+						{
+							value = this->read_bits( 1 ) != 0u ? bit : -bit;
+						}
+						else if ( run != 15 )
+						{
+							this->m_eob_run = 1u << run;
+							if ( run != 0 )
+							{
+								this->m_eob_run += this->read_bits( run );
+							}
+
+							break;
+						}
+
+						for ( ; k <= this->m_spectral_end; ++k )
+						{
+							auto& coef{ block[ k_zigzag[ k ] ] };
+
+							if ( coef != 0 )
+							{
+								this->refine_coefficient( coef, bit );
+							}
+							else if ( run-- == 0 )
+							{
+								break;
+							}
+						}
+
+						if ( value != 0 && k <= 63u )
+						{
+							block[ k_zigzag[ k ] ] = static_cast< std::int16_t >( value );
+						}
+					}
+				}
+
+				if ( this->m_eob_run > 0u )
+				{
+					for ( ; k <= this->m_spectral_end; ++k )
+					{
+						auto& coef{ block[ k_zigzag[ k ] ] };
+						if ( coef != 0 )
+						{
+							this->refine_coefficient( coef, bit );
+						}
+					}
+
+					--this->m_eob_run;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] bool decode_block( component& c, std::uint32_t block_x, std::uint32_t block_y ) noexcept
+			{
+				auto block{ c.m_coefs.data( ) + ( static_cast< std::size_t >( block_y ) * c.m_blocks_w + block_x ) * 64u };
+
+				if ( !this->m_progressive )
+				{
+					return this->decode_block_baseline( c, block );
+				}
+
+				if ( this->m_spectral_start == 0u )
+				{
+					return this->decode_block_dc( c, block );
+				}
+
+				return this->m_approx_high == 0u ? this->decode_block_ac_first( c, block ) : this->decode_block_ac_refine( c, block );
+			}
+
+			[[nodiscard]] bool handle_restart( std::uint32_t& remaining, bool last ) noexcept
+			{
+				if ( this->m_restart_interval == 0u || --remaining != 0u || last )
+				{
+					return true;
+				}
+
+				while ( this->m_position + 1u < this->m_data.size( ) && !( this->m_data[ this->m_position ] == 0xFFu && this->m_data[ this->m_position + 1u ] != 0x00u && this->m_data[ this->m_position + 1u ] != 0xFFu ) )
+				{
+					++this->m_position;
+				}
+
+				if ( this->m_position + 1u >= this->m_data.size( ) || this->m_data[ this->m_position + 1u ] < 0xD0u || this->m_data[ this->m_position + 1u ] > 0xD7u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				this->m_position += 2u;
+				this->reset_bits( );
+				remaining = this->m_restart_interval;
+				return true;
+			}
+
+			[[nodiscard]] bool decode_scan( )
+			{
+				this->reset_bits( );
+				auto remaining{ this->m_restart_interval };
+
+				if ( this->m_scan_count == 1u )
+				{
+					auto& c{ this->m_components[ this->m_scan_components[ 0 ] ] };
+					const auto blocks_w{ ( c.m_width + 7u ) / 8u };
+					const auto blocks_h{ ( c.m_height + 7u ) / 8u };
+
+					for ( std::uint32_t y{ 0 }; y < blocks_h; ++y )
+					{
+						for ( std::uint32_t x{ 0 }; x < blocks_w; ++x )
+						{
+							if ( !this->decode_block( c, x, y ) || !this->handle_restart( remaining, x + 1u == blocks_w && y + 1u == blocks_h ) ) [[unlikely]]
+							{
+								return false;
+							}
+						}
+					}
+				}
+				else
+				{
+					for ( std::uint32_t mcu_y{ 0 }; mcu_y < this->m_mcus_y; ++mcu_y )
+					{
+						for ( std::uint32_t mcu_x{ 0 }; mcu_x < this->m_mcus_x; ++mcu_x )
+						{
+							for ( std::uint32_t i{ 0 }; i < this->m_scan_count; ++i )
+							{
+								auto& c{ this->m_components[ this->m_scan_components[ i ] ] };
+
+								for ( std::uint32_t by{ 0 }; by < c.m_v; ++by )
+								{
+									for ( std::uint32_t bx{ 0 }; bx < c.m_h; ++bx )
+									{
+										if ( !this->decode_block( c, mcu_x * c.m_h + bx, mcu_y * c.m_v + by ) ) [[unlikely]]
+										{
+											return false;
+										}
+									}
+								}
+							}
+
+							if ( !this->handle_restart( remaining, mcu_x + 1u == this->m_mcus_x && mcu_y + 1u == this->m_mcus_y ) ) [[unlikely]]
+							{
+								return false;
+							}
+						}
+					}
+				}
+
+				while ( this->m_position + 1u < this->m_data.size( ) && !( this->m_data[ this->m_position ] == 0xFFu && this->m_data[ this->m_position + 1u ] != 0x00u && ( this->m_data[ this->m_position + 1u ] < 0xD0u || this->m_data[ this->m_position + 1u ] > 0xD7u ) ) )
+				{
+					++this->m_position;
+				}
+
+				return true;
+			}
+
+			static void idct_block( const std::int16_t* in, const float* quant, std::uint8_t* out, std::size_t stride ) noexcept
+			{
+				float workspace[ 64 ];
+
+				for ( int col{ 0 }; col < 8; ++col )
+				{
+					const auto* c{ in + col };
+					const auto* q{ quant + col };
+					auto* w{ workspace + col };
+
+					if ( c[ 8 ] == 0 && c[ 16 ] == 0 && c[ 24 ] == 0 && c[ 32 ] == 0 && c[ 40 ] == 0 && c[ 48 ] == 0 && c[ 56 ] == 0 )
+					{
+						const auto dc{ c[ 0 ] * q[ 0 ] };
+						for ( int row{ 0 }; row < 8; ++row )
+						{
+							w[ row * 8 ] = dc;
+						}
+
+						continue;
+					}
+
+					auto tmp0{ c[ 0 ] * q[ 0 ] };
+					auto tmp1{ c[ 16 ] * q[ 16 ] };
+					auto tmp2{ c[ 32 ] * q[ 32 ] };
+					auto tmp3{ c[ 48 ] * q[ 48 ] };
+
+					auto tmp10{ tmp0 + tmp2 };
+					auto tmp11{ tmp0 - tmp2 };
+					auto tmp13{ tmp1 + tmp3 };
+					auto tmp12{ ( tmp1 - tmp3 ) * 1.414213562f - tmp13 };
+
+					tmp0 = tmp10 + tmp13;
+					tmp3 = tmp10 - tmp13;
+					tmp1 = tmp11 + tmp12;
+					tmp2 = tmp11 - tmp12;
+
+					auto tmp4{ c[ 8 ] * q[ 8 ] };
+					auto tmp5{ c[ 24 ] * q[ 24 ] };
+					auto tmp6{ c[ 40 ] * q[ 40 ] };
+					auto tmp7{ c[ 56 ] * q[ 56 ] };
+
+					const auto z13{ tmp6 + tmp5 };
+					const auto z10{ tmp6 - tmp5 };
+					const auto z11{ tmp4 + tmp7 };
+					const auto z12{ tmp4 - tmp7 };
+
+					tmp7 = z11 + z13;
+					tmp11 = ( z11 - z13 ) * 1.414213562f;
+
+					const auto z5{ ( z10 + z12 ) * 1.847759065f };
+					tmp10 = 1.082392200f * z12 - z5;
+					tmp12 = -2.613125930f * z10 + z5;
+
+					tmp6 = tmp12 - tmp7;
+					tmp5 = tmp11 - tmp6;
+					tmp4 = tmp10 + tmp5;
+
+					w[ 0 ] = tmp0 + tmp7;
+					w[ 56 ] = tmp0 - tmp7;
+					w[ 8 ] = tmp1 + tmp6;
+					w[ 48 ] = tmp1 - tmp6;
+					w[ 16 ] = tmp2 + tmp5;
+					w[ 40 ] = tmp2 - tmp5;
+					w[ 32 ] = tmp3 + tmp4;
+					w[ 24 ] = tmp3 - tmp4;
+				}
+
+				for ( int row{ 0 }; row < 8; ++row )
+				{
+					const auto* w{ workspace + row * 8 };
+					auto* o{ out + row * stride };
+
+					auto tmp10{ w[ 0 ] + w[ 4 ] };
+					auto tmp11{ w[ 0 ] - w[ 4 ] };
+					auto tmp13{ w[ 2 ] + w[ 6 ] };
+					auto tmp12{ ( w[ 2 ] - w[ 6 ] ) * 1.414213562f - tmp13 };
+
+					const auto tmp0{ tmp10 + tmp13 };
+					const auto tmp3{ tmp10 - tmp13 };
+					const auto tmp1{ tmp11 + tmp12 };
+					const auto tmp2{ tmp11 - tmp12 };
+
+					const auto z13{ w[ 5 ] + w[ 3 ] };
+					const auto z10{ w[ 5 ] - w[ 3 ] };
+					const auto z11{ w[ 1 ] + w[ 7 ] };
+					const auto z12{ w[ 1 ] - w[ 7 ] };
+
+					const auto tmp7{ z11 + z13 };
+					tmp11 = ( z11 - z13 ) * 1.414213562f;
+
+					const auto z5{ ( z10 + z12 ) * 1.847759065f };
+					tmp10 = 1.082392200f * z12 - z5;
+					tmp12 = -2.613125930f * z10 + z5;
+
+					const auto tmp6{ tmp12 - tmp7 };
+					const auto tmp5{ tmp11 - tmp6 };
+					const auto tmp4{ tmp10 + tmp5 };
+
+					const auto store = [ ]( float value ) -> std::uint8_t
+						{
+							const auto v{ static_cast< int >( value * 0.125f + 128.5f ) };
+							return static_cast< std::uint8_t >( std::clamp( v, 0, 255 ) );
+						};
+
+					o[ 0 ] = store( tmp0 + tmp7 );
+					o[ 7 ] = store( tmp0 - tmp7 );
+					o[ 1 ] = store( tmp1 + tmp6 );
+					o[ 6 ] = store( tmp1 - tmp6 );
+					o[ 2 ] = store( tmp2 + tmp5 );
+					o[ 5 ] = store( tmp2 - tmp5 );
+					o[ 4 ] = store( tmp3 + tmp4 );
+					o[ 3 ] = store( tmp3 - tmp4 );
+				}
+			}
+
+			void reconstruct( component& c )
+			{
+				static const auto aan_scale = [ ]
+					{
+						std::array<float, 8> scale{};
+						for ( int i{ 0 }; i < 8; ++i )
+						{
+							scale[ i ] = i == 0 ? 1.0f : static_cast< float >( std::cos( i * 3.14159265358979323846 / 16.0 ) * 1.41421356237309504880 );
+						}
+
+						return scale;
+					}( );
+
+				std::array<float, 64> quant{};
+				for ( int i{ 0 }; i < 64; ++i )
+				{
+					quant[ i ] = static_cast< float >( this->m_quant[ c.m_quant_table ][ i ] ) * aan_scale[ i >> 3 ] * aan_scale[ i & 7 ];
+				}
+
+				const auto stride{ static_cast< std::size_t >( c.m_blocks_w ) * 8u };
+				c.m_plane.resize( stride * c.m_blocks_h * 8u );
+
+				for ( std::uint32_t by{ 0 }; by < c.m_blocks_h; ++by )
+				{
+					for ( std::uint32_t bx{ 0 }; bx < c.m_blocks_w; ++bx )
+					{
+						const auto block{ c.m_coefs.data( ) + ( static_cast< std::size_t >( by ) * c.m_blocks_w + bx ) * 64u };
+						idct_block( block, quant.data( ), c.m_plane.data( ) + by * 8u * stride + bx * 8u, stride );
+					}
+				}
+
+				c.m_coefs.clear( );
+				c.m_coefs.shrink_to_fit( );
+			}
+
+			struct upsampler
+			{
+				std::vector<std::uint32_t> m_x0{};
+				std::vector<std::uint32_t> m_x1{};
+				std::vector<std::int32_t> m_wx{};
+				std::vector<std::int32_t> m_scratch{};
+			};
+
+			[[nodiscard]] static std::int32_t map_sample( std::uint32_t coord, std::uint32_t factor, std::uint32_t max_factor, std::uint32_t limit, std::uint32_t& c0, std::uint32_t& c1 ) noexcept
+			{
+				const auto fixed{ ( static_cast< std::int32_t >( ( 2u * coord + 1u ) * factor ) - static_cast< std::int32_t >( max_factor ) ) * 128 / static_cast< std::int32_t >( max_factor ) };
+				if ( fixed <= 0 )
+				{
+					c0 = 0u;
+					c1 = 0u;
+					return 0;
+				}
+
+				c0 = std::min( static_cast< std::uint32_t >( fixed >> 8 ), limit - 1u );
+				c1 = std::min( c0 + 1u, limit - 1u );
+				return fixed & 255;
+			}
+
+			void prepare_upsampler( const component& c, upsampler& u ) const
+			{
+				u.m_x0.resize( this->m_width );
+				u.m_x1.resize( this->m_width );
+				u.m_wx.resize( this->m_width );
+				u.m_scratch.resize( c.m_width );
+
+				for ( std::uint32_t x{ 0 }; x < this->m_width; ++x )
+				{
+					u.m_wx[ x ] = map_sample( x, c.m_h, this->m_max_h, c.m_width, u.m_x0[ x ], u.m_x1[ x ] );
+				}
+			}
+
+			void upsample_row( const component& c, std::uint32_t y, upsampler& u, std::uint8_t* dst ) const
+			{
+				const auto stride{ static_cast< std::size_t >( c.m_blocks_w ) * 8u };
+
+				if ( c.m_h == this->m_max_h && c.m_v == this->m_max_v )
+				{
+					std::memcpy( dst, c.m_plane.data( ) + y * stride, this->m_width );
+					return;
+				}
+
+				std::uint32_t y0{ 0 };
+				std::uint32_t y1{ 0 };
+				const auto wy{ map_sample( y, c.m_v, this->m_max_v, c.m_height, y0, y1 ) };
+
+				const auto* row0{ c.m_plane.data( ) + y0 * stride };
+				const auto* row1{ c.m_plane.data( ) + y1 * stride };
+				auto* scratch{ u.m_scratch.data( ) };
+
+				for ( std::uint32_t x{ 0 }; x < c.m_width; ++x )
+				{
+					scratch[ x ] = row0[ x ] * ( 256 - wy ) + row1[ x ] * wy;
+				}
+
+				const auto* x0{ u.m_x0.data( ) };
+				const auto* x1{ u.m_x1.data( ) };
+				const auto* wx{ u.m_wx.data( ) };
+
+				for ( std::uint32_t x{ 0 }; x < this->m_width; ++x )
+				{
+					dst[ x ] = static_cast< std::uint8_t >( ( scratch[ x0[ x ] ] * ( 256 - wx[ x ] ) + scratch[ x1[ x ] ] * wx[ x ] + 32768 ) >> 16 );
+				}
+			}
+
+			void convert( image& out ) const
+			{
+				const auto width{ this->m_width };
+				std::array<upsampler, 3> upsamplers{};
+
+				for ( std::size_t i{ 0 }; i < this->m_components.size( ); ++i )
+				{
+					this->prepare_upsampler( this->m_components[ i ], upsamplers[ i ] );
+				}
+
+				if ( this->m_components.size( ) == 1u )
+				{
+					std::vector<std::uint8_t> gray( width );
+					for ( std::uint32_t y{ 0 }; y < this->m_height; ++y )
+					{
+						this->upsample_row( this->m_components[ 0 ], y, upsamplers[ 0 ], gray.data( ) );
+						gray_to_rgba( gray.data( ), out.m_pixels.data( ) + static_cast< std::size_t >( y ) * width * 4u, width );
+					}
+
+					return;
+				}
+
+				const auto& c0{ this->m_components[ 0 ] };
+				const auto& c1{ this->m_components[ 1 ] };
+				const auto& c2{ this->m_components[ 2 ] };
+
+				const auto is_rgb{ this->m_adobe_transform == 0 || ( c0.m_id == 'R' && c1.m_id == 'G' && c2.m_id == 'B' ) };
+
+				std::vector<std::uint8_t> rows( static_cast< std::size_t >( width ) * 3u );
+				auto* p0{ rows.data( ) };
+				auto* p1{ p0 + width };
+				auto* p2{ p1 + width };
+
+				for ( std::uint32_t y{ 0 }; y < this->m_height; ++y )
+				{
+					this->upsample_row( c0, y, upsamplers[ 0 ], p0 );
+					this->upsample_row( c1, y, upsamplers[ 1 ], p1 );
+					this->upsample_row( c2, y, upsamplers[ 2 ], p2 );
+
+					auto* dst{ out.m_pixels.data( ) + static_cast< std::size_t >( y ) * width * 4u };
+
+					if ( is_rgb )
+					{
+						for ( std::uint32_t x{ 0 }; x < width; ++x, dst += 4 )
+						{
+							dst[ 0 ] = p0[ x ];
+							dst[ 1 ] = p1[ x ];
+							dst[ 2 ] = p2[ x ];
+							dst[ 3 ] = 255u;
+						}
+
+						continue;
+					}
+
+					for ( std::uint32_t x{ 0 }; x < width; ++x, dst += 4 )
+					{
+						const auto luma{ static_cast< std::int32_t >( p0[ x ] ) << 16 };
+						const auto cb{ static_cast< std::int32_t >( p1[ x ] ) - 128 };
+						const auto cr{ static_cast< std::int32_t >( p2[ x ] ) - 128 };
+
+						dst[ 0 ] = static_cast< std::uint8_t >( std::clamp( ( luma + 91881 * cr + 32768 ) >> 16, 0, 255 ) );
+						dst[ 1 ] = static_cast< std::uint8_t >( std::clamp( ( luma - 22554 * cb - 46802 * cr + 32768 ) >> 16, 0, 255 ) );
+						dst[ 2 ] = static_cast< std::uint8_t >( std::clamp( ( luma + 116130 * cb + 32768 ) >> 16, 0, 255 ) );
+						dst[ 3 ] = 255u;
+					}
+				}
+			}
+
+			std::span<const std::uint8_t> m_data{};
+			std::size_t m_position{ 0 };
+
+			std::array<huffman, 4> m_dc_tables{};
+			std::array<huffman, 4> m_ac_tables{};
+			std::array<std::array<std::uint16_t, 64>, 4> m_quant{};
+			std::vector<component> m_components{};
+
+			bool m_has_frame{ false };
+			bool m_progressive{ false };
+			int m_adobe_transform{ -1 };
+			std::uint32_t m_width{ 0 };
+			std::uint32_t m_height{ 0 };
+			std::uint32_t m_max_h{ 1 };
+			std::uint32_t m_max_v{ 1 };
+			std::uint32_t m_mcus_x{ 0 };
+			std::uint32_t m_mcus_y{ 0 };
+			std::uint32_t m_restart_interval{ 0 };
+
+			std::uint32_t m_scan_count{ 0 };
+			std::array<std::uint32_t, 4> m_scan_components{};
+			std::uint32_t m_spectral_start{ 0 };
+			std::uint32_t m_spectral_end{ 63 };
+			std::uint32_t m_approx_high{ 0 };
+			std::uint32_t m_approx_low{ 0 };
+			std::uint32_t m_eob_run{ 0 };
+
+			std::uint32_t m_bits{ 0 };
+			int m_bit_count{ 0 };
+			bool m_hit_marker{ false };
+		};
+
+		static void force_opaque_if_alpha_empty( image& out ) noexcept
+		{
+			const auto pixel_count{ out.m_pixels.size( ) / 4u };
+			for ( std::size_t i{ 0 }; i < pixel_count; ++i )
+			{
+				if ( out.m_pixels[ i * 4u + 3u ] != 0u )
+				{
+					return;
+				}
+			}
+
+			for ( std::size_t i{ 0 }; i < pixel_count; ++i )
+			{
+				out.m_pixels[ i * 4u + 3u ] = 255u;
+			}
+		}
+
+		struct channel_mask
+		{
+			std::uint32_t m_mask{ 0 };
+			std::uint32_t m_shift{ 0 };
+			std::uint32_t m_max{ 0 };
+
+			channel_mask( ) = default;
+			explicit channel_mask( std::uint32_t mask ) noexcept : m_mask{ mask }
+			{
+				if ( mask == 0u )
+				{
+					return;
+				}
+
+				while ( ( mask & 1u ) == 0u )
+				{
+					mask >>= 1;
+					++this->m_shift;
+				}
+
+				this->m_max = mask;
+			}
+
+			[[nodiscard]] std::uint8_t extract( std::uint32_t value, std::uint8_t fallback ) const noexcept
+			{
+				if ( this->m_max == 0u )
+				{
+					return fallback;
+				}
+
+				const auto raw{ ( value & this->m_mask ) >> this->m_shift };
+				return static_cast< std::uint8_t >( ( static_cast< std::uint64_t >( raw ) * 255u + this->m_max / 2u ) / this->m_max );
+			}
+		};
+
+		[[nodiscard]] static bool decode_bmp( std::span<const std::uint8_t> data, image& out )
+		{
+			if ( data.size( ) < 26u || data[ 0 ] != 'B' || data[ 1 ] != 'M' ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto pixel_offset{ read_u32_le( data.data( ) + 10u ) };
+			const auto header_size{ read_u32_le( data.data( ) + 14u ) };
+
+			std::int32_t width{ 0 };
+			std::int32_t height{ 0 };
+			std::uint32_t bpp{ 0 };
+			std::uint32_t compression{ 0 };
+			std::uint32_t palette_count{ 0 };
+			std::uint32_t palette_entry_size{ 4 };
+
+			if ( header_size == 12u )
+			{
+				width = read_u16_le( data.data( ) + 18u );
+				height = static_cast< std::int16_t >( read_u16_le( data.data( ) + 20u ) );
+				bpp = read_u16_le( data.data( ) + 24u );
+				palette_entry_size = 3u;
+			}
+			else if ( header_size >= 40u && data.size( ) >= 14u + header_size )
+			{
+				width = static_cast< std::int32_t >( read_u32_le( data.data( ) + 18u ) );
+				height = static_cast< std::int32_t >( read_u32_le( data.data( ) + 22u ) );
+				bpp = read_u16_le( data.data( ) + 28u );
+				compression = read_u32_le( data.data( ) + 30u );
+				palette_count = read_u32_le( data.data( ) + 46u );
+			}
+			else [[unlikely]]
+			{
+				return false;
+			}
+
+			if ( ( compression != 0u && compression != 3u && compression != 6u ) || width <= 0 || height == 0 || height == INT32_MIN ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto top_down{ height < 0 };
+			const auto abs_height{ static_cast< std::uint32_t >( top_down ? -height : height ) };
+
+			if ( !allocate_image( out, static_cast< std::uint32_t >( width ), abs_height ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto stride{ ( ( static_cast< std::size_t >( width ) * bpp + 31u ) / 32u ) * 4u };
+			if ( pixel_offset > data.size( ) || stride * abs_height > data.size( ) - pixel_offset ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto row_at = [ & ]( std::uint32_t y ) -> const std::uint8_t*
+				{
+					const auto source_row{ top_down ? y : abs_height - 1u - y };
+					return data.data( ) + pixel_offset + source_row * stride;
+				};
+
+			const auto pixels{ static_cast< std::size_t >( width ) };
+
+			if ( bpp <= 8u )
+			{
+				if ( bpp != 1u && bpp != 4u && bpp != 8u ) [[unlikely]]
+				{
+					return false;
+				}
+
+				const auto max_entries{ 1u << bpp };
+				if ( palette_count == 0u || palette_count > max_entries )
+				{
+					palette_count = max_entries;
+				}
+
+				const auto palette_offset{ 14u + static_cast< std::size_t >( header_size ) };
+				if ( palette_offset + palette_count * palette_entry_size > data.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				std::array<std::array<std::uint8_t, 4>, 256> palette{};
+				for ( std::uint32_t i{ 0 }; i < palette_count; ++i )
+				{
+					const auto entry{ data.data( ) + palette_offset + i * palette_entry_size };
+					palette[ i ] = { entry[ 2 ], entry[ 1 ], entry[ 0 ], 255u };
+				}
+
+				const auto mask{ static_cast< std::uint32_t >( ( 1u << bpp ) - 1u ) };
+				for ( std::uint32_t y{ 0 }; y < abs_height; ++y )
+				{
+					const auto row{ row_at( y ) };
+					auto dst{ out.m_pixels.data( ) + y * pixels * 4u };
+
+					for ( std::size_t x{ 0 }; x < pixels; ++x, dst += 4 )
+					{
+						const auto bit{ x * bpp };
+						const auto index{ ( row[ bit >> 3 ] >> ( 8u - bpp - ( bit & 7u ) ) ) & mask };
+						std::memcpy( dst, palette[ index ].data( ), 4u );
+					}
+				}
+
+				return true;
+			}
+
+			if ( bpp == 24u )
+			{
+				for ( std::uint32_t y{ 0 }; y < abs_height; ++y )
+				{
+					bgr_to_rgba( row_at( y ), out.m_pixels.data( ) + y * pixels * 4u, pixels );
+				}
+
+				return true;
+			}
+
+			if ( bpp != 16u && bpp != 32u ) [[unlikely]]
+			{
+				return false;
+			}
+
+			std::uint32_t masks[ 4 ]{ };
+			if ( compression == 3u || compression == 6u )
+			{
+				const auto mask_offset{ 14u + ( header_size >= 52u ? 40u : header_size ) };
+				const auto mask_count{ header_size >= 56u || compression == 6u ? 4u : 3u };
+				if ( mask_offset + mask_count * 4u > data.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				for ( std::uint32_t i{ 0 }; i < mask_count; ++i )
+				{
+					masks[ i ] = read_u32_le( data.data( ) + mask_offset + i * 4u );
+				}
+			}
+			else if ( bpp == 16u )
+			{
+				masks[ 0 ] = 0x7C00u;
+				masks[ 1 ] = 0x03E0u;
+				masks[ 2 ] = 0x001Fu;
+			}
+			else
+			{
+				masks[ 0 ] = 0x00FF0000u;
+				masks[ 1 ] = 0x0000FF00u;
+				masks[ 2 ] = 0x000000FFu;
+				masks[ 3 ] = 0xFF000000u;
+			}
+
+			if ( bpp == 32u && masks[ 0 ] == 0x00FF0000u && masks[ 1 ] == 0x0000FF00u && masks[ 2 ] == 0x000000FFu && ( masks[ 3 ] == 0xFF000000u || masks[ 3 ] == 0u ) )
+			{
+				for ( std::uint32_t y{ 0 }; y < abs_height; ++y )
+				{
+					bgra_to_rgba( row_at( y ), out.m_pixels.data( ) + y * pixels * 4u, pixels );
+				}
+
+				if ( masks[ 3 ] == 0u )
+				{
+					for ( std::size_t i{ 0 }; i < pixels * abs_height; ++i )
+					{
+						out.m_pixels[ i * 4u + 3u ] = 255u;
+					}
+				}
+				else
+				{
+					force_opaque_if_alpha_empty( out );
+				}
+
+				return true;
+			}
+
+			const channel_mask channels[ 4 ]{ channel_mask{ masks[ 0 ] }, channel_mask{ masks[ 1 ] }, channel_mask{ masks[ 2 ] }, channel_mask{ masks[ 3 ] } };
+			const auto bytes_per_pixel{ bpp / 8u };
+
+			for ( std::uint32_t y{ 0 }; y < abs_height; ++y )
+			{
+				const auto row{ row_at( y ) };
+				auto dst{ out.m_pixels.data( ) + y * pixels * 4u };
+
+				for ( std::size_t x{ 0 }; x < pixels; ++x, dst += 4 )
+				{
+					const auto value{ bytes_per_pixel == 2u ? read_u16_le( row + x * 2u ) : read_u32_le( row + x * 4u ) };
+					dst[ 0 ] = channels[ 0 ].extract( value, 0u );
+					dst[ 1 ] = channels[ 1 ].extract( value, 0u );
+					dst[ 2 ] = channels[ 2 ].extract( value, 0u );
+					dst[ 3 ] = channels[ 3 ].extract( value, 255u );
+				}
+			}
+
+			if ( masks[ 3 ] != 0u )
+			{
+				force_opaque_if_alpha_empty( out );
+			}
+
+			return true;
+		}
+
+		[[nodiscard]] static bool is_tga( std::span<const std::uint8_t> data ) noexcept
+		{
+			if ( data.size( ) < 18u )
+			{
+				return false;
+			}
+
+			const auto color_map_type{ data[ 1 ] };
+			const auto image_type{ data[ 2 ] };
+			const auto bpp{ data[ 16 ] };
+
+			if ( color_map_type > 1u || read_u16_le( data.data( ) + 12u ) == 0u || read_u16_le( data.data( ) + 14u ) == 0u )
+			{
+				return false;
+			}
+
+			switch ( image_type )
+			{
+			case 1:
+			case 9:
+			{
+				const auto map_depth{ data[ 7 ] };
+				return color_map_type == 1u && ( bpp == 8u || bpp == 16u ) && ( map_depth == 15u || map_depth == 16u || map_depth == 24u || map_depth == 32u );
+			}
+			case 2:
+			case 10:
+				return bpp == 15u || bpp == 16u || bpp == 24u || bpp == 32u;
+			case 3:
+			case 11:
+				return bpp == 8u || bpp == 16u;
+			default:
+				return false;
+			}
+		}
+
+		static void tga_to_rgba( const std::uint8_t* src, std::uint32_t bpp, bool gray, std::uint8_t* dst ) noexcept
+		{
+			if ( gray )
+			{
+				dst[ 0 ] = src[ 0 ];
+				dst[ 1 ] = src[ 0 ];
+				dst[ 2 ] = src[ 0 ];
+				dst[ 3 ] = bpp == 16u ? src[ 1 ] : 255u;
+				return;
+			}
+
+			switch ( bpp )
+			{
+			case 15:
+			case 16:
+			{
+				const auto value{ read_u16_le( src ) };
+				const auto expand = [ ]( std::uint32_t v ) { return static_cast< std::uint8_t >( ( v << 3 ) | ( v >> 2 ) ); };
+				dst[ 0 ] = expand( ( value >> 10 ) & 31u );
+				dst[ 1 ] = expand( ( value >> 5 ) & 31u );
+				dst[ 2 ] = expand( value & 31u );
+				dst[ 3 ] = 255u;
+				break;
+			}
+			case 24:
+				dst[ 0 ] = src[ 2 ];
+				dst[ 1 ] = src[ 1 ];
+				dst[ 2 ] = src[ 0 ];
+				dst[ 3 ] = 255u;
+				break;
+			default:
+				dst[ 0 ] = src[ 2 ];
+				dst[ 1 ] = src[ 1 ];
+				dst[ 2 ] = src[ 0 ];
+				dst[ 3 ] = src[ 3 ];
+				break;
+			}
+		}
+
+		[[nodiscard]] static bool decode_tga( std::span<const std::uint8_t> data, image& out )
+		{
+			if ( !is_tga( data ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto image_type{ data[ 2 ] };
+			const auto map_first{ read_u16_le( data.data( ) + 3u ) };
+			const auto map_length{ read_u16_le( data.data( ) + 5u ) };
+			const auto map_depth{ static_cast< std::uint32_t >( data[ 7 ] ) };
+			const auto width{ static_cast< std::uint32_t >( read_u16_le( data.data( ) + 12u ) ) };
+			const auto height{ static_cast< std::uint32_t >( read_u16_le( data.data( ) + 14u ) ) };
+			const auto bpp{ static_cast< std::uint32_t >( data[ 16 ] ) };
+			const auto descriptor{ data[ 17 ] };
+
+			const auto rle{ image_type >= 9u };
+			const auto mapped{ ( image_type & 7u ) == 1u };
+			const auto gray{ ( image_type & 7u ) == 3u };
+			const auto bytes_per_pixel{ ( bpp + 7u ) / 8u };
+
+			std::size_t position{ 18u + data[ 0 ] };
+			std::vector<std::array<std::uint8_t, 4>> palette{};
+
+			if ( data[ 1 ] == 1u )
+			{
+				const auto entry_size{ ( map_depth + 7u ) / 8u };
+				if ( position + static_cast< std::size_t >( map_length ) * entry_size > data.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				if ( mapped )
+				{
+					palette.resize( static_cast< std::size_t >( map_first ) + map_length );
+					for ( std::uint32_t i{ 0 }; i < map_length; ++i )
+					{
+						tga_to_rgba( data.data( ) + position + i * entry_size, map_depth, false, palette[ map_first + i ].data( ) );
+					}
+				}
+
+				position += static_cast< std::size_t >( map_length ) * entry_size;
+			}
+
+			if ( !allocate_image( out, width, height ) ) [[unlikely]]
+			{
+				return false;
+			}
+
+			const auto pixel_count{ static_cast< std::size_t >( width ) * height };
+			std::vector<std::uint8_t> linear( pixel_count * 4u );
+
+			const auto emit = [ & ]( const std::uint8_t* src, std::uint8_t* dst ) -> bool
+				{
+					if ( !mapped )
+					{
+						tga_to_rgba( src, bpp, gray, dst );
+						return true;
+					}
+
+					const auto index{ static_cast< std::size_t >( bytes_per_pixel == 2u ? read_u16_le( src ) : src[ 0 ] ) };
+					if ( index >= palette.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					std::memcpy( dst, palette[ index ].data( ), 4u );
+					return true;
+				};
+
+			if ( !rle )
+			{
+				if ( position + pixel_count * bytes_per_pixel > data.size( ) ) [[unlikely]]
+				{
+					return false;
+				}
+
+				if ( !mapped && !gray && bpp == 32u )
+				{
+					bgra_to_rgba( data.data( ) + position, linear.data( ), pixel_count );
+				}
+				else if ( !mapped && !gray && bpp == 24u )
+				{
+					bgr_to_rgba( data.data( ) + position, linear.data( ), pixel_count );
+				}
+				else
+				{
+					for ( std::size_t i{ 0 }; i < pixel_count; ++i )
+					{
+						if ( !emit( data.data( ) + position + i * bytes_per_pixel, linear.data( ) + i * 4u ) ) [[unlikely]]
+						{
+							return false;
+						}
+					}
+				}
+			}
+			else
+			{
+				std::size_t written{ 0 };
+				while ( written < pixel_count )
+				{
+					if ( position >= data.size( ) ) [[unlikely]]
+					{
+						return false;
+					}
+
+					const auto packet{ data[ position++ ] };
+					const auto count{ std::min<std::size_t>( ( packet & 0x7Fu ) + 1u, pixel_count - written ) };
+
+					if ( packet & 0x80u )
+					{
+						if ( position + bytes_per_pixel > data.size( ) ) [[unlikely]]
+						{
+							return false;
+						}
+
+						std::uint8_t value[ 4 ]{};
+						if ( !emit( data.data( ) + position, value ) ) [[unlikely]]
+						{
+							return false;
+						}
+
+						position += bytes_per_pixel;
+						for ( std::size_t i{ 0 }; i < count; ++i )
+						{
+							std::memcpy( linear.data( ) + ( written + i ) * 4u, value, 4u );
+						}
+					}
+					else
+					{
+						if ( position + count * bytes_per_pixel > data.size( ) ) [[unlikely]]
+						{
+							return false;
+						}
+
+						for ( std::size_t i{ 0 }; i < count; ++i, position += bytes_per_pixel )
+						{
+							if ( !emit( data.data( ) + position, linear.data( ) + ( written + i ) * 4u ) ) [[unlikely]]
+							{
+								return false;
+							}
+						}
+					}
+
+					written += count;
+				}
+			}
+
+			const auto top_down{ ( descriptor & 0x20u ) != 0u };
+			const auto right_to_left{ ( descriptor & 0x10u ) != 0u };
+			const auto row_bytes{ static_cast< std::size_t >( width ) * 4u };
+
+			for ( std::uint32_t y{ 0 }; y < height; ++y )
+			{
+				const auto src{ linear.data( ) + ( top_down ? y : height - 1u - y ) * row_bytes };
+				auto dst{ out.m_pixels.data( ) + y * row_bytes };
+
+				if ( !right_to_left )
+				{
+					std::memcpy( dst, src, row_bytes );
+					continue;
+				}
+
+				for ( std::uint32_t x{ 0 }; x < width; ++x )
+				{
+					std::memcpy( dst + x * 4u, src + ( width - 1u - x ) * 4u, 4u );
+				}
+			}
+
+			if ( bpp == 32u && !mapped )
+			{
+				force_opaque_if_alpha_empty( out );
+			}
+
+			return true;
+		}
+
+		static void downsample( const std::uint8_t* src, std::uint32_t src_width, std::uint32_t src_height, std::uint8_t* dst, std::uint32_t dst_width, std::uint32_t dst_height ) noexcept
+		{
+			const auto src_stride{ static_cast< std::size_t >( src_width ) * 4u };
+
+			for ( std::uint32_t y{ 0 }; y < dst_height; ++y )
+			{
+				const auto row0{ src + std::min( y * 2u, src_height - 1u ) * src_stride };
+				const auto row1{ src + std::min( y * 2u + 1u, src_height - 1u ) * src_stride };
+				auto out{ dst + static_cast< std::size_t >( y ) * dst_width * 4u };
+
+				std::size_t x{ 0 };
+
+#if defined( ZIMAGE_X86 )
+				if ( src_width >= 2u )
+				{
+					x = downsample_row_sse2( row0, row1, out, dst_width );
+				}
+#endif
+
+				for ( ; x < dst_width; ++x )
+				{
+					const auto x0{ std::min<std::size_t>( x * 2u, src_width - 1u ) * 4u };
+					const auto x1{ std::min<std::size_t>( x * 2u + 1u, src_width - 1u ) * 4u };
+
+					for ( std::size_t c{ 0 }; c < 4u; ++c )
+					{
+						out[ x * 4u + c ] = static_cast< std::uint8_t >( ( row0[ x0 + c ] + row0[ x1 + c ] + row1[ x0 + c ] + row1[ x1 + c ] + 2u ) >> 2 );
+					}
+				}
+			}
+		}
+
+	} // namespace detail
+
+	format detect_format( std::span<const std::byte> data ) noexcept
+	{
+		const std::span<const std::uint8_t> bytes{ reinterpret_cast< const std::uint8_t* >( data.data( ) ), data.size( ) };
+
+		if ( bytes.size( ) >= 8u && bytes[ 0 ] == 0x89u && bytes[ 1 ] == 'P' && bytes[ 2 ] == 'N' && bytes[ 3 ] == 'G' )
+		{
+			return format::png;
+		}
+
+		if ( bytes.size( ) >= 3u && bytes[ 0 ] == 0xFFu && bytes[ 1 ] == 0xD8u && bytes[ 2 ] == 0xFFu )
+		{
+			return format::jpeg;
+		}
+
+		if ( bytes.size( ) >= 26u && bytes[ 0 ] == 'B' && bytes[ 1 ] == 'M' )
+		{
+			return format::bmp;
+		}
+
+		if ( detail::is_tga( bytes ) )
+		{
+			return format::tga;
+		}
+
+		return format::unknown;
+	}
+
+	bool decode( std::span<const std::byte> data, image& out )
+	{
+		const std::span<const std::uint8_t> bytes{ reinterpret_cast< const std::uint8_t* >( data.data( ) ), data.size( ) };
+
+		switch ( detect_format( data ) )
+		{
+		case format::png:
+			return detail::png_decoder{ bytes }.decode( out );
+		case format::jpeg:
+			return detail::jpeg_decoder{ bytes }.decode( out );
+		case format::bmp:
+			return detail::decode_bmp( bytes, out );
+		case format::tga:
+			return detail::decode_tga( bytes, out );
+		default:
+			return false;
+		}
+	}
+
+	std::vector<mip_level> generate_mips( image& img )
+	{
+		std::vector<mip_level> levels{};
+		if ( img.m_width == 0u || img.m_height == 0u )
+		{
+			return levels;
+		}
+
+		auto width{ img.m_width };
+		auto height{ img.m_height };
+		std::size_t total{ 0 };
+
+		for ( ;; )
+		{
+			levels.push_back( { total, width, height } );
+			total += static_cast< std::size_t >( width ) * height * 4u;
+
+			if ( width == 1u && height == 1u )
+			{
+				break;
+			}
+
+			width = std::max( 1u, width / 2u );
+			height = std::max( 1u, height / 2u );
+		}
+
+		img.m_pixels.resize( total );
+
+		for ( std::size_t i{ 1 }; i < levels.size( ); ++i )
+		{
+			const auto& src{ levels[ i - 1u ] };
+			const auto& dst{ levels[ i ] };
+			detail::downsample( img.m_pixels.data( ) + src.m_offset, src.m_width, src.m_height, img.m_pixels.data( ) + dst.m_offset, dst.m_width, dst.m_height );
+		}
+
+		return levels;
+	}
+
+} // namespace zimage
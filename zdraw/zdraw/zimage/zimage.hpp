@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace zimage {
+
+	enum class format { unknown, png, jpeg, bmp, tga };
+
+	// matches D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION; larger images could not be uploaded anyway
+	inline constexpr std::uint32_t k_max_dimension{ 16384u };
+
+	struct image
+	{
+		std::vector<std::uint8_t> m_pixels{};
+		std::uint32_t m_width{ 0 };
+		std::uint32_t m_height{ 0 };
+	};
+
+	struct mip_level
+	{
+		std::size_t m_offset{ 0 };
+		std::uint32_t m_width{ 0 };
+		std::uint32_t m_height{ 0 };
+	};
+
+	[[nodiscard]] format detect_format( std::span<const std::byte> data ) noexcept;
+	[[nodiscard]] bool decode( std::span<const std::byte> data, image& out );
+
+	void rgb_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept;
+	void bgr_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept;
+	void bgra_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept;
+	void gray_to_rgba( const std::uint8_t* src, std::uint8_t* dst, std::size_t pixel_count ) noexcept;
+
+	void premultiply_alpha( std::uint8_t* pixels, std::size_t pixel_count ) noexcept;
+	void luminance_to_alpha( std::uint8_t* pixels, std::size_t pixel_count ) noexcept;
+
+	[[nodiscard]] std::vector<mip_level> generate_mips( image& img );
+
+} // namespace zimage
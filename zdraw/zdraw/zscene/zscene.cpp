@@ -420,7 +420,7 @@ namespace zscene {
 		return p.parent_path( ).string( );
 	}
 
-	static Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> load_texture_from_gltf_image( cgltf_image* image, const std::string& base_path )
+	static zdraw::texture_handle load_texture_from_gltf_image( cgltf_image* image, const std::string& base_path )
 	{
 		if ( !image )
 		{
@@ -436,7 +436,7 @@ namespace zscene {
 				return nullptr;
 			}
 
-			return zdraw::load_texture_from_file( base_path.empty( ) ? uri : base_path + "/" + uri );
+			return zdraw::load_texture_cached_from_file( base_path.empty( ) ? uri : base_path + "/" + uri );
 		}
 		else if ( image->buffer_view )
 		{
@@ -444,7 +444,7 @@ namespace zscene {
 			const auto image_data = buffer_data + image->buffer_view->offset;
 			const auto image_size = image->buffer_view->size;
 
-			return zdraw::load_texture_from_memory( std::span<const std::byte>{ reinterpret_cast< const std::byte* >( image_data ), image_size } );
+			return zdraw::load_texture_cached_from_memory( std::span<const std::byte>{ reinterpret_cast< const std::byte* >( image_data ), image_size } );
 		}
 
 		return nullptr;
@@ -1199,9 +1199,9 @@ namespace zscene {
 
 			if ( m.material_index >= 0 && m.material_index < static_cast< int >( mdl.materials.size( ) ) )
 			{
-				if ( mdl.materials[ m.material_index ].albedo_texture )
+				if ( const auto& albedo{ mdl.materials[ m.material_index ].albedo_texture }; albedo && albedo->ready( ) )
 				{
-					srv = mdl.materials[ m.material_index ].albedo_texture.Get( );
+					srv = albedo->get( );
 				}
 			}
 
@@ -11,6 +11,8 @@
 #include <cstddef>
 #include <cfloat>
 
+#include "../zdraw.hpp"
+
 namespace zscene {
 
 	using namespace DirectX;
@@ -70,7 +72,7 @@ namespace zscene {
 	struct material
 	{
 		XMFLOAT4 base_color{ 1.0f, 1.0f, 1.0f, 1.0f };
-		ComPtr<ID3D11ShaderResourceView> albedo_texture{};
+		zdraw::texture_handle albedo_texture{};
 		std::string name{};
 	};
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -98,10 +99,19 @@ namespace
 			this->m_hwnd = hwnd;
 		}
 
-		void update( ) noexcept
+		void update( )
 		{
+			std::scoped_lock lock{ this->m_mutex };
+
+			this->m_current = this->m_pending;
 			this->m_current.scroll_delta = this->m_pending_scroll_delta;
 			this->m_pending_scroll_delta = 0.0f;
+
+			this->m_pending.mouse_clicked = false;
+			this->m_pending.mouse_released = false;
+			this->m_pending.right_mouse_clicked = false;
+			this->m_pending.right_mouse_released = false;
+			this->m_pending.clear_queues( );
 		}
 
 		void clear_frame_events( ) noexcept
@@ -118,42 +128,44 @@ namespace
 
 		bool process_wndproc_message( UINT msg, WPARAM wparam, LPARAM lparam ) noexcept
 		{
+			std::scoped_lock lock{ this->m_mutex };
+
 			switch ( msg )
 			{
 			case WM_MOUSEMOVE:
 			{
 				const auto x = static_cast< short >( LOWORD( lparam ) );
 				const auto y = static_cast< short >( HIWORD( lparam ) );
-				this->m_current.mouse_x = static_cast< float >( x );
-				this->m_current.mouse_y = static_cast< float >( y );
+				this->m_pending.mouse_x = static_cast< float >( x );
+				this->m_pending.mouse_y = static_cast< float >( y );
 				return true;
 			}
 
 			case WM_LBUTTONDOWN:
 			{
-				this->m_current.mouse_down = true;
-				this->m_current.mouse_clicked = true;
+				this->m_pending.mouse_down = true;
+				this->m_pending.mouse_clicked = true;
 				return true;
 			}
 
 			case WM_LBUTTONUP:
 			{
-				this->m_current.mouse_down = false;
-				this->m_current.mouse_released = true;
+				this->m_pending.mouse_down = false;
+				this->m_pending.mouse_released = true;
 				return true;
 			}
 
 			case WM_RBUTTONDOWN:
 			{
-				this->m_current.right_mouse_down = true;
-				this->m_current.right_mouse_clicked = true;
+				this->m_pending.right_mouse_down = true;
+				this->m_pending.right_mouse_clicked = true;
 				return true;
 			}
 
 			case WM_RBUTTONUP:
 			{
-				this->m_current.right_mouse_down = false;
-				this->m_current.right_mouse_released = true;
+				this->m_pending.right_mouse_down = false;
+				this->m_pending.right_mouse_released = true;
 				return true;
 			}
 
@@ -169,7 +181,7 @@ namespace
 				const auto c = static_cast< wchar_t >( wparam );
 				if ( c >= 32 && c != 127 )
 				{
-					this->m_current.push_char( c );
+					this->m_pending.push_char( c );
 				}
 
 				return true;
@@ -177,15 +189,15 @@ namespace
 
 			case WM_MBUTTONDOWN:
 			{
-				this->m_current.push_key_press( VK_MBUTTON );
-				this->m_current.key_down_map[ VK_MBUTTON ] = true;
+				this->m_pending.push_key_press( VK_MBUTTON );
+				this->m_pending.key_down_map[ VK_MBUTTON ] = true;
 				return true;
 			}
 
 			case WM_MBUTTONUP:
 			{
-				this->m_current.push_key_release( VK_MBUTTON );
-				this->m_current.key_down_map[ VK_MBUTTON ] = false;
+				this->m_pending.push_key_release( VK_MBUTTON );
+				this->m_pending.key_down_map[ VK_MBUTTON ] = false;
 				return true;
 			}
 
@@ -194,13 +206,13 @@ namespace
 				const auto button = GET_XBUTTON_WPARAM( wparam );
 				if ( button == XBUTTON1 )
 				{
-					this->m_current.push_key_press( VK_XBUTTON1 );
-					this->m_current.key_down_map[ VK_XBUTTON1 ] = true;
+					this->m_pending.push_key_press( VK_XBUTTON1 );
+					this->m_pending.key_down_map[ VK_XBUTTON1 ] = true;
 				}
 				else if ( button == XBUTTON2 )
 				{
-					this->m_current.push_key_press( VK_XBUTTON2 );
-					this->m_current.key_down_map[ VK_XBUTTON2 ] = true;
+					this->m_pending.push_key_press( VK_XBUTTON2 );
+					this->m_pending.key_down_map[ VK_XBUTTON2 ] = true;
 				}
 
 				return true;
@@ -211,13 +223,13 @@ namespace
 				const auto button = GET_XBUTTON_WPARAM( wparam );
 				if ( button == XBUTTON1 )
 				{
-					this->m_current.push_key_release( VK_XBUTTON1 );
-					this->m_current.key_down_map[ VK_XBUTTON1 ] = false;
+					this->m_pending.push_key_release( VK_XBUTTON1 );
+					this->m_pending.key_down_map[ VK_XBUTTON1 ] = false;
 				}
 				else if ( button == XBUTTON2 )
 				{
-					this->m_current.push_key_release( VK_XBUTTON2 );
-					this->m_current.key_down_map[ VK_XBUTTON2 ] = false;
+					this->m_pending.push_key_release( VK_XBUTTON2 );
+					this->m_pending.key_down_map[ VK_XBUTTON2 ] = false;
 				}
 
 				return true;
@@ -227,10 +239,10 @@ namespace
 			case WM_SYSKEYDOWN:
 			{
 				const auto vk = static_cast< int >( wparam );
-				if ( !this->m_current.key_down_map[ vk ] )
+				if ( !this->m_pending.key_down_map[ vk ] )
 				{
-					this->m_current.push_key_press( vk );
-					this->m_current.key_down_map[ vk ] = true;
+					this->m_pending.push_key_press( vk );
+					this->m_pending.key_down_map[ vk ] = true;
 				}
 
 				return true;
@@ -240,8 +252,8 @@ namespace
 			case WM_SYSKEYUP:
 			{
 				const auto vk = static_cast< int >( wparam );
-				this->m_current.push_key_release( vk );
-				this->m_current.key_down_map[ vk ] = false;
+				this->m_pending.push_key_release( vk );
+				this->m_pending.key_down_map[ vk ] = false;
 				return true;
 			}
 
@@ -252,6 +264,7 @@ namespace
 
 		void add_scroll_delta( float delta ) noexcept
 		{
+			std::scoped_lock lock{ this->m_mutex };
 			this->m_pending_scroll_delta += delta;
 		}
 
@@ -282,52 +295,9 @@ namespace
 		HWND m_hwnd{ nullptr };
 		input_state m_current{};
 		input_state m_prev{};
+		input_state m_pending{};
 		float m_pending_scroll_delta{ 0.0f };
-	};
-
-	class string_interner
-	{
-	public:
-		[[nodiscard]] std::string_view intern( std::string_view sv )
-		{
-			if ( this->is_interned( sv ) )
-			{
-				return sv;
-			}
-
-			const auto it = this->m_pool.find( sv.data( ) );
-			if ( it != this->m_pool.end( ) )
-			{
-				return std::string_view( *it );
-			}
-
-			const auto [inserted_it, success] = this->m_pool.insert( std::string( sv ) );
-			return std::string_view( *inserted_it );
-		}
-
-		[[nodiscard]] bool is_interned( std::string_view sv ) const noexcept
-		{
-			for ( const auto& str : this->m_pool )
-			{
-				const auto pool_begin = str.data( );
-				const auto pool_end = pool_begin + str.size( );
-
-				if ( sv.data( ) >= pool_begin && sv.data( ) < pool_end )
-				{
-					return true;
-				}
-			}
-
-			return false;
-		}
-
-		void clear( )
-		{
-			this->m_pool.clear( );
-		}
-
-	private:
-		ankerl::unordered_dense::set<std::string> m_pool{};
+		std::mutex m_mutex{};
 	};
 
 	class animation_manager
@@ -527,7 +497,7 @@ namespace
 	class combo_overlay : public overlay
 	{
 	public:
-		combo_overlay( widget_id id, const zui::rect& anchor, float width, const std::vector<std::string>& items, int* current_item, std::function<void( )> on_change = nullptr ) : overlay{ id, anchor }, m_width{ width }, m_items{ items }, m_current_item{ current_item }, m_on_change{ std::move( on_change ) }
+		combo_overlay( widget_id id, const zui::rect& anchor, float width, std::span<const char* const> items, int* current_item, std::function<void( )> on_change = nullptr ) : overlay{ id, anchor }, m_width{ width }, m_items{ items.begin( ), items.end( ) }, m_current_item{ current_item }, m_on_change{ std::move( on_change ) }
 		{
 			this->m_item_anims.resize( items.size( ), 0.0f );
 			this->m_hover_anims.resize( items.size( ), 0.0f );
@@ -643,6 +613,9 @@ namespace
 				const auto item_alpha = item_ease * alpha_mult;
 				const auto slide_offset = ( 1.0f - item_ease ) * 8.0f;
 
+				const auto item_mark = dl.mark( );
+				dl.push_transform( zdraw::mat2x3::translation( 0.0f, slide_offset ) );
+
 				const auto is_selected = this->m_current_item && ( i == *this->m_current_item );
 				const auto is_hovered = item_rect.contains( input.mouse_x, input.mouse_y );
 
@@ -658,17 +631,17 @@ namespace
 				if ( selected_ease > 0.01f )
 				{
 					auto border_left = style.accent;
-					border_left.a = static_cast< std::uint8_t >( 220 * item_alpha * selected_ease );
-					dl.add_rect_filled( item_rect.x, item_rect.y + slide_offset, 2.5f, item_rect.h, border_left );
+					border_left.a = static_cast< std::uint8_t >( 220 * selected_ease );
+					dl.add_rect_filled( item_rect.x, item_rect.y, 2.5f, item_rect.h, border_left );
 
 					auto gradient_left = style.combo_item_selected;
-					gradient_left.a = static_cast< std::uint8_t >( std::min( gradient_left.a * 3.5f, 255.0f ) * item_alpha * selected_ease );
+					gradient_left.a = static_cast< std::uint8_t >( std::min( gradient_left.a * 3.5f, 255.0f ) * selected_ease );
 					auto gradient_right = gradient_left;
 					gradient_right.a = 0;
 
 					dl.add_rect_filled_multi_color(
 						item_rect.x + 2.5f,
-						item_rect.y + slide_offset,
+						item_rect.y,
 						item_rect.w - 2.5f,
 						item_rect.h,
 						gradient_left, gradient_right, gradient_right, gradient_left
@@ -676,35 +649,36 @@ namespace
 
 					const auto dot_size = 4.0f;
 					const auto dot_x = item_rect.x + item_rect.w - dot_size - 8.0f;
-					const auto dot_y = item_rect.y + ( item_height - dot_size ) * 0.5f + slide_offset;
+					const auto dot_y = item_rect.y + ( item_height - dot_size ) * 0.5f;
 
 					auto dot_col = style.accent;
-					dot_col.a = static_cast< std::uint8_t >( 160 * item_alpha * selected_ease );
+					dot_col.a = static_cast< std::uint8_t >( 160 * selected_ease );
 					dl.add_rect_filled( dot_x, dot_y, dot_size, dot_size, dot_col );
 				}
 
 				if ( hover_anim > 0.01f )
 				{
 					auto hover_left = style.combo_item_hovered;
-					hover_left.a = static_cast< std::uint8_t >( std::min( hover_left.a * 2.5f, 255.0f ) * item_alpha * hover_anim );
+					hover_left.a = static_cast< std::uint8_t >( std::min( hover_left.a * 2.5f, 255.0f ) * hover_anim );
 					auto hover_right = hover_left;
 					hover_right.a = 0;
 
-					dl.add_rect_filled_multi_color( item_rect.x, item_rect.y + slide_offset, item_rect.w, item_rect.h, hover_left, hover_right, hover_right, hover_left );
+					dl.add_rect_filled_multi_color( item_rect.x, item_rect.y, item_rect.w, item_rect.h, hover_left, hover_right, hover_right, hover_left );
 				}
 
 				auto [text_w, text_h] = zdraw::measure_text( this->m_items[ i ] );
 				const auto text_x = item_rect.x + 10.0f;
-				const auto text_y = item_rect.y + ( item_height - text_h ) * 0.5f + slide_offset;
+				const auto text_y = item_rect.y + ( item_height - text_h ) * 0.5f;
 
 				auto text_col = style.text;
 				auto selected_text_col = zui::lerp( style.text, style.accent, 0.4f );
 				text_col = zui::lerp( text_col, selected_text_col, selected_ease );
 				text_col = zui::lerp( text_col, zui::lighten( text_col, 1.3f ), hover_anim );
 
-				text_col.a = static_cast< std::uint8_t >( text_col.a * item_alpha );
-
 				dl.add_text( text_x, text_y, this->m_items[ i ].c_str( ), text_col );
+
+				dl.pop_transform( );
+				dl.modulate_range( item_mark, dl.mark( ), zdraw::rgba{ 255, 255, 255, static_cast< std::uint8_t >( 255 * item_alpha ) } );
 			}
 
 			dl.pop_clip_rect( );
@@ -874,6 +848,9 @@ namespace
 				const auto item_alpha = item_ease * alpha_mult;
 				const auto slide_offset = ( 1.0f - item_ease ) * 8.0f;
 
+				const auto item_mark = dl.mark( );
+				dl.push_transform( zdraw::mat2x3::translation( 0.0f, slide_offset ) );
+
 				const auto is_selected = this->m_selected_items && this->m_selected_items[ i ];
 				const auto is_hovered = item_rect.contains( input.mouse_x, input.mouse_y ) && !this->m_closing;
 
@@ -890,20 +867,18 @@ namespace
 				if ( hover_ease > 0.01f )
 				{
 					auto hover_left = style.combo_item_hovered;
-					hover_left.a = static_cast< std::uint8_t >( std::min( hover_left.a * 2.5f, 255.0f ) * item_alpha * hover_ease );
+					hover_left.a = static_cast< std::uint8_t >( std::min( hover_left.a * 2.5f, 255.0f ) * hover_ease );
 					auto hover_right = hover_left;
 					hover_right.a = 0;
 
-					dl.add_rect_filled_multi_color( item_rect.x, item_rect.y + slide_offset, item_rect.w, item_rect.h, hover_left, hover_right, hover_right, hover_left );
+					dl.add_rect_filled_multi_color( item_rect.x, item_rect.y, item_rect.w, item_rect.h, hover_left, hover_right, hover_right, hover_left );
 				}
 
 				constexpr auto check_size = 12.0f;
 				const auto check_x = item_rect.x + 4.0f;
-				const auto check_y = item_rect.y + ( item_height - check_size ) * 0.5f + slide_offset;
+				const auto check_y = item_rect.y + ( item_height - check_size ) * 0.5f;
 
-				auto check_bg = style.checkbox_bg;
-				check_bg.a = static_cast< std::uint8_t >( check_bg.a * item_alpha );
-				dl.add_rect_filled( check_x, check_y, check_size, check_size, check_bg );
+				dl.add_rect_filled( check_x, check_y, check_size, check_size, style.checkbox_bg );
 
 				auto check_border = style.checkbox_border;
 				if ( check_ease > 0.01f )
@@ -911,7 +886,6 @@ namespace
 					check_border = zui::lerp( check_border, style.checkbox_check, check_ease * 0.5f );
 				}
 
-				check_border.a = static_cast< std::uint8_t >( check_border.a * item_alpha );
 				dl.add_rect( check_x, check_y, check_size, check_size, check_border );
 
 				if ( check_ease > 0.01f )
@@ -924,13 +898,13 @@ namespace
 					const auto fill_y = check_y + pad + ( inner_size - scaled_size ) * 0.5f;
 
 					auto fill_col = style.checkbox_check;
-					fill_col.a = static_cast< std::uint8_t >( fill_col.a * check_ease * item_alpha );
+					fill_col.a = static_cast< std::uint8_t >( fill_col.a * check_ease );
 					dl.add_rect_filled( fill_x, fill_y, scaled_size, scaled_size, fill_col );
 				}
 
 				auto [text_w, text_h] = zdraw::measure_text( this->m_items[ i ] );
 				const auto text_x = item_rect.x + check_size + 10.0f;
-				const auto text_y = item_rect.y + ( item_height - text_h ) * 0.5f + slide_offset;
+				const auto text_y = item_rect.y + ( item_height - text_h ) * 0.5f;
 
 				auto text_col = style.text;
 				if ( check_ease > 0.5f )
@@ -940,9 +914,10 @@ namespace
 
 				text_col = zui::lerp( text_col, zui::lighten( text_col, 1.2f ), hover_ease );
 
-				text_col.a = static_cast< std::uint8_t >( text_col.a * item_alpha );
-
 				dl.add_text( text_x, text_y, this->m_items[ i ].c_str( ), text_col );
+
+				dl.pop_transform( );
+				dl.modulate_range( item_mark, dl.mark( ), zdraw::rgba{ 255, 255, 255, static_cast< std::uint8_t >( 255 * item_alpha ) } );
 			}
 
 			dl.pop_clip_rect( );
@@ -1385,15 +1360,19 @@ namespace
 			const auto hue_rect = zui::rect{ scaled_x + pad, sv_rect.bottom( ) + pad, sv_size, hue_h };
 			const auto alpha_rect = zui::rect{ sv_rect.right( ) + pad, scaled_y + pad, alpha_bar_w, sv_size + pad + hue_h };
 
-			this->render_sv_square( sv_rect, content_alpha );
-			this->render_hue_bar( hue_rect, content_alpha );
+			const auto content_mark = dl.mark( );
+
+			this->render_sv_square( sv_rect );
+			this->render_hue_bar( hue_rect );
 
 			if ( this->m_show_alpha )
 			{
-				this->render_alpha_bar( alpha_rect, content_alpha );
+				this->render_alpha_bar( alpha_rect );
 			}
 
-			this->render_cursors( sv_rect, hue_rect, alpha_rect, content_alpha );
+			this->render_cursors( sv_rect, hue_rect, alpha_rect );
+
+			dl.modulate_range( content_mark, dl.mark( ), zdraw::rgba{ 255, 255, 255, static_cast< std::uint8_t >( 255 * content_alpha ) } );
 
 			dl.pop_clip_rect( );
 		}
@@ -1420,7 +1399,7 @@ namespace
 			};
 		}
 
-		void render_sv_square( const zui::rect& r, float alpha ) const
+		void render_sv_square( const zui::rect& r ) const
 		{
 			auto& dl = zdraw::get_draw_list( zdraw::draw_layer::topmost );
 
@@ -1431,15 +1410,13 @@ namespace
 					const auto s = static_cast< float >( x ) / r.w;
 					const auto v = 1.0f - static_cast< float >( y ) / r.h;
 
-					auto color = zui::hsv_to_rgb( this->m_hue * 360.0f, s, v );
-					color.a = static_cast< std::uint8_t >( color.a * alpha );
-
+					const auto color = zui::hsv_to_rgb( this->m_hue * 360.0f, s, v );
 					dl.add_rect_filled( r.x + x, r.y + y, 1.0f, 1.0f, color );
 				}
 			}
 		}
 
-		void render_hue_bar( const zui::rect& r, float alpha ) const
+		void render_hue_bar( const zui::rect& r ) const
 		{
 			auto& dl = zdraw::get_draw_list( zdraw::draw_layer::topmost );
 
@@ -1447,14 +1424,12 @@ namespace
 			{
 				const auto h = ( static_cast< float >( x ) / r.w ) * 360.0f;
 
-				auto color = zui::hsv_to_rgb( h, 1.0f, 1.0f );
-				color.a = static_cast< std::uint8_t >( color.a * alpha );
-
+				const auto color = zui::hsv_to_rgb( h, 1.0f, 1.0f );
 				dl.add_rect_filled( r.x + x, r.y, 1.0f, r.h, color );
 			}
 		}
 
-		void render_alpha_bar( const zui::rect& r, float alpha ) const
+		void render_alpha_bar( const zui::rect& r ) const
 		{
 			auto& dl = zdraw::get_draw_list( zdraw::draw_layer::topmost );
 
@@ -1463,9 +1438,7 @@ namespace
 				for ( int y = 0; y < static_cast< int >( r.h ); y += 6 )
 				{
 					const auto is_dark = ( ( x / 6 ) + ( y / 6 ) ) % 2 == 0;
-					auto checker_col = is_dark ? zdraw::rgba{ 180, 180, 180, 255 } : zdraw::rgba{ 220, 220, 220, 255 };
-
-					checker_col.a = static_cast< std::uint8_t >( checker_col.a * alpha );
+					const auto checker_col = is_dark ? zdraw::rgba{ 180, 180, 180, 255 } : zdraw::rgba{ 220, 220, 220, 255 };
 					dl.add_rect_filled( r.x + x, r.y + y, std::min( 6.0f, r.w - x ), std::min( 6.0f, r.h - y ), checker_col );
 				}
 			}
@@ -1474,21 +1447,21 @@ namespace
 			{
 				for ( int y = 0; y < static_cast< int >( r.h ); ++y )
 				{
-					const auto a = static_cast< std::uint8_t >( ( 1.0f - static_cast< float >( y ) / r.h ) * 255.0f * alpha );
+					const auto a = static_cast< std::uint8_t >( ( 1.0f - static_cast< float >( y ) / r.h ) * 255.0f );
 					const auto color = zdraw::rgba{ this->m_color_ptr->r, this->m_color_ptr->g, this->m_color_ptr->b, a };
 					dl.add_rect_filled( r.x, r.y + y, r.w, 1.0f, color );
 				}
 			}
 		}
 
-		void render_cursors( const zui::rect& sv, const zui::rect& hue, const zui::rect& alpha, float content_alpha ) const
+		void render_cursors( const zui::rect& sv, const zui::rect& hue, const zui::rect& alpha ) const
 		{
 			auto& dl = zdraw::get_draw_list( zdraw::draw_layer::topmost );
 
 			const auto sv_x = sv.x + this->m_saturation * sv.w;
 			const auto sv_y = sv.y + ( 1.0f - this->m_value ) * sv.h;
-			auto white_col = zdraw::rgba{ 255, 255, 255, static_cast< std::uint8_t >( 255 * content_alpha ) };
-			auto black_col = zdraw::rgba{ 0, 0, 0, static_cast< std::uint8_t >( 255 * content_alpha ) };
+			const auto white_col = zdraw::rgba{ 255, 255, 255, 255 };
+			const auto black_col = zdraw::rgba{ 0, 0, 0, 255 };
 			dl.add_rect( sv_x - 4.0f, sv_y - 4.0f, 8.0f, 8.0f, white_col, 2.0f );
 			dl.add_rect( sv_x - 3.0f, sv_y - 3.0f, 6.0f, 6.0f, black_col, 3.0f );
 
@@ -1630,7 +1603,7 @@ namespace
 		{
 			this->m_input.update( );
 			this->m_windows.clear( );
-			this->m_id_stack.clear( );
+			this->m_id_seeds.clear( );
 		}
 
 		void end_frame( )
@@ -1664,9 +1637,6 @@ namespace
 		[[nodiscard]] overlay_manager& overlays( ) noexcept { return this->m_overlays; }
 		[[nodiscard]] const overlay_manager& overlays( ) const noexcept { return this->m_overlays; }
 
-		[[nodiscard]] string_interner& strings( ) noexcept { return this->m_string_interner; }
-		[[nodiscard]] std::string& truncation_buffer( ) noexcept { return this->m_truncation_scratch; }
-
 		[[nodiscard]] bool overlay_blocking_input( ) const { return this->m_overlays.has_active_overlay( ); }
 
 		void push_window( zui::window_state&& state ) { this->m_windows.push_back( std::move( state ) ); }
@@ -1684,14 +1654,14 @@ namespace
 
 		void push_id( widget_id id )
 		{
-			this->m_id_stack.push_back( id );
+			this->m_id_seeds.push_back( combine_id( this->current_seed( ), id ) );
 		}
 
 		void pop_id( )
 		{
-			if ( !this->m_id_stack.empty( ) )
+			if ( !this->m_id_seeds.empty( ) )
 			{
-				this->m_id_stack.pop_back( );
+				this->m_id_seeds.pop_back( );
 			}
 		}
 
@@ -1706,18 +1676,9 @@ namespace
 			return label;
 		}
 
-		[[nodiscard]] widget_id generate_id( std::string_view label )
+		[[nodiscard]] widget_id generate_id( const zui::hashed_label& label ) const noexcept
 		{
-			const auto interned = this->m_string_interner.intern( label );
-			auto h = fnv1a64( interned.data( ), interned.size( ) );
-
-			for ( const auto& parent_id : this->m_id_stack )
-			{
-				h ^= parent_id;
-				h *= 1099511628211ull;
-			}
-
-			return h;
+			return combine_id( this->current_seed( ), label.hash );
 		}
 
 		widget_id m_active_window_id{ invalid_id };
@@ -1732,29 +1693,24 @@ namespace
 		std::unordered_map<widget_id, float> m_group_box_heights{};
 
 	private:
-		static std::uintptr_t fnv1a64( const void* p, std::size_t n )
+		[[nodiscard]] static constexpr widget_id combine_id( widget_id seed, widget_id hash ) noexcept
 		{
-			const auto* b = static_cast< const unsigned char* >( p );
-			auto h{ 14695981039346656037ull };
-
-			while ( n-- )
-			{
-				h ^= *b++;
-				h *= 1099511628211ull;
-			}
+			const auto s = static_cast< std::uint64_t >( seed );
+			return static_cast< widget_id >( s ^ ( static_cast< std::uint64_t >( hash ) + 0x9e3779b97f4a7c15ull + ( s << 6 ) + ( s >> 2 ) ) );
+		}
 
-			return h;
+		[[nodiscard]] widget_id current_seed( ) const noexcept
+		{
+			return this->m_id_seeds.empty( ) ? invalid_id : this->m_id_seeds.back( );
 		}
 
 		input_manager m_input{};
 		zui::style m_style{};
 		animation_manager m_anims{};
 		overlay_manager m_overlays{};
-		string_interner m_string_interner{};
-		std::string m_truncation_scratch{};
 
 		std::vector<zui::window_state> m_windows{};
-		std::vector<widget_id> m_id_stack{};
+		std::vector<widget_id> m_id_seeds{};
 	};
 
 	context& ctx( )
@@ -1840,7 +1796,7 @@ namespace zui {
 		};
 	}
 
-	static std::string_view maybe_truncate_text( std::string_view text, float max_width, std::string& scratch_buffer )
+	static std::string_view maybe_truncate_text( std::string_view text, float max_width )
 	{
 		const auto [text_w, text_h] = zdraw::measure_text( text );
 		if ( text_w <= max_width )
@@ -1877,12 +1833,10 @@ namespace zui {
 			}
 		}
 
-		scratch_buffer.clear( );
-		scratch_buffer.reserve( best_fit + 3 );
-		scratch_buffer.assign( text.data( ), best_fit );
-		scratch_buffer.append( "..." );
+		zdraw::frame_string truncated{};
+		truncated.append( text.substr( 0, best_fit ) ).append( "..." );
 
-		return scratch_buffer;
+		return truncated;
 	}
 
 	hsv rgb_to_hsv( const zdraw::rgba& color ) noexcept
@@ -2272,7 +2226,7 @@ namespace zui {
 		}
 	}
 
-	bool begin_window( std::string_view title, float& x, float& y, float& w, float& h, bool resizable, float min_w, float min_h )
+	bool begin_window( hashed_label title, float& x, float& y, float& w, float& h, bool resizable, float min_w, float min_h )
 	{
 		const auto id = ctx( ).generate_id( title );
 		auto abs = rect{ x, y, w, h };
@@ -2318,7 +2272,7 @@ namespace zui {
 		}
 
 		window_state state{};
-		state.title.assign( title.begin( ), title.end( ) );
+		state.title = zdraw::get_frame_arena( ).copy( title.text );
 		state.bounds = abs;
 		state.cursor_x = style.window_padding_x;
 		state.cursor_y = style.window_padding_y;
@@ -2368,7 +2322,7 @@ namespace zui {
 		ctx( ).pop_id( );
 	}
 
-	bool begin_nested_window( std::string_view title, float w, float h )
+	bool begin_nested_window( hashed_label title, float w, float h )
 	{
 		const auto parent = ctx( ).current_window( );
 		if ( !parent )
@@ -2389,7 +2343,7 @@ namespace zui {
 		}
 
 		window_state state{};
-		state.title.assign( title.begin( ), title.end( ) );
+		state.title = zdraw::get_frame_arena( ).copy( title.text );
 		state.bounds = abs;
 		state.cursor_x = style.window_padding_x;
 		state.cursor_y = style.window_padding_y;
@@ -2424,7 +2378,7 @@ namespace zui {
 		end_window( );
 	}
 
-	bool begin_group_box( std::string_view title, float w, float h )
+	bool begin_group_box( hashed_label title, float w, float h )
 	{
 		const auto parent = ctx( ).current_window( );
 		if ( !parent )
@@ -2465,37 +2419,14 @@ namespace zui {
 		zdraw::get_draw_list( ).add_rect_filled( abs.x, border_y, abs.w, box_height, style.group_box_bg );
 		zdraw::get_draw_list( ).add_rect( abs.x, border_y, abs.w, box_height, style.group_box_border, style.border_thickness );
 
-		if ( !title.empty( ) )
+		if ( !title.text.empty( ) )
 		{
 			const auto text_x = abs.x + style.window_padding_x;
 			const auto pad{ 4.0f };
 			const auto max_title_width = abs.w - style.window_padding_x * 2.0f - pad * 2.0f;
 
-			std::string title_str( title.begin( ), title.end( ) );
-			auto [title_w, title_h_measured] = zdraw::measure_text( title_str );
-
-			if ( title_w > max_title_width )
-			{
-				const auto [ellipsis_w, ellipsis_h] = zdraw::measure_text( "..." );
-				const auto available_for_text = max_title_width - ellipsis_w;
-
-				std::string truncated{};
-				for ( char c : title_str )
-				{
-					std::string test = truncated + c;
-					const auto [test_w, test_h] = zdraw::measure_text( test );
-
-					if ( test_w > available_for_text )
-					{
-						break;
-					}
-
-					truncated = test;
-				}
-
-				title_str = truncated + "...";
-				title_w = zdraw::measure_text( title_str ).first;
-			}
+			const auto title_str = maybe_truncate_text( title.text, max_title_width );
+			const auto [title_w, title_h_measured] = zdraw::measure_text( title_str );
 
 			const auto gap_start = text_x - pad;
 			const auto gap_end = text_x + title_w + pad;
@@ -2514,7 +2445,7 @@ namespace zui {
 		}
 
 		window_state state{};
-		state.title.assign( title.begin( ), title.end( ) );
+		state.title = zdraw::get_frame_arena( ).copy( title.text );
 		state.bounds = abs;
 		state.cursor_x = style.window_padding_x;
 		state.cursor_y = title_h + style.window_padding_y;
@@ -2776,7 +2707,7 @@ namespace zui {
 		zdraw::get_draw_list( ).add_text_multi_color( abs.x, abs.y, label, color_tl, color_tr, color_br, color_bl );
 	}
 
-	bool button( std::string_view label, float w, float h )
+	bool button( hashed_label label, float w, float h )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win )
@@ -2810,11 +2741,11 @@ namespace zui {
 		zdraw::get_draw_list( ).add_rect_filled_multi_color( abs.x, abs.y, abs.w, abs.h, col_top, col_top, col_bottom, col_bottom );
 		zdraw::get_draw_list( ).add_rect( abs.x, abs.y, abs.w, abs.h, border_col );
 
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		if ( !display_label.empty( ) )
 		{
 			const auto available_w = abs.w - style.frame_padding_x * 2.0f;
-			const auto label_text = maybe_truncate_text( display_label, available_w, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, available_w );
 			auto [label_w, label_h] = zdraw::measure_text( label_text );
 			const auto text_x = abs.x + ( abs.w - label_w ) * 0.5f;
 			const auto text_y = abs.y + ( abs.h - label_h ) * 0.5f;
@@ -2825,7 +2756,7 @@ namespace zui {
 		return pressed;
 	}
 
-	bool checkbox( std::string_view label, bool& v )
+	bool checkbox( hashed_label label, bool& v )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win )
@@ -2834,7 +2765,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
 		auto& anims = ctx( ).anims( );
@@ -2844,7 +2775,7 @@ namespace zui {
 		const auto abs = to_absolute( local );
 
 		const auto [label_w, label_h] = zdraw::measure_text( display_label );
-		const auto full_width = !label.empty( ) ? ( abs.w + style.item_spacing_x + label_w ) : abs.w;
+		const auto full_width = !label.text.empty( ) ? ( abs.w + style.item_spacing_x + label_w ) : abs.w;
 		const auto extended = rect{ abs.x, abs.y, full_width, abs.h };
 
 		const auto can_interact = !ctx( ).overlay_blocking_input( );
@@ -2921,7 +2852,7 @@ namespace zui {
 			const auto text_y = abs.y + ( check_size - label_h ) * 0.5f;
 
 			const auto available_w = win->bounds.right( ) - text_x - style.window_padding_x;
-			const auto label_text = maybe_truncate_text( display_label, available_w, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, available_w );
 
 			zdraw::get_draw_list( ).add_text( text_x, text_y, label_text, style.text );
 		}
@@ -2932,7 +2863,7 @@ namespace zui {
 	namespace
 	{
 		template<typename T>
-		bool slider_impl( std::string_view label, T& v, T v_min, T v_max, std::string_view format )
+		bool slider_impl( hashed_label label, T& v, T v_min, T v_max, std::string_view format )
 		{
 			const auto win = ctx( ).current_window( );
 			if ( !win )
@@ -2941,7 +2872,7 @@ namespace zui {
 			}
 
 			const auto id = ctx( ).generate_id( label );
-			const auto display_label = context::get_display_label( label );
+			const auto display_label = context::get_display_label( label.text );
 			const auto& style = ctx( ).get_style( );
 			const auto& input = ctx( ).input( );
 			auto& anims = ctx( ).anims( );
@@ -3063,7 +2994,7 @@ namespace zui {
 			if ( !display_label.empty( ) )
 			{
 				const auto available_label_w = slider_width - value_w - style.item_spacing_x;
-				const auto label_text = maybe_truncate_text( display_label, available_label_w, ctx( ).truncation_buffer( ) );
+				const auto label_text = maybe_truncate_text( display_label, available_label_w );
 				zdraw::get_draw_list( ).add_text( abs.x, abs.y, label_text, style.text );
 			}
 
@@ -3113,17 +3044,17 @@ namespace zui {
 		}
 	}
 
-	bool slider_float( std::string_view label, float& v, float v_min, float v_max, std::string_view format )
+	bool slider_float( hashed_label label, float& v, float v_min, float v_max, std::string_view format )
 	{
 		return slider_impl( label, v, v_min, v_max, format );
 	}
 
-	bool slider_int( std::string_view label, int& v, int v_min, int v_max, std::string_view format )
+	bool slider_int( hashed_label label, int& v, int v_min, int v_max, std::string_view format )
 	{
 		return slider_impl( label, v, v_min, v_max, format );
 	}
 
-	bool keybind( std::string_view label, int& key )
+	bool keybind( hashed_label label, int& key )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win )
@@ -3132,7 +3063,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
 		auto& anims = ctx( ).anims( );
@@ -3277,7 +3208,7 @@ namespace zui {
 			const auto label_y = abs.y + ( total_h - label_h ) * 0.5f;
 
 			const auto available_w = win->bounds.right( ) - label_x - style.window_padding_x;
-			const auto label_text = maybe_truncate_text( display_label, available_w, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, available_w );
 
 			zdraw::get_draw_list( ).add_text( label_x, label_y, label_text, style.text );
 		}
@@ -3321,7 +3252,7 @@ namespace zui {
 		return false;
 	}
 
-	bool combo( std::string_view label, int& current_item, const char* const items[ ], int items_count, float width )
+	bool combo( hashed_label label, int& current_item, const char* const items[ ], int items_count, float width )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win || items_count == 0 )
@@ -3330,7 +3261,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
 		auto& anims = ctx( ).anims( );
@@ -3361,7 +3292,7 @@ namespace zui {
 
 		if ( !display_label.empty( ) )
 		{
-			const auto label_text = maybe_truncate_text( display_label, width, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, width );
 			zdraw::get_draw_list( ).add_text( abs.x, abs.y, label_text, style.text );
 		}
 
@@ -3382,15 +3313,7 @@ namespace zui {
 			}
 			else
 			{
-				std::vector<std::string> item_strings{};
-				item_strings.reserve( items_count );
-
-				for ( int i = 0; i < items_count; ++i )
-				{
-					item_strings.emplace_back( items[ i ] );
-				}
-
-				overlays.add<combo_overlay>( id, button_rect, width, item_strings, &current_item );
+				overlays.add<combo_overlay>( id, button_rect, width, std::span{ items, static_cast< std::size_t >( items_count ) }, &current_item );
 			}
 		}
 
@@ -3427,7 +3350,7 @@ namespace zui {
 		return changed;
 	}
 
-	bool multicombo( std::string_view label, bool* selected_items, const char* const items[ ], int items_count, float width )
+	bool multicombo( hashed_label label, bool* selected_items, const char* const items[ ], int items_count, float width )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win || items_count == 0 || !selected_items )
@@ -3436,7 +3359,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
 		auto& anims = ctx( ).anims( );
@@ -3471,7 +3394,7 @@ namespace zui {
 
 		if ( !display_label.empty( ) )
 		{
-			const auto label_text = maybe_truncate_text( display_label, width, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, width );
 			zdraw::get_draw_list( ).add_text( abs.x, abs.y, label_text, style.text );
 		}
 
@@ -3504,7 +3427,7 @@ namespace zui {
 		zdraw::get_draw_list( ).add_rect( button_rect.x, button_rect.y, button_rect.w, button_rect.h, border_col );
 
 		std::string_view display_text{ "none" };
-		std::string local_display_text;
+		zdraw::frame_string local_display_text{};
 
 		if ( auto* popup = dynamic_cast< multicombo_overlay* >( overlays.find( id ) ) )
 		{
@@ -3525,7 +3448,7 @@ namespace zui {
 				}
 			}
 
-			display_text = local_display_text.empty( ) ? std::string_view{ "none" } : std::string_view{ local_display_text };
+			display_text = local_display_text.empty( ) ? std::string_view{ "none" } : local_display_text.view( );
 		}
 
 		const auto arrow_size{ 6.0f };
@@ -3608,28 +3531,7 @@ namespace zui {
 		}
 		else if ( needs_scroll )
 		{
-			const auto [ellipsis_w, ellipsis_h] = zdraw::measure_text( "..." );
-
-			std::string truncated{};
-			auto truncated_w{ 0.0f };
-			const auto available_for_text = max_text_width - ellipsis_w;
-
-			for ( char c : display_text )
-			{
-				std::string test = truncated + c;
-				const auto [test_w, test_h] = zdraw::measure_text( test );
-
-				if ( test_w > available_for_text )
-				{
-					break;
-				}
-
-				truncated = test;
-				truncated_w = test_w;
-			}
-
-			truncated += "...";
-			zdraw::get_draw_list( ).add_text( text_x, text_y, truncated, style.text );
+			zdraw::get_draw_list( ).add_text( text_x, text_y, maybe_truncate_text( display_text, max_text_width ), style.text );
 		}
 		else
 		{
@@ -3657,7 +3559,7 @@ namespace zui {
 		return changed;
 	}
 
-	bool color_picker( std::string_view label, zdraw::rgba& color, float width, bool show_alpha )
+	bool color_picker( hashed_label label, zdraw::rgba& color, float width, bool show_alpha )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win )
@@ -3666,7 +3568,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto context_menu_id = id + 1;
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
@@ -3766,7 +3668,7 @@ namespace zui {
 			const auto text_y = abs.y + ( total_h - label_h ) * 0.5f;
 
 			const auto available_w = win->bounds.right( ) - text_x - style.window_padding_x;
-			const auto label_text = maybe_truncate_text( display_label, available_w, ctx( ).truncation_buffer( ) );
+			const auto label_text = maybe_truncate_text( display_label, available_w );
 
 			zdraw::get_draw_list( ).add_text( text_x, text_y, label_text, style.text );
 		}
@@ -3774,7 +3676,7 @@ namespace zui {
 		return changed;
 	}
 
-	bool text_input( std::string_view label, std::string& text, std::size_t max_length, std::string_view hint )
+	bool text_input( hashed_label label, std::string& text, std::size_t max_length, std::string_view hint )
 	{
 		const auto win = ctx( ).current_window( );
 		if ( !win )
@@ -3783,7 +3685,7 @@ namespace zui {
 		}
 
 		const auto id = ctx( ).generate_id( label );
-		const auto display_label = context::get_display_label( label );
+		const auto display_label = context::get_display_label( label.text );
 		const auto& style = ctx( ).get_style( );
 		const auto& input = ctx( ).input( );
 		auto& anims = ctx( ).anims( );
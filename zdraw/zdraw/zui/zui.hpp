@@ -35,9 +35,38 @@ namespace zui {
 	using widget_id = std::uintptr_t;
 	constexpr widget_id invalid_id{ 0 };
 
+	struct hashed_label
+	{
+		std::string_view text{};
+		widget_id hash{ invalid_id };
+
+		template<std::size_t N>
+		constexpr hashed_label( const char( &label )[ N ] ) noexcept : text{ label, std::char_traits<char>::length( label ) }, hash{ fnv1a( text ) } {}
+
+		template<typename T> requires ( std::is_convertible_v<const T&, std::string_view> && !std::is_array_v<T> )
+		hashed_label( const T& value ) noexcept : text{ value }, hash{ fnv1a( text ) } {}
+
+		[[nodiscard]] static constexpr widget_id fnv1a( std::string_view str ) noexcept
+		{
+			std::uint64_t h{ 14695981039346656037ull };
+
+			for ( const auto c : str )
+			{
+				h ^= static_cast< unsigned char >( c );
+				h *= 1099511628211ull;
+			}
+
+			return static_cast< widget_id >( h );
+		}
+	};
+
+	static_assert( hashed_label{ "abc" }.text.size( ) == 3u && hashed_label{ "abc" }.hash == hashed_label::fnv1a( "abc" ) );
+	static_assert( [ ] { constexpr char padded[ 16 ]{ "abc" }; return hashed_label{ padded }.text == "abc"; }( ) );
+	static_assert( [ ] { const char name[ 32 ]{ "abc" }; return hashed_label{ name }.hash; }( ) == hashed_label::fnv1a( "abc" ) );
+
 	struct window_state
 	{
-		std::string title{};
+		std::string_view title{};
 		rect bounds{};
 		float cursor_x{ 0.0f };
 		float cursor_y{ 0.0f };
@@ -250,13 +279,13 @@ namespace zui {
 	void push_style_color( style_color idx, const zdraw::rgba& col );
 	void pop_style_color( int count = 1 );
 
-	bool begin_window( std::string_view title, float& x, float& y, float& w, float& h, bool resizable = false, float min_w = 200.0f, float min_h = 200.0f );
+	bool begin_window( hashed_label title, float& x, float& y, float& w, float& h, bool resizable = false, float min_w = 200.0f, float min_h = 200.0f );
 	void end_window( );
 
-	bool begin_nested_window( std::string_view title, float w, float h );
+	bool begin_nested_window( hashed_label title, float w, float h );
 	void end_nested_window( );
 
-	bool begin_group_box( std::string_view title, float w, float h = 0.0f );
+	bool begin_group_box( hashed_label title, float w, float h = 0.0f );
 	void end_group_box( );
 
 	void same_line( float offset_x = 0.0f );
@@ -277,19 +306,19 @@ namespace zui {
 	void text_gradient_vertical( std::string_view label, const zdraw::rgba& color_top, const zdraw::rgba& color_bottom );
 	void text_gradient_four( std::string_view label, const zdraw::rgba& color_tl, const zdraw::rgba& color_tr, const zdraw::rgba& color_br, const zdraw::rgba& color_bl );
 
-	bool button( std::string_view label, float w, float h );
-	bool checkbox( std::string_view label, bool& v );
+	bool button( hashed_label label, float w, float h );
+	bool checkbox( hashed_label label, bool& v );
 
-	bool slider_float( std::string_view label, float& v, float v_min, float v_max, std::string_view format = "%.2f" );
-	bool slider_int( std::string_view label, int& v, int v_min, int v_max, std::string_view format = "%d" );
+	bool slider_float( hashed_label label, float& v, float v_min, float v_max, std::string_view format = "%.2f" );
+	bool slider_int( hashed_label label, int& v, int v_min, int v_max, std::string_view format = "%d" );
 
-	bool keybind( std::string_view label, int& key );
+	bool keybind( hashed_label label, int& key );
 
-	bool combo( std::string_view label, int& current_item, const char* const items[ ], int items_count, float width = 0.0f );
-	bool multicombo( std::string_view label, bool* selected_items, const char* const items[ ], int items_count, float width = 0.0f );
+	bool combo( hashed_label label, int& current_item, const char* const items[ ], int items_count, float width = 0.0f );
+	bool multicombo( hashed_label label, bool* selected_items, const char* const items[ ], int items_count, float width = 0.0f );
 
-	bool color_picker( std::string_view label, zdraw::rgba& color, float width = 0.0f, bool show_alpha = true );
+	bool color_picker( hashed_label label, zdraw::rgba& color, float width = 0.0f, bool show_alpha = true );
 
-	bool text_input( std::string_view label, std::string& text, std::size_t max_length = 256, std::string_view hint = "" );
+	bool text_input( hashed_label label, std::string& text, std::size_t max_length = 256, std::string_view hint = "" );
 
 } // namespace zui
\ No newline at end of file